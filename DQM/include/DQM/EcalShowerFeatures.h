@@ -26,17 +26,34 @@ class EcalShowerFeatures : public framework::Analyzer {
    */
   virtual void configure(framework::config::Parameters& ps);
 
+  /**
+   * Get handles to the histograms we fill
+   */
+  virtual void onProcessStart();
+
   /**
    * Fills histograms
    */
   virtual void analyze(const framework::Event& event);
 
+  /**
+   * Histograms are filled through handles, so we can
+   * run on several events at once.
+   */
+  virtual bool isThreadSafe() const { return true; }
+
  private:
   /// Collection Name for veto object
   std::string ecal_veto_name_;
 
   /// Pass Name for veto object
   std::string ecal_veto_pass_;
+
+  /// Handles to the histograms of the veto features, in order of filling
+  framework::HistogramHandle<TH1F> deepest_layer_hit_, num_readout_hits_,
+      summed_det_, summed_iso_, summed_back_, max_cell_dep_, shower_rms_,
+      x_std_, y_std_, avg_layer_hit_, std_layer_hit_, e_containment_energy_,
+      ph_containment_energy_, out_containment_energy_;
 };
 }  // namespace dqm
 
@@ -12,29 +12,46 @@ void EcalShowerFeatures::configure(framework::config::Parameters &ps) {
   return;
 }
 
+void EcalShowerFeatures::onProcessStart() {
+  deepest_layer_hit_ = histograms_.handle<TH1F>("deepest_layer_hit");
+  num_readout_hits_ = histograms_.handle<TH1F>("num_readout_hits");
+  summed_det_ = histograms_.handle<TH1F>("summed_det");
+  summed_iso_ = histograms_.handle<TH1F>("summed_iso");
+  summed_back_ = histograms_.handle<TH1F>("summed_back");
+  max_cell_dep_ = histograms_.handle<TH1F>("max_cell_dep");
+  shower_rms_ = histograms_.handle<TH1F>("shower_rms");
+  x_std_ = histograms_.handle<TH1F>("x_std");
+  y_std_ = histograms_.handle<TH1F>("y_std");
+  avg_layer_hit_ = histograms_.handle<TH1F>("avg_layer_hit");
+  std_layer_hit_ = histograms_.handle<TH1F>("std_layer_hit");
+  e_containment_energy_ = histograms_.handle<TH1F>("e_containment_energy");
+  ph_containment_energy_ = histograms_.handle<TH1F>("ph_containment_energy");
+  out_containment_energy_ = histograms_.handle<TH1F>("out_containment_energy");
+}
+
 void EcalShowerFeatures::analyze(const framework::Event &event) {
-  auto veto{
+  const auto &veto{
       event.getObject<ldmx::EcalVetoResult>(ecal_veto_name_, ecal_veto_pass_)};
 
-  histograms_.fill("deepest_layer_hit", veto.getDeepestLayerHit());
-  histograms_.fill("num_readout_hits", veto.getNReadoutHits());
-  histograms_.fill("summed_det", veto.getSummedDet());
-  histograms_.fill("summed_iso", veto.getSummedTightIso());
-  histograms_.fill("summed_back", veto.getEcalBackEnergy());
-  histograms_.fill("max_cell_dep", veto.getMaxCellDep());
-  histograms_.fill("shower_rms", veto.getShowerRMS());
-  histograms_.fill("x_std", veto.getXStd());
-  histograms_.fill("y_std", veto.getYStd());
-  histograms_.fill("avg_layer_hit", veto.getAvgLayerHit());
-  histograms_.fill("std_layer_hit", veto.getStdLayerHit());
+  deepest_layer_hit_.fill(veto.getDeepestLayerHit());
+  num_readout_hits_.fill(veto.getNReadoutHits());
+  summed_det_.fill(veto.getSummedDet());
+  summed_iso_.fill(veto.getSummedTightIso());
+  summed_back_.fill(veto.getEcalBackEnergy());
+  max_cell_dep_.fill(veto.getMaxCellDep());
+  shower_rms_.fill(veto.getShowerRMS());
+  x_std_.fill(veto.getXStd());
+  y_std_.fill(veto.getYStd());
+  avg_layer_hit_.fill(veto.getAvgLayerHit());
+  std_layer_hit_.fill(veto.getStdLayerHit());
   for (const auto &energy : veto.getElectronContainmentEnergy()) {
-    histograms_.fill("e_containment_energy", energy);
+    e_containment_energy_.fill(energy);
   }
   for (const auto &energy : veto.getPhotonContainmentEnergy()) {
-    histograms_.fill("ph_containment_energy", energy);
+    ph_containment_energy_.fill(energy);
   }
   for (const auto &energy : veto.getOutsideContainmentEnergy()) {
-    histograms_.fill("out_containment_energy", energy);
+    out_containment_energy_.fill(energy);
   }
 
   return;
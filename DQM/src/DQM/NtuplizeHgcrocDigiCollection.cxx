@@ -73,7 +73,7 @@ void NtuplizeHgcrocDigiCollection::analyze(const framework::Event& event) {
   // get the reconstruction parameters
   auto pedestal_table{
       getCondition<conditions::IntegerTableCondition>(pedestal_table_)};
-  auto detmap{getCondition<hcal::HcalDetectorMap>(
+  const auto& detmap{getCondition<hcal::HcalDetectorMap>(
       hcal::HcalDetectorMap::CONDITIONS_OBJECT_NAME)};
 
   ldmxsw_event_ = event.getEventNumber();
@@ -18,6 +18,7 @@
 #include <TVector3.h>
 
 #include "Framework/Event.h"
+#include "Framework/TruthIndex.h"
 #include "Tools/AnalysisUtils.h"
 
 namespace dqm {
@@ -33,11 +34,12 @@ std::vector<const ldmx::SimParticle *> PhotoNuclearDQM::findDaughters(
   std::vector<const ldmx::SimParticle *> pnDaughters;
   for (const auto &daughterTrackID : parent->getDaughters()) {
     // skip daughters that weren't saved
-    if (particleMap.count(daughterTrackID) == 0) {
+    auto it{particleMap.find(daughterTrackID)};
+    if (it == particleMap.end()) {
       continue;
     }
 
-    auto daughter{&(particleMap.at(daughterTrackID))};
+    auto daughter{&(it->second)};
 
     // Get the PDG ID
     auto pdgID{daughter->getPdgID()};
@@ -60,11 +62,11 @@ std::vector<const ldmx::SimParticle *> PhotoNuclearDQM::findDaughters(
   return pnDaughters;
 }
 void PhotoNuclearDQM::findRecoilProperties(const ldmx::SimParticle *recoil) {
-  histograms_.fill("recoil_vertex_x", recoil->getVertex()[0]);
-  histograms_.fill("recoil_vertex_y", recoil->getVertex()[1]);
-  histograms_.fill("recoil_vertex_z", recoil->getVertex()[2]);
-  histograms_.fill("recoil_vertex_x:recoil_vertex_y", recoil->getVertex()[0],
-                   recoil->getVertex()[1]);
+  histograms_.fill("recoil_vertex_x", recoil->getVertexX());
+  histograms_.fill("recoil_vertex_y", recoil->getVertexY());
+  histograms_.fill("recoil_vertex_z", recoil->getVertexZ());
+  histograms_.fill("recoil_vertex_x:recoil_vertex_y", recoil->getVertexX(),
+                   recoil->getVertexY());
 }
 void PhotoNuclearDQM::findParticleKinematics(
     const std::vector<const ldmx::SimParticle *> &pnDaughters) {
@@ -87,8 +89,7 @@ void PhotoNuclearDQM::findParticleKinematics(
     double ke{daughter->getEnergy() - daughter->getMass()};
     total_ke += ke;
 
-    std::vector<double> vec{daughter->getMomentum()};
-    TVector3 pvec(vec[0], vec[1], vec[2]);
+    TVector3 pvec(daughter->getPx(), daughter->getPy(), daughter->getPz());
 
     //  Calculate the polar angle
     auto theta{pvec.Theta() * (180 / 3.14159)};
@@ -254,13 +255,15 @@ void PhotoNuclearDQM::configure(framework::config::Parameters &parameters) {
 void PhotoNuclearDQM::analyze(const framework::Event &event) {
   // Get the particle map from the event.  If the particle map is empty,
   // don't process the event.
-  auto particleMap{event.getMap<int, ldmx::SimParticle>("SimParticles")};
+  const auto &particleMap{
+      event.getMap<int, ldmx::SimParticle>("SimParticles")};
   if (particleMap.size() == 0) {
     return;
   }
 
   // Get the recoil electron
-  auto [trackID, recoil] = Analysis::getRecoil(particleMap);
+  const auto &truth{event.getDerived<framework::TruthIndex>()};
+  const ldmx::SimParticle *recoil{truth.getRecoil()};
   findRecoilProperties(recoil);
 
   // Use the recoil electron to retrieve the gamma that underwent a
@@ -278,10 +281,10 @@ void PhotoNuclearDQM::analyze(const framework::Event &event) {
 
   histograms_.fill("pn_particle_mult", pnGamma->getDaughters().size());
   histograms_.fill("pn_gamma_energy", pnGamma->getEnergy());
-  histograms_.fill("pn_gamma_int_z", pnGamma->getEndPoint()[2]);
-  histograms_.fill("pn_gamma_vertex_x", pnGamma->getVertex()[0]);
-  histograms_.fill("pn_gamma_vertex_y", pnGamma->getVertex()[1]);
-  histograms_.fill("pn_gamma_vertex_z", pnGamma->getVertex()[2]);
+  histograms_.fill("pn_gamma_int_z", pnGamma->getEndPointZ());
+  histograms_.fill("pn_gamma_vertex_x", pnGamma->getVertexX());
+  histograms_.fill("pn_gamma_vertex_y", pnGamma->getVertexY());
+  histograms_.fill("pn_gamma_vertex_z", pnGamma->getVertexZ());
 
   // Classify the event
   auto eventType{classifyEvent(pnDaughters, 200)};
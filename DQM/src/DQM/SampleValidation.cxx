@@ -5,6 +5,7 @@
 #include <iostream>
 
 #include "Framework/NtupleManager.h"
+#include "Framework/TruthIndex.h"
 #include "SimCore/Event/SimParticle.h"
 #include "SimCore/Event/SimTrackerHit.h"
 
@@ -14,9 +15,11 @@ void SampleValidation::configure(framework::config::Parameters& ps) { return; }
 
 void SampleValidation::analyze(const framework::Event& event) {
   // Grab the SimParticle Map and Target Scoring Plane Hits
-  auto targetSPHits(
+  const auto& targetSPHits(
       event.getCollection<ldmx::SimTrackerHit>("TargetScoringPlaneHits"));
-  auto particle_map{event.getMap<int, ldmx::SimParticle>("SimParticles")};
+  const auto& particle_map{
+      event.getMap<int, ldmx::SimParticle>("SimParticles")};
+  const auto& truth{event.getDerived<framework::TruthIndex>()};
 
   std::vector<int> primary_daughters;
 
@@ -24,12 +27,12 @@ void SampleValidation::analyze(const framework::Event& event) {
 
   // Loop over all SimParticles
   for (auto const& it : particle_map) {
-    ldmx::SimParticle p = it.second;
+    const ldmx::SimParticle& p = it.second;
     int pdgid = p.getPdgID();
     std::vector<double> vertex = p.getVertex();
     double energy = p.getEnergy();
-    std::vector<int> parents_track_ids = p.getParents();
-    std::vector<int> daughters = p.getDaughters();
+    const std::vector<int>& parents_track_ids = p.getParents();
+    const std::vector<int>& daughters = p.getDaughters();
 
     for (auto const& parent_track_id : parents_track_ids) {
       if (parent_track_id == 0) {
@@ -37,8 +40,9 @@ void SampleValidation::analyze(const framework::Event& event) {
         histograms_.fill("energy_primaries", energy);
         hard_thresh = (2500. / 4000.) * energy;
         primary_daughters = daughters;
-        for (const ldmx::SimTrackerHit& sphit : targetSPHits) {
-          if (sphit.getTrackID() == it.first && sphit.getPosition()[2] < 0) {
+        for (int i_sphit : truth.getScoringPlaneHits(
+                 framework::TruthIndex::TARGET_SP_HITS, it.first)) {
+          if (targetSPHits[i_sphit].getZ() < 0) {
             histograms_.fill("beam_smear", vertex[0], vertex[1]);
           }
         }
@@ -50,7 +54,7 @@ void SampleValidation::analyze(const framework::Event& event) {
 
   for (auto const& it : particle_map) {
     int trackid = it.first;
-    ldmx::SimParticle p = it.second;
+    const ldmx::SimParticle& p = it.second;
     for (auto const& primary_daughter : primary_daughters) {
       if (trackid == primary_daughter) {
         histograms_.fill("pdgid_primarydaughters", pdgid_label(p.getPdgID()));
@@ -70,7 +74,7 @@ void SampleValidation::analyze(const framework::Event& event) {
 
   for (auto const& it : particle_map) {
     int trackid = it.first;
-    ldmx::SimParticle p = it.second;
+    const ldmx::SimParticle& p = it.second;
     for (const std::vector<int>& daughter_track_id : hardbrem_daughters) {
       for (const int& daughter_id : daughter_track_id) {
         if (trackid == daughter_id) {
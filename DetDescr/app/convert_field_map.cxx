@@ -0,0 +1,75 @@
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <iostream>
+#include <string>
+
+//-------------//
+//   ldmx-sw   //
+//-------------//
+#include "Framework/Exception/Exception.h"
+#include "DetDescr/FieldMapFile.h"
+
+/**
+ * @func printUsage
+ *
+ * Print how to use this executable to the terminal.
+ */
+void printUsage();
+
+/**
+ * @func convert-field-map main
+ * @param[in] argc int number of command line arguments
+ * @param[in] argv array of command line arguments
+ *
+ * Convert a text field map into the binary format read by
+ * ldmx::FieldMapFile and check the result.
+ */
+int main(int argc, char* argv[]) try {
+  if (argc < 2 or argc > 5) {
+    printUsage();
+    return 1;
+  }
+
+  std::string text{argv[1]};
+  // by default, put the copy where the loaders look for it
+  std::string binary{argc > 2 ? argv[2] : text + ".bin"};
+  double length_unit{argc > 3 ? std::stod(argv[3]) : 1.};
+  double field_unit{argc > 4 ? std::stod(argv[4]) : 1000.};
+
+  std::cout << "Converting " << text << " to " << binary << std::endl;
+  ldmx::FieldMapFile::convert(text, binary, length_unit, field_unit);
+
+  ldmx::FieldMapFile map(binary);
+  if (not map.checksumOK()) {
+    std::cerr << "[ convert-field-map ] : Checksum of " << binary
+              << " doesn't match the values written." << std::endl;
+    return 127;
+  }
+  std::cout << "  " << map.n(0) << " x " << map.n(1) << " x " << map.n(2)
+            << " grid points from (" << map.header().min_[0] << ", "
+            << map.header().min_[1] << ", " << map.header().min_[2]
+            << ") to (" << map.header().max_[0] << ", "
+            << map.header().max_[1] << ", " << map.header().max_[2] << ")"
+            << std::endl;
+  return 0;
+} catch (const framework::exception::Exception& e) {
+  std::cerr << "[ convert-field-map ] : " << e.name() << " : " << e.message()
+            << std::endl;
+  return 127;
+}
+
+void printUsage() {
+  std::cout << "Usage: convert-field-map {text map} [binary map] "
+               "[length unit in mm] [field unit in T]"
+            << std::endl;
+  std::cout << "  text map    Field map with lines 'x y z Bx By Bz'"
+            << std::endl;
+  std::cout << "  binary map  Output path, defaults to '{text map}.bin' "
+               "which is used in place of the text map when it is loaded"
+            << std::endl;
+  std::cout << "  length unit Unit of the coordinates, defaults to 1 mm"
+            << std::endl;
+  std::cout << "  field unit  Unit of the field, defaults to 1000 T"
+            << std::endl;
+}
@@ -22,7 +22,7 @@
 #include "Framework/Exception/Exception.h"
 
 // STL
-#include <map>
+#include <vector>
 
 // ROOT
 #include "TH2Poly.h"
@@ -82,6 +82,10 @@ namespace ldmx {
  * - Define a mapping of cell IDs within a module (center of module is the
  * origin)
  *   - Use TH2Poly to do the Hexagon tiling in p,q space
+ *   - Cells fully inside of the module are regular hexagons on a honeycomb
+ *     lattice, so a position is located by rounding it to the nearest
+ *     lattice point. Only cells clipped by the module edge are looked up
+ *     in the TH2Poly.
  * - Define center of modules with respect to center of layer in p,q space
  *   - currently this is assumed to be the same within all layers BUT will
  *     depend on geometry parameters like the gap between modules
@@ -97,11 +101,43 @@ namespace ldmx {
  * The cell radius is calculated from the total number of center-to-corner cell
  * radii that span the module height. This count can have fractional counts to
  * account for the fractions of cell radii at the module edges.
+ *
+ * ## STORAGE
+ * All of the positions and neighbor lists are stored in flat arrays. Within
+ * a layer, a cell is at index (module ID * number of cells per module +
+ * cell ID). Neighbor lists are stored back-to-back in one array with the
+ * offset of each cell's list in another.
  */
 class EcalGeometry : public framework::ConditionsObject {
  public:
   static constexpr const char* CONDITIONS_OBJECT_NAME{"EcalGeometry"};
 
+  /**
+   * View of a list of neighbor cells stored in the geometry
+   *
+   * The EcalID's in this list all have the layer ID set to zero.
+   */
+  class Neighbors {
+   public:
+    /// Wrap the range [begin, end)
+    Neighbors(const EcalID* begin, const EcalID* end)
+        : begin_{begin}, end_{end} {}
+    /// @return pointer to first neighbor
+    const EcalID* begin() const { return begin_; }
+    /// @return pointer past the last neighbor
+    const EcalID* end() const { return end_; }
+    /// @return number of neighbors
+    std::size_t size() const { return end_ - begin_; }
+    /// @return i'th neighbor
+    const EcalID& operator[](std::size_t i) const { return begin_[i]; }
+
+   private:
+    /// first neighbor
+    const EcalID* begin_;
+    /// past the last neighbor
+    const EcalID* end_;
+  };
+
   /**
    * Class destructor.
    *
@@ -184,7 +220,12 @@ class EcalGeometry : public framework::ConditionsObject {
    * auto [x,y,z] = geometry.getPosition(id);
    * ```
    */
-  std::tuple<double, double, double> getPosition(EcalID id) const;
+  std::tuple<double, double, double> getPosition(EcalID id) const {
+    std::size_t i{index(id)};
+    const auto& [layer_x, layer_y, layer_z] = layer_pos_xy_[id.layer()];
+    return std::make_tuple(cell_x_in_layer_[i] + layer_x,
+                           cell_y_in_layer_[i] + layer_y, layer_z);
+  }
 
   /**
    * Get a cell's position within a module
@@ -228,8 +269,18 @@ class EcalGeometry : public framework::ConditionsObject {
    * @note This assumes that all modules are the full high-density
    * hexagons from CMS (no triangles!)
    */
-  int getNumCellsPerModule() const {
-    return cell_id_in_module_.GetNumberOfBins();
+  int getNumCellsPerModule() const { return cell_pos_in_module_.size(); }
+
+  /**
+   * Get the Nearest Neighbors of the input ID without copying them
+   *
+   * @param id id to get
+   * @return view of the nearest neighbors with the layer ID set to zero
+   */
+  Neighbors getNNView(EcalID id) const {
+    std::size_t i{index(id)};
+    return Neighbors(NN_.data() + NN_offsets_[i],
+                     NN_.data() + NN_offsets_[i + 1]);
   }
 
   /**
@@ -239,9 +290,9 @@ class EcalGeometry : public framework::ConditionsObject {
    * @return list of EcalID that are the inputs nearest neighbors
    */
   std::vector<EcalID> getNN(EcalID id) const {
-    auto list = NNMap_.at(EcalID(0, id.module(), id.cell()));
-    for (auto& flat : list)
-      flat = EcalID(id.layer(), flat.module(), flat.cell());
+    std::vector<EcalID> list;
+    for (const auto& flat : getNNView(id))
+      list.emplace_back(id.layer(), flat.module(), flat.cell());
     return list;
   }
 
@@ -253,12 +304,27 @@ class EcalGeometry : public framework::ConditionsObject {
    * @return true if probe ID is a nearest neighbor of the centroid
    */
   bool isNN(EcalID centroid, EcalID probe) const {
-    for (auto& id : getNN(centroid)) {
-      if (id == probe) return true;
+    if (probe.layer() != centroid.layer()) return false;
+    EcalID flat_probe(0, probe.module(), probe.cell());
+    for (auto& id : getNNView(centroid)) {
+      if (id == flat_probe) return true;
     }
     return false;
   }
 
+  /**
+   * Get the Next-to-Nearest Neighbors of the input ID without copying them
+   *
+   * @param id id to get
+   * @return view of the next-to-nearest neighbors with the layer ID set to
+   * zero
+   */
+  Neighbors getNNNView(EcalID id) const {
+    std::size_t i{index(id)};
+    return Neighbors(NNN_.data() + NNN_offsets_[i],
+                     NNN_.data() + NNN_offsets_[i + 1]);
+  }
+
   /**
    * Get the Next-to-Nearest Neighbors of the input ID
    *
@@ -266,9 +332,9 @@ class EcalGeometry : public framework::ConditionsObject {
    * @return list of EcalID that are the inputs next-to-nearest neighbors
    */
   std::vector<EcalID> getNNN(EcalID id) const {
-    auto list = NNNMap_.at(EcalID(0, id.module(), id.cell()));
-    for (auto& flat : list)
-      flat = EcalID(id.layer(), flat.module(), flat.cell());
+    std::vector<EcalID> list;
+    for (const auto& flat : getNNNView(id))
+      list.emplace_back(id.layer(), flat.module(), flat.cell());
     return list;
   }
 
@@ -281,8 +347,10 @@ class EcalGeometry : public framework::ConditionsObject {
    * @return true if probe ID is a next-to-nearest neighbor of the centroid
    */
   bool isNNN(EcalID centroid, EcalID probe) const {
-    for (auto& id : getNNN(centroid)) {
-      if (id == probe) return true;
+    if (probe.layer() != centroid.layer()) return false;
+    EcalID flat_probe(0, probe.module(), probe.cell());
+    for (auto& id : getNNNView(centroid)) {
+      if (id == flat_probe) return true;
     }
     return false;
   }
@@ -325,8 +393,10 @@ class EcalGeometry : public framework::ConditionsObject {
    * @return pointer to member variable cell_id_in_module_
    */
   TH2Poly* getCellPolyMap() const {
-    for (auto const& [cell_id, cell_center] : cell_pos_in_module_) {
-      cell_id_in_module_.Fill(cell_center.first, cell_center.second, cell_id);
+    for (std::size_t cell_id{0}; cell_id < cell_pos_in_module_.size();
+         cell_id++) {
+      cell_id_in_module_.Fill(cell_pos_in_module_[cell_id].first,
+                              cell_pos_in_module_[cell_id].second, cell_id);
     }
     return &cell_id_in_module_;
   }
@@ -344,6 +414,39 @@ class EcalGeometry : public framework::ConditionsObject {
   EcalGeometry(const framework::config::Parameters& ps);
   friend class ecal::EcalGeometryProvider;
 
+  /**
+   * Index of a cell within its layer in the flat arrays
+   *
+   * @throws Exception if the ID is not a cell in this geometry
+   * @param[in] id cell ID
+   * @return module ID * number of cells per module + cell ID
+   */
+  std::size_t index(EcalID id) const {
+    if (std::size_t(id.layer()) >= layer_pos_xy_.size() or
+        std::size_t(id.module()) >= module_pos_xy_.size() or
+        std::size_t(id.cell()) >= cell_pos_in_module_.size()) {
+      EXCEPTION_RAISE("BadID", "EcalID with layer " +
+                                   std::to_string(id.layer()) + ", module " +
+                                   std::to_string(id.module()) + " and cell " +
+                                   std::to_string(id.cell()) +
+                                   " is not in the geometry.");
+    }
+    return id.module() * cell_pos_in_module_.size() + id.cell();
+  }
+
+  /**
+   * Find the cell containing a position relative to the module center
+   *
+   * The position is rounded to the nearest point of the honeycomb lattice.
+   * If the cell there was clipped by the module edge, or there isn't any,
+   * the TH2Poly is searched instead.
+   *
+   * @param[in] p position along p axis relative to module center [mm]
+   * @param[in] q position along q axis relative to module center [mm]
+   * @return cell ID, negative if the position is not in any cell
+   */
+  int findCell(double p, double q) const;
+
   /**
    * Constructs the positions of the layers in world coordinates
    */
@@ -399,6 +502,7 @@ class EcalGeometry : public framework::ConditionsObject {
    * mapping
    * @param[out] cellPostionMap_ map of local cell ID to cell center position
    * relative to module
+   * @param[out] cell_id_in_lattice_ cell IDs of unclipped cells on the lattice
    */
   void buildCellMap();
 
@@ -418,7 +522,7 @@ class EcalGeometry : public framework::ConditionsObject {
   void buildCellModuleMap();
 
   /**
-   * Construts NNMap and NNNMap
+   * Construts the nearest and next-to-nearest neighbor lists
    *
    * Since this only occurs once during processing, we can be wasteful.
    * We do a nested loop over the entire cellular position map and calculate
@@ -430,10 +534,8 @@ class EcalGeometry : public framework::ConditionsObject {
    *
    * @param[in] cellModulePostionMap_ map of cells to cell centers relative to
    * ecal
-   * @param[out] NNMap_ map of cell IDs to list of cell IDs that are its nearest
-   * neighbors
-   * @param[out] NNNMap_ map of cell IDs to list of cell IDs that are its
-   * next-to-nearest neighbors
+   * @param[out] NN_ lists of cell IDs that are nearest neighbors
+   * @param[out] NNN_ lists of cell IDs that are next-to-nearest neighbors
    */
   void buildNeighborMaps();
 
@@ -553,61 +655,85 @@ class EcalGeometry : public framework::ConditionsObject {
 
   /**
    * Position of layer centers in world coordinates
-   * (uses layer ID as key)
+   * (uses layer ID as index)
    */
-  std::map<int, std::tuple<double, double, double>> layer_pos_xy_;
+  std::vector<std::tuple<double, double, double>> layer_pos_xy_;
 
   /**
    * Postion of module centers relative to the center of the layer
    * in world coordinates
    *
-   * (uses module ID as key)
+   * (uses module ID as index)
    */
-  std::map<int, std::pair<double, double>> module_pos_xy_;
+  std::vector<std::pair<double, double>> module_pos_xy_;
 
   /**
    * Position of cell centers relative to center of module in
    * p,q space.
    *
-   * use cell ID as key
+   * uses cell ID as index
    */
-  std::map<int, std::pair<double, double>> cell_pos_in_module_;
+  std::vector<std::pair<double, double>> cell_pos_in_module_;
 
   /**
    * Position of cell centers relative to center of layer in world
    * coordinates.
    *
-   * @note Layer shifts are NOT included in this map since they depend
+   * Adding the center of a layer gives the cell position in world
+   * coordinates. This is where we convert p,q (flower) space into x,y
+   * (world) space by including rotations and shifts.
+   *
+   * @note Layer shifts are NOT included in these arrays since they depend
    * on the layer number!!
    *
-   * Uses EcalID with layer set to zero as key.
+   * Uses the index of the cell within a layer.
    */
-  std::map<EcalID, std::pair<double, double>> cell_pos_in_layer_;
+  std::vector<double> cell_x_in_layer_, cell_y_in_layer_;
 
   /**
-   * Position of cell centers relative to world geometry
+   * Nearest neighbors of all cells in a layer
    *
-   * This is where we convert p,q (flower) space into x,y (world) space
-   * by calculating the z-location as well as including rotations and
-   * shifts when converting from p,q to x,y.
+   * The neighbors of the cell at index i are NN_[NN_offsets_[i]] up to
+   * NN_[NN_offsets_[i+1]]. The EcalID's in this list all have layer ID set
+   * to zero.
+   */
+  std::vector<EcalID> NN_;
+
+  /// Start of the list of nearest neighbors for each cell in a layer
+  std::vector<std::size_t> NN_offsets_;
+
+  /**
+   * Next-to-nearest neighbors of all cells in a layer
    *
-   * The key is the full EcalID and the value is the x,y,z tuple.
+   * Stored the same way as NN_.
    */
-  std::map<EcalID, std::tuple<double, double, double>> cell_global_pos_;
+  std::vector<EcalID> NNN_;
+
+  /// Start of the list of next-to-nearest neighbors for each cell in a layer
+  std::vector<std::size_t> NNN_offsets_;
 
   /**
-   * Map of cell ID to neighboring cells
+   * Center of a cell used as origin of the honeycomb lattice in p,q space
    *
-   * The EcalID's in this map all have layer ID set to zero.
+   * The center of the cell in lattice column c and row r is at
+   * origin + c * (2 cellr, 0) + r * (cellr, 1.5 cellR)
    */
-  std::map<EcalID, std::vector<EcalID>> NNMap_;
+  std::pair<double, double> lattice_origin_;
+
+  /// Smallest lattice column and row of a cell
+  int lattice_min_col_{0}, lattice_min_row_{0};
+
+  /// Number of lattice columns and rows spanned by the cells
+  int lattice_num_cols_{0}, lattice_num_rows_{0};
 
   /**
-   * Map of cell ID to neighbors of neighbor cells
+   * Cell ID at each lattice point, index is
+   * (row - lattice_min_row_) * lattice_num_cols_ + (col - lattice_min_col_)
    *
-   * The EcalID's in this map all have layer ID set to zero.
+   * -1 for lattice points without a cell or with a cell clipped by the
+   * module edge, which need to be looked up in cell_id_in_module_.
    */
-  std::map<EcalID, std::vector<EcalID>> NNNMap_;
+  std::vector<int> cell_id_in_lattice_;
 
   /**
    * Honeycomb Binning from ROOT
@@ -0,0 +1,181 @@
+/**
+ * @file FieldMapFile.h
+ * @brief Memory-mapped binary format for magnetic field maps
+ */
+
+#ifndef DETDESCR_FIELDMAPFILE_H_
+#define DETDESCR_FIELDMAPFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ldmx {
+
+/**
+ * @class FieldMapFile
+ * @brief Binary copy of a magnetic field map, mapped into memory
+ *
+ * The text field maps are hundreds of MB of numbers which have to be
+ * parsed at the start of every job that uses them (both the simulation
+ * and the tracking). The convert-field-map executable writes the same
+ * grid into a compact binary file once, and this class maps such a file
+ * into memory so the values can be used without being parsed or copied.
+ * Since the file is mapped read-only, jobs on the same node share the
+ * same pages.
+ *
+ * The binary file is a Header followed by the field at each grid point.
+ * The points are ordered with the z index changing the fastest and the x
+ * index the slowest, and each point holds (Bx, By, Bz). The values are
+ * stored in the native byte order of the machine that wrote them, which
+ * is checked when the file is opened.
+ *
+ * Loaders given the path to a text field map use a binary copy named
+ * "<path>.bin" if it exists and is not older than the text file.
+ */
+class FieldMapFile {
+ public:
+  /**
+   * Header at the start of the binary file
+   */
+  struct Header {
+    /// identifies the file format, always MAGIC
+    char magic_[8];
+    /// version of the format
+    uint32_t version_;
+    /// written as 1 to check the byte order when reading
+    uint32_t byte_order_;
+    /// number of grid points along x, y, and z
+    uint64_t n_[3];
+    /// coordinates of the first grid point in the length unit
+    double min_[3];
+    /// coordinates of the last grid point in the length unit
+    double max_[3];
+    /// length unit of the coordinates in mm
+    double length_unit_;
+    /// unit of the field values in tesla
+    double field_unit_;
+    /// CRC32 checksum of the field values
+    uint32_t checksum_;
+    /// padding, kept zero
+    uint32_t reserved_;
+  };
+
+  /// the magic string at the start of the file
+  static constexpr char MAGIC[9] = "LDMXBMAP";
+
+  /// current version of the binary format
+  static constexpr uint32_t VERSION{1};
+
+  /**
+   * Map a binary field map file into memory
+   *
+   * Only the header and the size of the file are checked, use
+   * checksumOK to verify the field values.
+   *
+   * @throws Exception if the file can't be opened or mapped or if it
+   * isn't a binary field map of this version and byte order.
+   * @param[in] path path to the binary field map
+   */
+  explicit FieldMapFile(const std::string& path);
+
+  /// Unmap the file
+  ~FieldMapFile();
+
+  /// Hide copy constructor, the mapping is owned by one object
+  FieldMapFile(const FieldMapFile&) = delete;
+
+  /// Hide assignment operator
+  FieldMapFile& operator=(const FieldMapFile&) = delete;
+
+  /// @return the header of the file
+  const Header& header() const { return *header_; }
+
+  /**
+   * Get the number of grid points along an axis
+   * @param[in] axis 0 for x, 1 for y, 2 for z
+   * @return number of points along the axis
+   */
+  std::size_t n(int axis) const { return header_->n_[axis]; }
+
+  /**
+   * Get the index of the field values for a grid point
+   *
+   * The values for the point are at values()[index], values()[index+1]
+   * and values()[index+2] for Bx, By and Bz respectively.
+   *
+   * @param[in] ix index of grid point along x
+   * @param[in] iy index of grid point along y
+   * @param[in] iz index of grid point along z
+   * @return index of Bx of the grid point in values
+   */
+  std::size_t index(std::size_t ix, std::size_t iy, std::size_t iz) const {
+    return 3 * ((ix * n(1) + iy) * n(2) + iz);
+  }
+
+  /// @return pointer to the field values in the field unit
+  const double* values() const { return values_; }
+
+  /// @return total number of field values (three per grid point)
+  std::size_t size() const { return 3 * n(0) * n(1) * n(2); }
+
+  /**
+   * Compute the checksum of the field values and compare it to the
+   * one stored in the header.
+   *
+   * This reads through the whole file.
+   *
+   * @return true if the checksums match
+   */
+  bool checksumOK() const;
+
+  /**
+   * Check if the file at the input path is a binary field map
+   *
+   * @param[in] path path to file
+   * @return true if the file starts with MAGIC
+   */
+  static bool isBinary(const std::string& path);
+
+  /**
+   * Find the binary field map to use for the input field map
+   *
+   * @param[in] path path to a binary or a text field map
+   * @return path to the binary field map to use or an empty string
+   * if there isn't one (and the text field map should be read)
+   */
+  static std::string findBinary(const std::string& path);
+
+  /**
+   * Convert a text field map into a binary field map
+   *
+   * Each line of the text file with six numbers is read as a grid point
+   * "x y z Bx By Bz", all other lines are treated as header lines and
+   * skipped. The points can be in any order but have to fill a regular
+   * grid, which is stored with increasing coordinates.
+   *
+   * @throws Exception if the text file can't be read, the points don't
+   * fill a regular grid or the binary file can't be written.
+   * @param[in] text_path path to the text field map
+   * @param[in] binary_path path to write the binary field map to
+   * @param[in] length_unit length unit of the coordinates in mm
+   * @param[in] field_unit unit of the field values in tesla
+   */
+  static void convert(const std::string& text_path,
+                      const std::string& binary_path, double length_unit = 1.,
+                      double field_unit = 1000.);
+
+ private:
+  /// start of the mapped file
+  void* mapping_{nullptr};
+  /// size of the mapped file in bytes
+  std::size_t mapped_size_{0};
+  /// header at the start of the mapping
+  const Header* header_{nullptr};
+  /// field values following the header
+  const double* values_{nullptr};
+};  // FieldMapFile
+
+}  // namespace ldmx
+
+#endif  // DETDESCR_FIELDMAPFILE_H_
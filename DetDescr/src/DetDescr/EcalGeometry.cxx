@@ -2,6 +2,8 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 
@@ -94,8 +96,8 @@ EcalGeometry::EcalGeometry(const framework::config::Parameters& ps)
 EcalID EcalGeometry::getID(double x, double y, double z, bool fallible) const {
   static const double tolerance = 0.3;  // thickness of Si
   int layer_id{-1};
-  for (const auto& [lid, layer_xyz] : layer_pos_xy_) {
-    if (abs(std::get<2>(layer_xyz) - z) < tolerance) {
+  for (std::size_t lid{0}; lid < layer_pos_xy_.size(); lid++) {
+    if (abs(std::get<2>(layer_pos_xy_[lid]) - z) < tolerance) {
       layer_id = lid;
       break;
     }
@@ -125,8 +127,9 @@ EcalID EcalGeometry::getID(double x, double y, int layer_id,
   //    all and pick out the module ID that we are inside of
 
   int module_id{-1};
-  for (auto const& [mid, module_xy] : module_pos_xy_) {
-    double probe_x{p - module_xy.first}, probe_y{q - module_xy.second};
+  for (std::size_t mid{0}; mid < module_pos_xy_.size(); mid++) {
+    double probe_x{p - module_pos_xy_[mid].first},
+        probe_y{q - module_pos_xy_[mid].second};
     if (cornersSideUp_) rotate(probe_x, probe_y);
     if (isInside(probe_x / moduleR_, probe_y / moduleR_)) {
       module_id = mid;
@@ -165,7 +168,7 @@ EcalID EcalGeometry::getID(double x, double y, int layer_id, int module_id,
   if (cornersSideUp_) rotate(p, q);
 
   // deduce cell ID
-  int cell_id = cell_id_in_module_.FindBin(p, q) - 1;
+  int cell_id = findCell(p, q);
 
   if (cell_id < 0) {
     if (fallible) {
@@ -185,8 +188,33 @@ EcalID EcalGeometry::getID(double x, double y, int layer_id, int module_id,
   return EcalID(layer_id, module_id, cell_id);
 }
 
-std::tuple<double, double, double> EcalGeometry::getPosition(EcalID id) const {
-  return cell_global_pos_.at(id);
+int EcalGeometry::findCell(double p, double q) const {
+  // fractional lattice coordinates relative to the lattice origin
+  double row{(q - lattice_origin_.second) / (1.5 * cellR_)};
+  double col{(p - lattice_origin_.first) / (2. * cellr_) - row / 2.};
+
+  // round to the nearest lattice point using the third (redundant) hexagonal
+  // coordinate -col-row, the one with the largest rounding error is
+  // recalculated from the other two
+  double rcol{std::round(col)}, rrow{std::round(row)},
+      rthird{std::round(-col - row)};
+  double dcol{fabs(rcol - col)}, drow{fabs(rrow - row)},
+      dthird{fabs(rthird + col + row)};
+  if (dcol > drow and dcol > dthird)
+    rcol = -rrow - rthird;
+  else if (drow > dthird)
+    rrow = -rcol - rthird;
+
+  int i_col = int(rcol) - lattice_min_col_,
+      i_row = int(rrow) - lattice_min_row_;
+  if (i_col >= 0 and i_col < lattice_num_cols_ and i_row >= 0 and
+      i_row < lattice_num_rows_) {
+    int cell_id = cell_id_in_lattice_[i_row * lattice_num_cols_ + i_col];
+    if (cell_id >= 0) return cell_id;
+  }
+
+  // on or near the module edge
+  return cell_id_in_module_.FindBin(p, q) - 1;
 }
 
 std::pair<double, double> EcalGeometry::getPositionInModule(int cell_id) const {
@@ -230,7 +258,7 @@ void EcalGeometry::buildLayerMap() {
       std::cout << "    Layer " << i_layer << " has center at (" << x << ", "
                 << y << ", " << z << ") mm" << std::endl;
     }
-    layer_pos_xy_[i_layer] = std::make_tuple(x, y, z);
+    layer_pos_xy_.emplace_back(x, y, z);
   }
 }
 
@@ -245,7 +273,8 @@ void EcalGeometry::buildModuleMap() {
 
   // the center module (module_id == 0) has always been (and will always be?)
   //  centered with respect to the layer position
-  module_pos_xy_[0] = std::pair<double, double>(0., 0.);
+  module_pos_xy_.clear();
+  module_pos_xy_.emplace_back(0., 0.);
 
   // for flat-side-up designs (v12 and earlier), the modules are numbered 1 on
   // positive y-axis and then counter-clockwise until 6
@@ -261,7 +290,7 @@ void EcalGeometry::buildModuleMap() {
       x = (2. * moduler_ + gap_) * cos((id - 1) * (C_PI / 3.));
       y = -(2. * moduler_ + gap_) * sin((id - 1) * (C_PI / 3.));
     }
-    module_pos_xy_[id] = std::pair<double, double>(x, y);
+    module_pos_xy_.emplace_back(x, y);
     if (verbose_ > 2)
       std::cout << "    Module " << id << " is centered at (x,y) = "
                 << "(" << x << ", " << y << ") mm" << std::endl;
@@ -332,6 +361,8 @@ void EcalGeometry::buildCellMap() {
   TGraph* poly = 0;  // a polygon returned by TH2Poly is a TGraph
   // cells_in_module_ IDs go from 0 to N-1, not equal to original grid cell ID
   int cell_id = 0;
+  // whether a cell is a complete hexagon inside the module
+  std::vector<bool> unclipped;
   while ((polyBin = (TH2PolyBin*)next())) {
     // these bins are coming from the honeycomb
     //  grid so we assume that they are regular
@@ -484,10 +515,45 @@ void EcalGeometry::buildCellMap() {
                   << ")" << std::endl;
       }
       // save cell location as center of ENTIRE hexagon
-      cell_pos_in_module_[cell_id] = std::pair<double, double>(p, q);
+      cell_pos_in_module_.emplace_back(p, q);
+      unclipped.push_back(numVerticesInside == 6);
       ++cell_id;  // incrememnt cell ID
     }             // if num vertices inside is > 1
   }               // loop over larger grid spanning module hexagon
+
+  // put the unclipped cells on a lattice with the first cell at the origin
+  lattice_origin_ = cell_pos_in_module_.front();
+  std::vector<std::pair<int, int>> lattice_pos;
+  int max_col{0}, max_row{0};
+  lattice_min_col_ = 0;
+  lattice_min_row_ = 0;
+  bool on_lattice{true};
+  for (auto const& [p, q] : cell_pos_in_module_) {
+    int row = std::lround((q - lattice_origin_.second) / (1.5 * cellR_));
+    int col = std::lround((p - lattice_origin_.first) / (2. * cellr_) -
+                          row / 2.);
+    // make sure the honeycomb really is the lattice we expect
+    if (distance(std::make_pair(lattice_origin_.first +
+                                    (2. * col + row) * cellr_,
+                                lattice_origin_.second + 1.5 * row * cellR_),
+                 std::make_pair(p, q)) > 1e-6 * cellR_)
+      on_lattice = false;
+    lattice_pos.emplace_back(col, row);
+    lattice_min_col_ = std::min(lattice_min_col_, col);
+    lattice_min_row_ = std::min(lattice_min_row_, row);
+    max_col = std::max(max_col, col);
+    max_row = std::max(max_row, row);
+  }
+  lattice_num_cols_ = max_col - lattice_min_col_ + 1;
+  lattice_num_rows_ = max_row - lattice_min_row_ + 1;
+  cell_id_in_lattice_.assign(lattice_num_cols_ * lattice_num_rows_, -1);
+  for (std::size_t i{0}; i < lattice_pos.size(); i++) {
+    // without the lattice, all cells are looked up in the TH2Poly
+    if (not on_lattice or not unclipped[i]) continue;
+    auto const& [col, row] = lattice_pos[i];
+    cell_id_in_lattice_[(row - lattice_min_row_) * lattice_num_cols_ +
+                        (col - lattice_min_col_)] = i;
+  }
   return;
 }
 
@@ -496,9 +562,11 @@ void EcalGeometry::buildCellModuleMap() {
     std::cout
         << "[EcalGeometry::buildCellModuleMap] Building cellModule position map"
         << std::endl;
-  /// construct map of cell centers relative to layer center
-  for (auto const& [module_id, module_xy] : module_pos_xy_) {
-    for (auto const& [cell_id, cell_pq] : cell_pos_in_module_) {
+  /// construct arrays of cell centers relative to layer center
+  cell_x_in_layer_.clear();
+  cell_y_in_layer_.clear();
+  for (auto const& module_xy : module_pos_xy_) {
+    for (auto const& cell_pq : cell_pos_in_module_) {
       double cell_x{cell_pq.first}, cell_y{cell_pq.second};
       // convert from (p,q) to (x,y) space
       // when the corners are not up, x = p and y = q
@@ -506,29 +574,16 @@ void EcalGeometry::buildCellModuleMap() {
       if (cornersSideUp_) unrotate(cell_x, cell_y);
 
       // calculate cell's pq relative to entire layer center
-      auto cell_rel_to_layer =
-          std::make_pair(module_xy.first + cell_x, module_xy.second + cell_y);
-
-      // now add the layer-center values to get the global position
-      // of the cell
-      cell_pos_in_layer_[EcalID(0, module_id, cell_id)] = cell_rel_to_layer;
-    }
-  }
-
-  /// construct map of global cell centers relative to target center
-  for (auto const& [layer_id, layer_xyz] : layer_pos_xy_) {
-    for (auto const& [flat_id, rel_to_layer] : cell_pos_in_layer_) {
-      // now add the layer-center values to get the global position
-      // of the cell
-      cell_global_pos_[EcalID(layer_id, flat_id.module(), flat_id.cell())] =
-          std::make_tuple(rel_to_layer.first + std::get<0>(layer_xyz),
-                          rel_to_layer.second + std::get<1>(layer_xyz),
-                          std::get<2>(layer_xyz));
+      // the layer-center values are added in getPosition to get the global
+      // position of the cell
+      cell_x_in_layer_.push_back(module_xy.first + cell_x);
+      cell_y_in_layer_.push_back(module_xy.second + cell_y);
     }
   }
 
   if (verbose_ > 0)
-    std::cout << "  contained " << cell_global_pos_.size() << " entries. "
+    std::cout << "  contained "
+              << cell_x_in_layer_.size() * layer_pos_xy_.size() << " entries. "
               << std::endl;
   return;
 }
@@ -551,21 +606,33 @@ void EcalGeometry::buildNeighborMaps() {
     std::cout << "[EcalGeometry::buildNeighborMaps] : "
               << "Building Nearest and Next-Nearest Neighbor maps" << std::endl;
 
-  NNMap_.clear();
-  NNNMap_.clear();
-  for (auto const& [center_id, center_xyz] : cell_pos_in_layer_) {
-    for (auto const& [probe_id, probe_xyz] : cell_pos_in_layer_) {
+  const std::size_t num_cells{cell_pos_in_module_.size()};
+  NN_.clear();
+  NNN_.clear();
+  NN_offsets_.assign(1, 0);
+  NNN_offsets_.assign(1, 0);
+  for (std::size_t center{0}; center < cell_x_in_layer_.size(); center++) {
+    std::pair<double, double> center_xy{cell_x_in_layer_[center],
+                                        cell_y_in_layer_[center]};
+    for (std::size_t probe{0}; probe < cell_x_in_layer_.size(); probe++) {
       /// do distance calculation
-      double dist = distance(probe_xyz, center_xyz);
+      double dist = distance(
+          std::make_pair(cell_x_in_layer_[probe], cell_y_in_layer_[probe]),
+          center_xy);
+      EcalID probe_id(0, probe / num_cells, probe % num_cells);
       if (dist > 1 * cellr_ && dist <= 3. * cellr_) {
-        NNMap_[center_id].push_back(probe_id);
+        NN_.push_back(probe_id);
       } else if (dist > 3. * cellr_ && dist <= 4.5 * cellr_) {
-        NNNMap_[center_id].push_back(probe_id);
+        NNN_.push_back(probe_id);
       }
     }
+    NN_offsets_.push_back(NN_.size());
+    NNN_offsets_.push_back(NNN_.size());
     if (verbose_ > 1)
-      std::cout << "  Found " << NNMap_[center_id].size() << " NN and "
-                << NNNMap_[center_id].size() << " NNN for cell " << center_id
+      std::cout << "  Found " << NN_offsets_[center + 1] - NN_offsets_[center]
+                << " NN and " << NNN_offsets_[center + 1] - NNN_offsets_[center]
+                << " NNN for cell "
+                << EcalID(0, center / num_cells, center % num_cells)
                 << std::endl;
   }
   /*
@@ -580,14 +647,14 @@ void EcalGeometry::buildNeighborMaps() {
     std::cout << "The neighbors of the bin in the upper-right corner of the "
                  "center module, with cellModuleID "
               << specialCellModuleID << " include " << std::endl;
-    for (auto centerNN : NNMap_.at(specialCellModuleID)) {
+    for (auto centerNN : getNNView(specialCellModuleID)) {
       std::cout << " NN " << centerNN
                 << TString::Format(" (x,y) (%.2f, %.2f)",
                                    getCellCenterAbsolute(centerNN).first,
                                    getCellCenterAbsolute(centerNN).second)
                 << std::endl;
     }
-    for (auto centerNNN : NNNMap_.at(specialCellModuleID)) {
+    for (auto centerNNN : getNNNView(specialCellModuleID)) {
       std::cout << " NNN " << centerNNN
                 << TString::Format(" (x,y) (%.2f, %.2f)",
                                    getCellCenterAbsolute(centerNNN).first,
@@ -0,0 +1,222 @@
+#include "DetDescr/FieldMapFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/crc.hpp>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "Framework/Exception/Exception.h"
+
+namespace ldmx {
+
+static_assert(sizeof(FieldMapFile::Header) % sizeof(double) == 0,
+              "The field values following the header need to be aligned.");
+
+namespace {
+
+/**
+ * Compute the checksum of a block of field values
+ *
+ * @param[in] values pointer to first value
+ * @param[in] n number of values
+ * @return CRC32 checksum of the bytes of the values
+ */
+uint32_t checksum(const double* values, std::size_t n) {
+  boost::crc_32_type crc;
+  crc.process_bytes(values, n * sizeof(double));
+  return crc.checksum();
+}
+
+/**
+ * Get the sorted, unique coordinates along an axis
+ *
+ * @param[in] coords coordinates of all the points along the axis
+ * @return sorted list of the distinct coordinates
+ */
+std::vector<double> makeAxis(std::vector<double> coords) {
+  std::sort(coords.begin(), coords.end());
+  coords.erase(std::unique(coords.begin(), coords.end()), coords.end());
+  return coords;
+}
+
+/**
+ * Find the index of a coordinate on a regular axis
+ *
+ * @throws Exception if the coordinate is not on a grid point
+ * @param[in] axis sorted list of coordinates along the axis
+ * @param[in] coord coordinate to look for
+ * @return index of coordinate along axis
+ */
+std::size_t findIndex(const std::vector<double>& axis, double coord) {
+  if (axis.size() == 1) return 0;
+  double step{(axis.back() - axis.front()) / (axis.size() - 1)};
+  double findex{(coord - axis.front()) / step};
+  std::size_t index = std::lround(findex);
+  if (std::abs(findex - index) > 1e-3) {
+    EXCEPTION_RAISE("BadFieldMap", "The point at " + std::to_string(coord) +
+                                       " is not on a regular grid.");
+  }
+  return index;
+}
+
+}  // namespace
+
+constexpr char FieldMapFile::MAGIC[9];
+
+FieldMapFile::FieldMapFile(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    EXCEPTION_RAISE("FileDNE",
+                    "The field map file '" + path + "' could not be opened.");
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 or std::size_t(st.st_size) < sizeof(Header)) {
+    close(fd);
+    EXCEPTION_RAISE("BadFieldMap", "The field map file '" + path +
+                                       "' is too small to be a binary map.");
+  }
+
+  mapped_size_ = st.st_size;
+  mapping_ = mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after the file is closed
+  close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    EXCEPTION_RAISE("BadFieldMap",
+                    "Unable to map the field map file '" + path + "'.");
+  }
+
+  header_ = static_cast<const Header*>(mapping_);
+  values_ = reinterpret_cast<const double*>(header_ + 1);
+
+  std::string problem;
+  if (std::memcmp(header_->magic_, MAGIC, sizeof(header_->magic_)) != 0)
+    problem = "is not a binary field map";
+  else if (header_->version_ != VERSION)
+    problem = "has version " + std::to_string(header_->version_) +
+              " instead of " + std::to_string(VERSION);
+  else if (header_->byte_order_ != 1)
+    problem = "was written with a different byte order";
+  else if (mapped_size_ != sizeof(Header) + size() * sizeof(double))
+    problem = "doesn't have the size given by its header";
+
+  if (not problem.empty()) {
+    munmap(mapping_, mapped_size_);
+    mapping_ = nullptr;
+    EXCEPTION_RAISE("BadFieldMap", "The field map file '" + path + "' " +
+                                       problem + ".");
+  }
+
+  // we read the values in order when building the field
+  madvise(mapping_, mapped_size_, MADV_SEQUENTIAL);
+}
+
+FieldMapFile::~FieldMapFile() {
+  if (mapping_) munmap(mapping_, mapped_size_);
+}
+
+bool FieldMapFile::checksumOK() const {
+  return checksum(values_, size()) == header_->checksum_;
+}
+
+bool FieldMapFile::isBinary(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[sizeof(Header::magic_)];
+  if (not file.read(magic, sizeof(magic))) return false;
+  return std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+}
+
+std::string FieldMapFile::findBinary(const std::string& path) {
+  if (isBinary(path)) return path;
+
+  std::string copy{path + ".bin"};
+  struct stat text_st, copy_st;
+  if (stat(copy.c_str(), &copy_st) != 0 or not isBinary(copy)) return "";
+  // don't use a copy that was made before the text was changed
+  if (stat(path.c_str(), &text_st) == 0 and
+      copy_st.st_mtime < text_st.st_mtime)
+    return "";
+  return copy;
+}
+
+void FieldMapFile::convert(const std::string& text_path,
+                           const std::string& binary_path, double length_unit,
+                           double field_unit) {
+  std::ifstream text(text_path);
+  if (not text.good()) {
+    EXCEPTION_RAISE("FileDNE", "The field map file '" + text_path +
+                                   "' does not exist!");
+  }
+
+  // read all of the lines that look like grid points
+  std::array<std::vector<double>, 3> coords;
+  std::vector<std::array<double, 3>> fields;
+  std::string line;
+  while (std::getline(text, line)) {
+    std::istringstream ss(line);
+    double x, y, z, bx, by, bz;
+    if (not(ss >> x >> y >> z >> bx >> by >> bz)) continue;
+    coords[0].push_back(x);
+    coords[1].push_back(y);
+    coords[2].push_back(z);
+    fields.push_back({bx, by, bz});
+  }
+
+  Header header{};
+  std::memcpy(header.magic_, MAGIC, sizeof(header.magic_));
+  header.version_ = VERSION;
+  header.byte_order_ = 1;
+  header.length_unit_ = length_unit;
+  header.field_unit_ = field_unit;
+
+  std::array<std::vector<double>, 3> axes;
+  std::size_t n_points{1};
+  for (int axis{0}; axis < 3; axis++) {
+    axes[axis] = makeAxis(coords[axis]);
+    if (axes[axis].empty()) {
+      EXCEPTION_RAISE("BadFieldMap",
+                      "No grid points found in '" + text_path + "'.");
+    }
+    header.n_[axis] = axes[axis].size();
+    header.min_[axis] = axes[axis].front();
+    header.max_[axis] = axes[axis].back();
+    n_points *= axes[axis].size();
+  }
+
+  if (n_points != fields.size()) {
+    EXCEPTION_RAISE("BadFieldMap",
+                    "The " + std::to_string(fields.size()) + " points in '" +
+                        text_path + "' don't fill a regular grid.");
+  }
+
+  std::vector<double> values(3 * n_points);
+  for (std::size_t i{0}; i < fields.size(); i++) {
+    std::size_t ix{findIndex(axes[0], coords[0][i])},
+        iy{findIndex(axes[1], coords[1][i])},
+        iz{findIndex(axes[2], coords[2][i])};
+    std::size_t index{3 * ((ix * header.n_[1] + iy) * header.n_[2] + iz)};
+    std::copy(fields[i].begin(), fields[i].end(), values.begin() + index);
+  }
+  header.checksum_ = checksum(values.data(), values.size());
+
+  std::ofstream binary(binary_path, std::ios::binary | std::ios::trunc);
+  binary.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  binary.write(reinterpret_cast<const char*>(values.data()),
+               values.size() * sizeof(double));
+  if (not binary.good()) {
+    EXCEPTION_RAISE("BadFieldMap", "Unable to write the binary field map '" +
+                                       binary_path + "'.");
+  }
+}
+
+}  // namespace ldmx
@@ -0,0 +1,72 @@
+/**
+ * @file FieldMapFileTest.cxx
+ * @brief Test the conversion and reading of binary field maps
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>  //for remove
+#include <fstream>
+
+#include "DetDescr/FieldMapFile.h"
+
+/**
+ * Field value written for the grid point at the input coordinates
+ */
+static double fieldAt(int x, int y, int z, int component) {
+  return 100 * x + 10 * y + z + 0.25 * component;
+}
+
+/**
+ * Test for converting a text field map and reading it back
+ *
+ * The text map is written with the x coordinates decreasing
+ * so the conversion has to re-order the points.
+ */
+TEST_CASE("FieldMapFile", "[DetDescr][functionality]") {
+  using namespace ldmx;
+
+  const std::string text_map{"test_field_map.dat"},
+      binary_map{"test_field_map.dat.bin"};
+  {
+    std::ofstream text(text_map);
+    text << "\n 2 3 4\n 1 X [MM]\n 2 Y [MM]\n 3 Z [MM]\n"
+         << " 4 BX\n 5 BY\n 6 BZ\n 0 [OUTPUT]\n";
+    for (int x{1}; x >= 0; x--)
+      for (int y{0}; y < 3; y++)
+        for (int z{0}; z < 4; z++)
+          text << 5 * x << " " << -2 + 2 * y << " " << 10 + z << " "
+               << fieldAt(x, y, z, 0) << " " << fieldAt(x, y, z, 1) << " "
+               << fieldAt(x, y, z, 2) << "\n";
+  }
+
+  CHECK_FALSE(FieldMapFile::isBinary(text_map));
+  CHECK(FieldMapFile::findBinary(text_map).empty());
+
+  FieldMapFile::convert(text_map, binary_map);
+
+  CHECK(FieldMapFile::isBinary(binary_map));
+  CHECK(FieldMapFile::findBinary(text_map) == binary_map);
+  CHECK(FieldMapFile::findBinary(binary_map) == binary_map);
+
+  {
+    FieldMapFile map(binary_map);
+    CHECK(map.checksumOK());
+    CHECK(map.n(0) == 2);
+    CHECK(map.n(1) == 3);
+    CHECK(map.n(2) == 4);
+    CHECK(map.header().min_[0] == 0.);
+    CHECK(map.header().max_[0] == 5.);
+    CHECK(map.header().min_[1] == -2.);
+    CHECK(map.header().max_[2] == 13.);
+    CHECK(map.header().field_unit_ == 1000.);
+    for (int x{0}; x < 2; x++)
+      for (int y{0}; y < 3; y++)
+        for (int z{0}; z < 4; z++)
+          for (int c{0}; c < 3; c++)
+            CHECK(map.values()[map.index(x, y, z) + c] == fieldAt(x, y, z, c));
+  }
+
+  CHECK_THROWS(FieldMapFile(text_map));
+
+  remove(text_map.c_str());
+  remove(binary_map.c_str());
+}
@@ -56,10 +56,8 @@ class DNNEcalVetoProcessor : public framework::Producer {
   constexpr static unsigned int feature_energy_offset_ = 4 * max_num_hits_;
 
   const static std::vector<std::string> input_names_;
-  const static std::vector<unsigned int> input_sizes_;
 
   float disc_cut_ = -99;
-  std::vector<std::vector<float>> data_;
   std::unique_ptr<ldmx::Ort::ONNXRuntime> rt_;
 
   /** Name of the collection which will containt the results. */
@@ -53,14 +53,10 @@ class EcalDetectorMap
 
   /**
    * Default constructor which builds the necessary maps.
-   *
-   * @param[in] want_d2e true if we want to build a reverse mapping
-   * Building a reverse (detector->electronics) map takes extra time
-   * and memory so it should be off by default.
    */
   EcalDetectorMap(const std::string& cell_map,
                   const std::string& motherboard_map,
-                  const std::string& layer_map, bool want_d2e);
+                  const std::string& layer_map);
 
   /// Provider which loads the map
   friend class EcalDetectorMapLoader;
@@ -18,8 +18,13 @@
 //   LDMX   //
 //----------//
 #include "DetDescr/DetectorID.h"
+#include "DetDescr/EcalGeometry.h"
 #include "DetDescr/EcalID.h"
+#include "Ecal/EcalReconConditions.h"
+#include "Framework/ConditionHandle.h"
 #include "Framework/EventProcessor.h"
+#include "Framework/ProductHandle.h"
+#include "Recon/Event/HgcrocDigiCollection.h"
 
 namespace ecal {
 
@@ -57,12 +62,23 @@ class EcalRecProducer : public framework::Producer {
    */
   virtual void produce(framework::Event& event);
 
+  /**
+   * The reconstruction only reads conditions and the event,
+   * so we can run on several events at once.
+   */
+  virtual bool isThreadSafe() const { return true; }
+
  private:
-  /** Digi Collection Name to use as input */
-  std::string digiCollName_;
+  /** Digi Collection to use as input */
+  framework::ProductHandle<ldmx::HgcrocDigiCollection> digis_;
+
+  /// geometry of the ecal
+  framework::ConditionHandle<ldmx::EcalGeometry> geometry_{
+      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME};
 
-  /** Digi Pass Name to use as input */
-  std::string digiPassName_;
+  /// table of reconstruction parameters, see EcalReconConditions
+  framework::ConditionHandle<conditions::DoubleTableCondition>
+      reconConditions_{EcalReconConditions::CONDITIONS_NAME};
 
   /// simhit collection name
   std::string simHitCollName_;
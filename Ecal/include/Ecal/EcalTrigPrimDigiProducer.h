@@ -10,6 +10,9 @@
 //----------------//
 //   LDMX Core    //
 //----------------//
+#include "Conditions/SimpleTableCondition.h"
+#include "Ecal/EcalTriggerGeometry.h"
+#include "Framework/ConditionHandle.h"
 #include "Framework/EventProcessor.h"
 
 namespace ecal {
@@ -53,7 +56,11 @@ class EcalTrigPrimDigiProducer : public framework::Producer {
   std::string digiPassName_;
 
   /** Conditions object for the calibration information */
-  std::string condObjName_;
+  framework::ConditionHandle<conditions::IntegerTableCondition> conditions_;
+
+  /** Geometry of the trigger cells */
+  framework::ConditionHandle<EcalTriggerGeometry> geometry_{
+      EcalTriggerGeometry::CONDITIONS_OBJECT_NAME};
 };
 }  // namespace ecal
 
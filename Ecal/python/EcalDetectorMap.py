@@ -15,6 +15,18 @@ class EcalDetectorMap(ldmxcfg.ConditionsObjectProvider) :
     We can't have multiple different detector maps during a single
     run, so this class is meant to be a singleton.
 
+    Parameters
+    ----------
+    cell_map : str
+        Path to table of cells of a module
+    motherboard_map : str
+        Path to table of modules on the motherboards
+    layer_map : str
+        Path to table of layers on the optical links
+    want_d2e : bool
+        Deprecated and ignored, the detector ID to electronics ID lookup
+        is always built
+
     Attributes
     ----------
     __instance : EcalDetectorMap
@@ -42,5 +54,4 @@ class EcalDetectorMap(ldmxcfg.ConditionsObjectProvider) :
             self.cell_map = cell_map
             self.motherboard_map = motherboard_map
             self.layer_map = layer_map
-            self.want_d2e = want_d2e
 
@@ -19,6 +19,7 @@ class EcalVetoProcessor(ldmxcfg.Producer) :
         self.verbose = False
         self.feature_list_name = "input"
         self.bdt_file = makeBDTPath( "segmip" )
+        self.intra_op_threads = 1
         self.roc_file = makeRoCPath( 'RoC_v14_8gev' )
         self.beam_energy = 8000.0  # in MeV
         self.disc_cut = 0.99741
@@ -40,6 +41,7 @@ class DNNEcalVetoProcessor(ldmxcfg.Producer) :
         self.debug = False
         from LDMX.Ecal.makePath import makeBDTPath
         self.model_path = makeBDTPath("particle-net_ecal_v9")
+        self.intra_op_threads = 1
         self.disc_cut = -1.
         self.collection_name = "EcalVetoDNN"
 
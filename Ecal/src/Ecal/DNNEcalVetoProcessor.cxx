@@ -9,22 +9,30 @@ namespace ecal {
 
 const std::vector<std::string> DNNEcalVetoProcessor::input_names_{"coordinates",
                                                                   "features"};
-const std::vector<unsigned int> DNNEcalVetoProcessor::input_sizes_{
-    n_coordinate_dim_ * max_num_hits_, n_feature_dim_* max_num_hits_};
 
 DNNEcalVetoProcessor::DNNEcalVetoProcessor(const std::string& name,
                                            framework::Process& process)
-    : Producer(name, process) {
-  for (const auto& s : input_sizes_) {
-    data_.emplace_back(s, 0);
-  }
-}
+    : Producer(name, process) {}
 
 void DNNEcalVetoProcessor::configure(
     framework::config::Parameters& parameters) {
   disc_cut_ = parameters.getParameter<double>("disc_cut");
+  auto model_path{parameters.getParameter<std::string>("model_path")};
   rt_ = std::make_unique<ldmx::Ort::ONNXRuntime>(
-      parameters.getParameter<std::string>("model_path"));
+      model_path, nullptr, parameters.getParameter<int>("intra_op_threads", 1));
+  // the hits are written straight into the inputs of the model
+  rt_->bind(input_names_, rt_->getOutputNames());
+  const std::vector<std::size_t> input_sizes{n_coordinate_dim_ * max_num_hits_,
+                                             n_feature_dim_ * max_num_hits_};
+  for (std::size_t i{0}; i < input_sizes.size(); i++) {
+    if (rt_->getInput(i).size() != input_sizes[i]) {
+      EXCEPTION_RAISE("DNNInputs",
+                      "The model '" + model_path + "' expects " +
+                          std::to_string(rt_->getInput(i).size()) + " " +
+                          input_names_[i] + " but " +
+                          std::to_string(input_sizes[i]) + " are made.");
+    }
+  }
 
   // debug mode
   debug_ = parameters.getParameter<bool>("debug");
@@ -50,8 +58,8 @@ void DNNEcalVetoProcessor::produce(framework::Event& event) {
     // make inputs
     make_inputs(ecal_geometry, ecalRecHits);
     // run the DNN
-    auto outputs = rt_->run(input_names_, data_)[0];
-    result.setDiscValue(outputs.at(1));
+    rt_->run();
+    result.setDiscValue(rt_->getOutput(0)[1]);
   } else {
     result.setDiscValue(-99);
   }
@@ -75,10 +83,10 @@ void DNNEcalVetoProcessor::produce(framework::Event& event) {
 void DNNEcalVetoProcessor::make_inputs(
     const ldmx::EcalGeometry& geom,
     const std::vector<ldmx::EcalHit>& ecalRecHits) {
+  std::span<float> coordinates{rt_->getInput(0)}, features{rt_->getInput(1)};
   // clear data
-  for (auto& v : data_) {
-    std::fill(v.begin(), v.end(), 0);
-  }
+  std::fill(coordinates.begin(), coordinates.end(), 0);
+  std::fill(features.begin(), features.end(), 0);
 
   unsigned idx = 0;
   for (const auto& hit : ecalRecHits) {
@@ -86,15 +94,15 @@ void DNNEcalVetoProcessor::make_inputs(
     ldmx::EcalID id(hit.getID());
     auto [x, y, z] = geom.getPosition(id);
 
-    data_[0].at(coordinate_x_offset_ + idx) = x;
-    data_[0].at(coordinate_y_offset_ + idx) = y;
-    data_[0].at(coordinate_z_offset_ + idx) = z;
+    coordinates[coordinate_x_offset_ + idx] = x;
+    coordinates[coordinate_y_offset_ + idx] = y;
+    coordinates[coordinate_z_offset_ + idx] = z;
 
-    data_[1].at(feature_x_offset_ + idx) = x;
-    data_[1].at(feature_y_offset_ + idx) = y;
-    data_[1].at(feature_z_offset_ + idx) = z;
-    data_[1].at(feature_layerid_offset_ + idx) = id.layer();
-    data_[1].at(feature_energy_offset_ + idx) = std::log(hit.getEnergy());
+    features[feature_x_offset_ + idx] = x;
+    features[feature_y_offset_ + idx] = y;
+    features[feature_z_offset_ + idx] = z;
+    features[feature_layerid_offset_ + idx] = id.layer();
+    features[feature_energy_offset_ + idx] = std::log(hit.getEnergy());
 
     ++idx;
   }
@@ -102,8 +110,9 @@ void DNNEcalVetoProcessor::make_inputs(
   if (debug_) {
     for (unsigned iname = 0; iname < input_names_.size(); ++iname) {
       std::cout << "=== " << input_names_[iname] << " ===" << std::endl;
-      for (unsigned i = 0; i < input_sizes_[iname]; ++i) {
-        std::cout << data_[iname].at(i) << ", ";
+      std::span<const float> values{rt_->getInput(iname)};
+      for (unsigned i = 0; i < values.size(); ++i) {
+        std::cout << values[i] << ", ";
         if ((i + 1) % max_num_hits_ == 0) {
           std::cout << std::endl;
         }
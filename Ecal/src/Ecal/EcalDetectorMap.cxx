@@ -15,7 +15,6 @@ class EcalDetectorMapLoader : public framework::ConditionsObjectProvider {
       : ConditionsObjectProvider(EcalDetectorMap::CONDITIONS_OBJECT_NAME,
                                  tagname, parameters, process),
         the_map_{nullptr} {
-    want_d2e_ = parameters.getParameter<bool>("want_d2e");
     cell_map_ = parameters.getParameter<std::string>("cell_map");
     motherboard_map_ = parameters.getParameter<std::string>("motherboard_map");
     layer_map_ = parameters.getParameter<std::string>("layer_map");
@@ -25,8 +24,7 @@ class EcalDetectorMapLoader : public framework::ConditionsObjectProvider {
                     framework::ConditionsIOV>
   getCondition(const ldmx::EventHeader& context) {
     if (!the_map_) {
-      the_map_ = new EcalDetectorMap(cell_map_, motherboard_map_, layer_map_,
-                                     want_d2e_);
+      the_map_ = new EcalDetectorMap(cell_map_, motherboard_map_, layer_map_);
     }
 
     return std::make_pair(
@@ -45,14 +43,13 @@ class EcalDetectorMapLoader : public framework::ConditionsObjectProvider {
   std::string cell_map_;
   std::string motherboard_map_;
   std::string layer_map_;
-  bool want_d2e_;
 };
 
 EcalDetectorMap::EcalDetectorMap(const std::string& cell_map,
                                  const std::string& motherboard_map,
-                                 const std::string& layer_map, bool want_d2e)
+                                 const std::string& layer_map)
     : framework::ConditionsObject(CONDITIONS_OBJECT_NAME),
-      ldmx::ElectronicsMap<ldmx::EcalElectronicsID, ldmx::EcalID>(want_d2e) {
+      ldmx::ElectronicsMap<ldmx::EcalElectronicsID, ldmx::EcalID>() {
   conditions::StreamCSVLoader scell(cell_map);
   this->loadCellMap(scell);
   conditions::StreamCSVLoader smb(motherboard_map);
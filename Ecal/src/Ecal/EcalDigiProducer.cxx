@@ -110,6 +110,10 @@ void EcalDigiProducer::produce(framework::Event& event) {
   std::endl;
    */
 
+  // pulses arriving at each hit channel, digitized all at once below
+  std::vector<std::pair<int, std::vector<std::pair<double, double>>>>
+      channel_pulses;
+  channel_pulses.reserve(ecalSimHits.size());
   for (auto const& simHit : ecalSimHits) {
     std::vector<std::pair<double, double>> pulses_at_chip;
     for (int iContrib = 0; iContrib < simHit.getNumberOfContribs();
@@ -141,14 +145,17 @@ void EcalDigiProducer::produce(framework::Event& event) {
         << simHit.getTime() - simHit.getPosition().at(2)/299.702547
         << std::endl;
      */
-    // container emulator uses to write out samples and
-    // transfer samples into the digi collection
-    std::vector<ldmx::HgcrocDigiCollection::Sample> digiToAdd;
-    if (hgcroc_->digitize(hitID, pulses_at_chip, digiToAdd)) {
-      ecalDigis.addDigi(hitID, digiToAdd);
-    }
+    channel_pulses.emplace_back(hitID, std::move(pulses_at_chip));
   }
 
+  // container emulator uses to write out samples and
+  // transfer samples into the digi collection
+  std::vector<std::pair<int, std::vector<ldmx::HgcrocDigiCollection::Sample>>>
+      digisToAdd;
+  hgcroc_->digitize(channel_pulses, digisToAdd);
+  for (auto const& [hitID, digiToAdd] : digisToAdd)
+    ecalDigis.addDigi(hitID, digiToAdd);
+
   /******************************************************************************************
    * Noise Simulation on Empty Channels
    *****************************************************************************************/
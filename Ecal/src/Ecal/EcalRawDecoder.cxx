@@ -3,6 +3,7 @@
 #include <bitset>
 #include <iomanip>
 #include <optional>
+#include <span>
 
 #include "DetDescr/EcalElectronicsID.h"
 #include "DetDescr/EcalID.h"
@@ -35,7 +36,8 @@ void EcalRawDecoder::produce(framework::Event& event) {
   /// words for reading and decoding
   static uint32_t head1, head2, w;
 
-  BufferReader reader{event.getCollection<uint8_t>(input_name_, input_pass_)};
+  const auto& buffer{event.getCollection<uint8_t>(input_name_, input_pass_)};
+  BufferReader reader{buffer};
 
   /** Re-sort the data from grouped by bunch to by channel
    *
@@ -98,9 +100,10 @@ void EcalRawDecoder::produce(framework::Event& event) {
      *  RID ok (1) | CRC ok (1) | LEN0 (6)
      * ... other listing of links ...
      */
-    packing::utility::CRC fpga_crc;
-    fpga_crc << head1;
-    std::cout << hex(head1) << " : ";
+    // the FPGA checksum covers all of the words up to its own, so it is
+    // computed in one go once we get there
+    std::size_t fpga_begin{reader.tell() - 2 * sizeof(uint32_t)};
+    // std::cout << hex(head1) << " : ";
     uint32_t version = (head1 >> 28) & packing::utility::mask<4>;
     // std::cout << "version " << version << std::flush;
     uint32_t one{1};
@@ -115,7 +118,6 @@ void EcalRawDecoder::produce(framework::Event& event) {
 
     // std::cout << ", fpga: " << fpga << ", nlinks: " << nlinks << ", len: " <<
     // len << std::endl;
-    fpga_crc << head2;
     // std::cout << hex(head2) << " : ";
 
     // bunch ID (bx), read request (rreq) and orbit counter (orbit) are defined
@@ -131,7 +133,6 @@ void EcalRawDecoder::produce(framework::Event& event) {
     for (uint32_t i_link{0}; i_link < nlinks; i_link++) {
       if (i_link % 4 == 0) {
         reader >> w;
-        fpga_crc << w;
         // std::cout << hex(w) << " : Four Link Pack " << std::endl;
       }
       uint32_t shift_in_word = 8 * (i_link % 4);
@@ -160,7 +161,6 @@ void EcalRawDecoder::produce(framework::Event& event) {
       // std::cout << "RO Link " << i_link << std::endl;
       packing::utility::CRC link_crc;
       reader >> w;
-      fpga_crc << w;
       link_crc << w;
       uint32_t roc_id = (w >> 16) & packing::utility::mask<16>;
       // checksum for this chunk of data can be used to confirm data validity
@@ -173,7 +173,6 @@ void EcalRawDecoder::produce(framework::Event& event) {
       std::bitset<40> ro_map = w & packing::utility::mask<8>;
       ro_map <<= 32;
       reader >> w;
-      fpga_crc << w;
       link_crc << w;
       ro_map |= w;
 
@@ -191,7 +190,6 @@ void EcalRawDecoder::produce(framework::Event& event) {
 
         // next word is this channel
         reader >> w;
-        fpga_crc << w;
         // std::cout << hex(w) << " " << channel_id;
 
         if (channel_id == 0) {
@@ -274,6 +272,9 @@ void EcalRawDecoder::produce(framework::Event& event) {
     }  // loop over links
 
     // another CRC checksum from FPGA
+    packing::utility::CRC fpga_crc;
+    fpga_crc.update(std::span<const uint8_t>(buffer).subspan(
+        fpga_begin, reader.tell() - fpga_begin));
     reader >> w;
     // this word would be the CRC checksum as deteremined by the chip
     // uint32_t crc = w;
@@ -304,7 +305,7 @@ void EcalRawDecoder::produce(framework::Event& event) {
      * unpacking of individual samples; however, we still need
      * to translate electronic IDs into detector IDs.
      */
-    auto detmap{
+    const auto& detmap{
         getCondition<EcalDetectorMap>(EcalDetectorMap::CONDITIONS_OBJECT_NAME)};
     for (auto const& [eid, digi] : eid_to_samples) {
       // The electronics map returns an empty ID of the correct
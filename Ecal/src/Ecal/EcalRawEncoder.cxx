@@ -1,6 +1,8 @@
 #include "Ecal/EcalRawEncoder.h"
 
+#include <algorithm>
 #include <bitset>
+#include <span>
 
 #include "DetDescr/EcalElectronicsID.h"
 #include "DetDescr/EcalID.h"
@@ -31,15 +33,8 @@ void EcalRawEncoder::produce(framework::Event& event) {
    */
   // static const unsigned int common_mode_channel = roc_version_ == 2 ? 19 : 1;
 
-  auto digis{
+  const auto& digis{
       event.getObject<ldmx::HgcrocDigiCollection>(input_name_, input_pass_)};
-  std::vector<std::map<
-      uint16_t, std::map<uint16_t, std::map<uint32_t, uint32_t>  // channel to
-                                                                 // sample
-                         >                                       // links
-      >                                                          // fpgas
-              >                                                  // bunches
-      sorted_samples(digis.getNumSamplesPerDigi());
 
   /**
    * Translation
@@ -48,18 +43,49 @@ void EcalRawEncoder::produce(framework::Event& event) {
    * unpacking of individual samples; however, we still need
    * to translate detector IDs into electronics ID and resort
    * the data into grouped by bunch.
+   *
+   * The packed electronics index orders the channels by fpga, link
+   * and then channel, so once the digis are sorted by it, the digis of
+   * each link are next to each other in the order they are encoded in.
+   * This grouping is the same for all of the bunches.
    */
-  auto detmap{
+  const auto& detmap{
       getCondition<EcalDetectorMap>(EcalDetectorMap::CONDITIONS_OBJECT_NAME)};
-  for (auto digi : digis) {
-    ldmx::EcalID detid{digi.id()};
-    ldmx::EcalElectronicsID eid{detmap.get(detid)};
+  // electronics index and index in the collection of each digi
+  std::vector<std::pair<unsigned int, unsigned int>> channels;
+  channels.reserve(digis.getNumDigis());
+  for (unsigned int i_digi{0}; i_digi < digis.getNumDigis(); i_digi++) {
+    ldmx::EcalID detid{digis.getDigi(i_digi).id()};
+    channels.emplace_back(detmap.get(detid).index(), i_digi);
+  }
+  std::sort(channels.begin(), channels.end());
+  // a channel with more than one digi keeps the last one
+  auto last{std::unique(
+      channels.rbegin(), channels.rend(),
+      [](const auto& a, const auto& b) { return a.first == b.first; })};
+  channels.erase(channels.begin(), last.base());
 
-    for (std::size_t i_bx{0}; i_bx < digis.getNumSamplesPerDigi(); i_bx++) {
-      sorted_samples[i_bx][eid.fiber()][eid.elink()][eid.channel()] =
-          digi.at(i_bx).raw();
+  /**
+   * Split the sorted channels by link and the links by fpga
+   *
+   * The channels of link i are channels[link_begin[i]] up to
+   * channels[link_begin[i + 1]] and the links of fpga j are
+   * the links fpga_begin[j] up to fpga_begin[j + 1].
+   */
+  auto eid = [&](std::size_t i_channel) {
+    return ldmx::EcalElectronicsID::idFromIndex(channels[i_channel].first);
+  };
+  std::vector<std::size_t> link_begin, fpga_begin;
+  for (std::size_t i_channel{0}; i_channel < channels.size(); i_channel++) {
+    bool new_fpga{i_channel == 0 or
+                  eid(i_channel).fiber() != eid(i_channel - 1).fiber()};
+    if (new_fpga) fpga_begin.push_back(link_begin.size());
+    if (new_fpga or eid(i_channel).elink() != eid(i_channel - 1).elink()) {
+      link_begin.push_back(i_channel);
     }
   }
+  fpga_begin.push_back(link_begin.size());
+  link_begin.push_back(channels.size());
 
   /**
    * Encoding
@@ -74,8 +100,7 @@ void EcalRawEncoder::produce(framework::Event& event) {
   std::vector<uint32_t> buffer;
   // word to use for constructing buffer
   static uint32_t word;
-  uint32_t i_bx{0};
-  for (auto const& bunch : sorted_samples) {
+  for (uint32_t i_bx{0}; i_bx < digis.getNumSamplesPerDigi(); i_bx++) {
     /**TODO calculate bunch ID, read request, and orbit from sample ID, event
      * number, and run number placeholder: bunch ID = event number read request
      * = sample ID orbit = run number
@@ -84,8 +109,11 @@ void EcalRawEncoder::produce(framework::Event& event) {
     uint32_t rreq = i_bx;
     uint32_t orbit = event.getEventHeader().getRun();
 
-    // bunch lists the fpgs, links, and channels with their corresponding sample
-    for (auto const& [fpga_id, links] : bunch) {
+    for (std::size_t i_fpga{0}; i_fpga + 1 < fpga_begin.size(); i_fpga++) {
+      std::size_t first_link{fpga_begin[i_fpga]},
+          n_links{fpga_begin[i_fpga + 1] - first_link};
+      uint32_t fpga_id = eid(link_begin[first_link]).fiber();
+
       /**
        * Calculate lengths of link sub-packets
        *
@@ -98,8 +126,10 @@ void EcalRawEncoder::produce(framework::Event& event) {
        *  len of link = 3 + 1 + channels.size() + 1;
        */
       std::vector<uint32_t> link_lengths;
-      for (auto const& [link_id, channels] : links) {
-        link_lengths.push_back(3 + 1 + channels.size() + 1);
+      for (std::size_t i_link{first_link}; i_link < first_link + n_links;
+           i_link++) {
+        link_lengths.push_back(3 + 1 + link_begin[i_link + 1] -
+                               link_begin[i_link] + 1);
       }
 
       /**
@@ -119,7 +149,9 @@ void EcalRawEncoder::produce(framework::Event& event) {
         total_length += link_len;
       }
 
+      // the checksums are computed over the words once they are in the buffer
       packing::utility::CRC fpga_crc;
+      std::size_t fpga_word0{buffer.size()};
       /** Encode Bunch Header
        * We have a few words of header material before the actual data.
        * This header material is assumed to be encoded as in Table 3
@@ -139,17 +171,15 @@ void EcalRawEncoder::produce(framework::Event& event) {
 
       word |= (1 << (12 + 1 + 6 + 8));                                // version
       word |= (fpga_id & packing::utility::mask<8>) << (12 + 1 + 6);  // FPGA
-      word |= (links.size() & packing::utility::mask<6>) << (12 + 1);  // NLINKS
+      word |= (n_links & packing::utility::mask<6>) << (12 + 1);  // NLINKS
       word |= (total_length & packing::utility::mask<12>);  // LEN TODO
       buffer.push_back(word);
-      fpga_crc << word;
 
       word = 0;
       word |= (bunch_id & packing::utility::mask<12>) << 20;  // BX ID
       word |= (rreq & packing::utility::mask<10>) << 10;      // RREQ
       word |= (orbit & packing::utility::mask<10>);           // OR
       buffer.push_back(word);
-      fpga_crc << word;
 
       /**
        * Encode lengths of link subpackets
@@ -158,7 +188,7 @@ void EcalRawEncoder::produce(framework::Event& event) {
         word = 0;
         for (uint32_t i_linklen{0}; i_linklen < 4; i_linklen++) {
           uint32_t i_link = 4 * i_linkword + i_linklen;
-          if (i_link <= link_lengths.size()) {
+          if (i_link < link_lengths.size()) {
             // we have a link
             word |= (((0b11 << 6) +
                       (link_lengths.at(i_link) & packing::utility::mask<6>))
@@ -166,11 +196,14 @@ void EcalRawEncoder::produce(framework::Event& event) {
           }  // do we have a link for this linklen subword?
         }    // loop through subwords in this word
         buffer.push_back(word);
-        fpga_crc << word;
       }  // loop through words
+      fpga_crc.update(std::span<const uint32_t>(buffer).subspan(fpga_word0));
 
-      // fpga lists the links and channels with their corresponding sample
-      for (auto const& [link_id, channels] : links) {
+      for (std::size_t i_link{first_link}; i_link < first_link + n_links;
+           i_link++) {
+        std::size_t first_channel{link_begin[i_link]},
+            end_channel{link_begin[i_link + 1]};
+        uint32_t link_id = eid(first_channel).elink();
         /**
          * Prepare RO Map bitset
          */
@@ -178,11 +211,12 @@ void EcalRawEncoder::produce(framework::Event& event) {
         ro_map.set(0);           // special "header" word from ROC
         ro_map.set(39);          // trailing checksum from ROC
         // each link maps the channels that were readout to their sample
-        for (auto const& [channel, sample] : channels) {
-          ro_map.set(channel);
+        for (std::size_t i{first_channel}; i < end_channel; i++) {
+          ro_map.set(eid(i).channel());
         }
 
         packing::utility::CRC link_crc;
+        std::size_t link_word0{buffer.size()};
         /** Encode Each Link in Sequence
          * Now we should be decoding each link serially
          * where each link was encoded as in Table 4 of
@@ -199,14 +233,10 @@ void EcalRawEncoder::produce(framework::Event& event) {
         word |= (ro_map >> 32).to_ulong();
 
         buffer.push_back(word);
-        fpga_crc << word;
-        link_crc << word;
 
         // next header word is end of RO map
         word = (ro_map.to_ulong() & 0xFFFFFFFF);
         buffer.push_back(word);
-        fpga_crc << word;
-        link_crc << word;
 
         // special "header" word from ROC
         word = 0;
@@ -218,8 +248,6 @@ void EcalRawEncoder::produce(framework::Event& event) {
         // here
         word |= 0b0101;
         buffer.push_back(word);
-        fpga_crc << word;
-        link_crc << word;
 
         /**
          * TODO: Common-Mode Channel
@@ -230,16 +258,16 @@ void EcalRawEncoder::produce(framework::Event& event) {
          */
 
         // put samples into buffer
-        for (auto const& [channel, sample] : channels) {
-          buffer.push_back(sample);
-          fpga_crc << sample;
-          link_crc << sample;
+        for (std::size_t i{first_channel}; i < end_channel; i++) {
+          buffer.push_back(digis.getDigi(channels[i].second).at(i_bx).raw());
         }
+        // the link words go into both checksums
+        link_crc.update(std::span<const uint32_t>(buffer).subspan(link_word0),
+                        fpga_crc);
         buffer.push_back(link_crc.get());
         fpga_crc << link_crc.get();
       }
     }
-    i_bx++;
   }
 
   event.add(output_name_, buffer);
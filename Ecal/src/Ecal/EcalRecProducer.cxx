@@ -22,8 +22,8 @@ EcalRecProducer::~EcalRecProducer() {}
 
 void EcalRecProducer::configure(framework::config::Parameters& ps) {
   // collection names
-  digiCollName_ = ps.getParameter<std::string>("digiCollName");
-  digiPassName_ = ps.getParameter<std::string>("digiPassName");
+  digis_ = {ps.getParameter<std::string>("digiCollName"),
+            ps.getParameter<std::string>("digiPassName")};
   simHitCollName_ = ps.getParameter<std::string>("simHitCollName");
   simHitPassName_ = ps.getParameter<std::string>("simHitPassName");
   recHitCollName_ = ps.getParameter<std::string>("recHitCollName");
@@ -39,17 +39,13 @@ void EcalRecProducer::configure(framework::config::Parameters& ps) {
 
 void EcalRecProducer::produce(framework::Event& event) {
   // Get the Ecal Geometry
-  const auto& geometry = getCondition<ldmx::EcalGeometry>(
-      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
+  const auto& geometry{getCondition(geometry_)};
 
   // Get the reconstruction parameters
-  EcalReconConditions the_conditions(
-      getCondition<conditions::DoubleTableCondition>(
-          EcalReconConditions::CONDITIONS_NAME));
+  EcalReconConditions the_conditions(getCondition(reconConditions_));
 
   std::vector<ldmx::EcalHit> ecalRecHits;
-  auto ecalDigis =
-      event.getObject<ldmx::HgcrocDigiCollection>(digiCollName_, digiPassName_);
+  const auto& ecalDigis{digis_(event)};
   // loop through digis
   for (auto digi : ecalDigis) {
     // ID from first digi sample
@@ -13,20 +13,19 @@ EcalTrigPrimDigiProducer::EcalTrigPrimDigiProducer(const std::string& name,
 void EcalTrigPrimDigiProducer::configure(framework::config::Parameters& ps) {
   digiCollName_ = ps.getParameter<std::string>("digiCollName");
   digiPassName_ = ps.getParameter<std::string>("digiPassName");
-  condObjName_ =
-      ps.getParameter<std::string>("condObjName", "EcalTrigPrimDigiConditions");
+  conditions_ = {
+      ps.getParameter<std::string>("condObjName", "EcalTrigPrimDigiConditions")};
 }
 
 void EcalTrigPrimDigiProducer::produce(framework::Event& event) {
-  const EcalTriggerGeometry& geom = getCondition<EcalTriggerGeometry>(
-      EcalTriggerGeometry::CONDITIONS_OBJECT_NAME);
+  const EcalTriggerGeometry& geom{getCondition(geometry_)};
 
   const ldmx::HgcrocDigiCollection& ecalDigis =
       event.getObject<ldmx::HgcrocDigiCollection>(digiCollName_, digiPassName_);
 
   // get the calibration object
-  const conditions::IntegerTableCondition& conditions =
-      getCondition<conditions::IntegerTableCondition>(condObjName_);
+  const conditions::IntegerTableCondition& conditions{
+      getCondition(conditions_)};
 
   // construct the calculator...
   ldmx::HgcrocTriggerCalculations calc(conditions);
@@ -4,6 +4,7 @@
 #include "DetDescr/EcalGeometry.h"
 #include "DetDescr/SimSpecialID.h"
 #include "Ecal/Event/EcalHit.h"
+#include "Framework/TruthIndex.h"
 #include "Recon/Event/EventConstants.h"
 #include "SimCore/Event/SimParticle.h"
 #include "SimCore/Event/SimTrackerHit.h"
@@ -90,7 +91,10 @@ void EcalVetoProcessor::configure(framework::config::Parameters &parameters) {
   featureListName_ = parameters.getParameter<std::string>("feature_list_name");
   // Load BDT ONNX file
   rt_ = std::make_unique<ldmx::Ort::ONNXRuntime>(
-      parameters.getParameter<std::string>("bdt_file"));
+      parameters.getParameter<std::string>("bdt_file"), nullptr,
+      parameters.getParameter<int>("intra_op_threads", 1));
+  // the features are written straight into the input of the model
+  rt_->bind({featureListName_}, {"probabilities"});
 
   // Read in arrays holding 68% containment radius per layer
   // for different bins in momentum/angle
@@ -188,57 +192,16 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   }
 
   if (event.exists("EcalScoringPlaneHits")) {
-    //
-    // Loop through all of the sim particles and find the recoil electron.
-    //
-
-    // Get the collection of simulated particles from the event
-    auto particleMap{event.getMap<int, ldmx::SimParticle>("SimParticles")};
-
-    // Search for the recoil electron
-    auto [recoilTrackID, recoilElectron] = Analysis::getRecoil(particleMap);
-
-    // Find ECAL SP hit for recoil electron
-    auto ecalSpHits{
-        event.getCollection<ldmx::SimTrackerHit>("EcalScoringPlaneHits")};
-    float pmax = 0;
-    for (ldmx::SimTrackerHit &spHit : ecalSpHits) {
-      ldmx::SimSpecialID hit_id(spHit.getID());
-      if (hit_id.plane() != 31 || spHit.getMomentum()[2] <= 0) continue;
-
-      if (spHit.getTrackID() == recoilTrackID) {
-        if (sqrt(pow(spHit.getMomentum()[0], 2) +
-                 pow(spHit.getMomentum()[1], 2) +
-                 pow(spHit.getMomentum()[2], 2)) > pmax) {
-          recoilP = spHit.getMomentum();
-          recoilPos = spHit.getPosition();
-          pmax = sqrt(pow(recoilP[0], 2) + pow(recoilP[1], 2) +
-                      pow(recoilP[2], 2));
-        }
-      }
+    // Find the hits of the recoil electron on the ECAL and target
+    // scoring planes, shared with the other processors of this event
+    const auto& truth{event.getDerived<framework::TruthIndex>()};
+    if (const ldmx::SimTrackerHit* spHit = truth.getRecoilAtEcal()) {
+      recoilP = spHit->getMomentum();
+      recoilPos = spHit->getPosition();
     }
-
-    // Find target SP hit for recoil electron
-    if (event.exists("TargetScoringPlaneHits")) {
-      std::vector<ldmx::SimTrackerHit> targetSpHits =
-          event.getCollection<ldmx::SimTrackerHit>("TargetScoringPlaneHits");
-      pmax = 0;
-      for (ldmx::SimTrackerHit &spHit : targetSpHits) {
-        ldmx::SimSpecialID hit_id(spHit.getID());
-        if (hit_id.plane() != 1 || spHit.getMomentum()[2] <= 0) continue;
-
-        if (spHit.getTrackID() == recoilTrackID) {
-          if (sqrt(pow(spHit.getMomentum()[0], 2) +
-                   pow(spHit.getMomentum()[1], 2) +
-                   pow(spHit.getMomentum()[2], 2)) > pmax) {
-            recoilPAtTarget = spHit.getMomentum();
-            recoilPosAtTarget = spHit.getPosition();
-            pmax =
-                sqrt(pow(recoilPAtTarget[0], 2) + pow(recoilPAtTarget[1], 2) +
-                     pow(recoilPAtTarget[2], 2));
-          }
-        }
-      }
+    if (const ldmx::SimTrackerHit* spHit = truth.getRecoilAtTarget()) {
+      recoilPAtTarget = spHit->getMomentum();
+      recoilPosAtTarget = spHit->getPosition();
     }
   }
 
@@ -1103,8 +1066,17 @@ void EcalVetoProcessor::produce(framework::Event &event) {
       ecalLayerEdepReadout_, recoilP, recoilPos);
 
   buildBDTFeatureVector(result);
-  ldmx::Ort::FloatArrays inputs({bdtFeatures_});
-  float pred = rt_->run({featureListName_}, inputs, {"probabilities"})[0].at(1);
+  std::span<float> features{rt_->getInput(0)};
+  if (features.size() != bdtFeatures_.size()) {
+    EXCEPTION_RAISE("BDTFeatures", "The BDT expects " +
+                                       std::to_string(features.size()) +
+                                       " features but " +
+                                       std::to_string(bdtFeatures_.size()) +
+                                       " were built.");
+  }
+  std::copy(bdtFeatures_.begin(), bdtFeatures_.end(), features.begin());
+  rt_->run();
+  float pred = rt_->getOutput(0)[1];
   // Other considerations were (nLinregTracks_ == 0)  && (firstNearPhLayer_ >=
   // 6)
   // && (epAng_ > 3.0 && epAng_ < 900 || epSep_ > 10.0 && epSep_ < 900)
@@ -1205,15 +1177,12 @@ void EcalVetoProcessor::fillIsolatedHitMap(
     // Get neighboring cell id's and try to look them up in the full cell map
     // (constant speed algo.)
     //  these ideas are only cell/module (must ignore layer)
-    std::vector<ldmx::EcalID> cellNbrIds = geometry_->getNN(id);
-
-    for (int k = 0; k < cellNbrIds.size(); k++) {
+    for (const auto &flat_nbr : geometry_->getNNView(id)) {
       // update neighbor ID to the current layer
-      cellNbrIds[k] = ldmx::EcalID(id.layer(), cellNbrIds[k].module(),
-                                   cellNbrIds[k].cell());
+      ldmx::EcalID nbr(id.layer(), flat_nbr.module(), flat_nbr.cell());
       // look in cell hit map to see if it is there
-      if (cellMap.find(cellNbrIds[k]) != cellMap.end()) {
-        isolatedHit = std::make_pair(false, cellNbrIds[k]);
+      if (cellMap.find(nbr) != cellMap.end()) {
+        isolatedHit = std::make_pair(false, nbr);
         break;
       }
     }
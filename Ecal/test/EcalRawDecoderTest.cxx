@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Ecal/EcalRawDecoder.h"
+#include "Framework/Process.h"
+#include "Packing/Utility/CRC.h"
+#include "Recon/Event/HgcrocDigiCollection.h"
+
+namespace ecal {
+namespace test {
+
+/**
+ * Encode fake data of one FPGA in the ECal DAQ format
+ *
+ * Each bunch has a header of two words, the lengths of the links, the
+ * links and the FPGA checksum. Each link has two header words with its
+ * ROC ID and readout map followed by the ROC header, the common mode,
+ * 36 DAQ channels and the link checksum. Channel 38 is left out of the
+ * readout map since electronic IDs only count channels up to 37.
+ *
+ * @param[in] n_samples number of bunches (samples per digi)
+ * @param[in] n_links number of links of the FPGA
+ * @return encoded buffer of bytes
+ */
+static std::vector<uint8_t> encodeBunches(uint32_t n_samples,
+                                          uint32_t n_links) {
+  const uint32_t fpga{1}, link_len{2 + 39};
+  std::mt19937 gen{42};
+  std::vector<uint32_t> words;
+  for (uint32_t i_bx{0}; i_bx < n_samples; i_bx++) {
+    std::size_t fpga_begin{words.size()};
+    uint32_t n_linkwords{n_links / 4 + (n_links % 4 != 0)};
+    uint32_t total_length{2 + n_linkwords + n_links * link_len + 1};
+    // VERSION (4) | FPGA_ID (8) | NLINKS (6) | 00 | LEN (12)
+    words.push_back((1u << 28) | (fpga << 20) | (n_links << 14) |
+                    (total_length & 0xfff));
+    // BX ID (12) | RREQ (10) | OR (10)
+    words.push_back(i_bx << 10);
+    for (uint32_t i_link{0}; i_link < n_links; i_link++) {
+      if (i_link % 4 == 0) words.push_back(0);
+      words.back() |= link_len << (8 * (i_link % 4));
+    }
+    for (uint32_t i_link{0}; i_link < n_links; i_link++) {
+      // ROC_ID (16) | CRC ok (1) | 0 (7) | RO Map (8)
+      words.push_back(((256 + i_link) << 16) | 0xbf);
+      words.push_back(0xffffffff);
+      for (uint32_t channel{0}; channel < 39; channel++) words.push_back(gen());
+    }
+    packing::utility::CRC fpga_crc;
+    fpga_crc.update(std::span<const uint32_t>(words).subspan(fpga_begin));
+    words.push_back(fpga_crc.get());
+  }
+  std::vector<uint8_t> buffer(words.size() * sizeof(uint32_t));
+  std::memcpy(buffer.data(), words.data(), buffer.size());
+  return buffer;
+}
+
+}  // namespace test
+}  // namespace ecal
+
+/**
+ * Throughput of decoding ECal raw data
+ *
+ * The buffer of each event is decoded into digis by the EcalRawDecoder
+ * without translating the electronic IDs, so no conditions are needed.
+ * Only the time spent in the decoder is counted. Run explicitly with
+ *
+ *  run_test "[benchmark]"
+ */
+TEST_CASE("Ecal Raw Decoder Throughput", "[.][benchmark]") {
+  const uint32_t n_samples{8}, n_links{32};
+  const int n_events{200};
+  auto buffer{ecal::test::encodeBunches(n_samples, n_links)};
+
+  framework::config::Parameters configuration;
+  framework::Process process(configuration);
+  ecal::EcalRawDecoder decoder("decoder", process);
+  framework::config::Parameters parameters;
+  parameters.addParameter<std::string>("input_name", "EcalRawData");
+  parameters.addParameter<std::string>("input_pass", "");
+  parameters.addParameter<std::string>("output_name", "EcalDigis");
+  parameters.addParameter("roc_version", 3);
+  parameters.addParameter("translate_eid", false);
+  decoder.configure(parameters);
+
+  std::chrono::duration<double> elapsed{0};
+  for (int i_event{0}; i_event < n_events; i_event++) {
+    framework::Event event("bench");
+    event.add("EcalRawData", buffer);
+    auto start{std::chrono::steady_clock::now()};
+    decoder.produce(event);
+    elapsed += std::chrono::steady_clock::now() - start;
+
+    if (i_event == 0) {
+      const auto& digis{
+          event.getObject<ldmx::HgcrocDigiCollection>("EcalDigis")};
+      CHECK(digis.getNumDigis() == n_links * 36);
+      CHECK(digis.getNumSamplesPerDigi() == n_samples);
+    }
+  }
+
+  double gb{1e-9 * n_events * buffer.size()};
+  std::cout << "EcalRawDecoder : " << gb / elapsed.count() << " GB/s"
+            << std::endl;
+}
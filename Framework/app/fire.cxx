@@ -128,6 +128,8 @@ int main(int argc, char* argv[]) try {
   std::cout << "---- LDMXSW: Event processing complete  --------" << std::endl;
   return 0;
 } catch (const std::exception& e) {
+  // write out any log messages still waiting to be written
+  framework::logging::close();
   std::cerr << "Unrecognized Exception: " << e.what() << std::endl;
   return 127;
 }
@@ -28,6 +28,21 @@ namespace framework {
  */
 class Bus {
  public:
+  /**
+   * How a new branch is laid out on a tree
+   *
+   * Objects are split into a branch per data member down to the split
+   * level, each with its own baskets. Many small baskets are slower to
+   * write and compress less, while large baskets take more memory and
+   * make reading a few entries slower.
+   */
+  struct Layout {
+    /// size of the baskets in bytes, zero for the default of the branch type
+    int basket_size_{0};
+    /// split level of object branches
+    int split_level_{3};
+  };
+
   /**
    * Get the baggage carried by the passenger with the passed name.
    *
@@ -84,6 +99,39 @@ class Bus {
     getRef<BaggageType>(name).update(obj);
   }
 
+  /**
+   * Board a new passenger carrying the same type of object as the
+   * passenger with the same name on another bus
+   *
+   * This allows us to move products between buses without knowing
+   * their type, e.g. when collecting the products of an event processed
+   * on a worker thread into the event that is attached to the output tree.
+   *
+   * @note Does not check if we are overwriting any other passenger!
+   *
+   * @param[in] other bus that has a passenger with the input name on it
+   * @param[in] name name of passenger (corresponds to branch name)
+   */
+  void board(const Bus& other, const std::string& name) {
+    passengers_[name] = other.passengers_.at(name)->emptyCopy();
+    passengers_[name]->clear();
+  }
+
+  /**
+   * Update the object a passenger is carrying with the object carried
+   * by the passenger with the same name on another bus
+   *
+   * @see Seat::copy for how we copy without knowing the type
+   * @throws std::bad_cast if the two passengers are not carrying
+   * the same type of object
+   *
+   * @param[in] other bus that has a passenger with the input name on it
+   * @param[in] name name of passenger (corresponds to branch name)
+   */
+  void update(const Bus& other, const std::string& name) {
+    passengers_.at(name)->copy(*other.passengers_.at(name));
+  }
+
   /**
    * Attach the input tree to the object a passenger is carrying
    *
@@ -102,10 +150,22 @@ class Bus {
    * @param[in] name name of passenger (and branch of tree)
    * @param[in] can_create true if we are allowed to create new branches on the
    * tree
+   * @param[in] layout layout of the branch if it is created
    * @returns pointer to branch that we attached to (may be null)
    */
+  TBranch* attach(TTree* tree, const std::string& name, bool can_create,
+                  const Layout& layout) {
+    return passengers_[name]->attach(tree, name, can_create, layout);
+  }
+
+  /**
+   * Attach the input tree to the object a passenger is carrying,
+   * making any new branch with the default layout
+   *
+   * @see attach(TTree*,const std::string&,bool,const Layout&)
+   */
   TBranch* attach(TTree* tree, const std::string& name, bool can_create) {
-    return passengers_[name]->attach(tree, name, can_create);
+    return attach(tree, name, can_create, Layout());
   }
 
   /**
@@ -199,11 +259,12 @@ class Bus {
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create if true, we can create a new branch if we don't
      * find one
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null if no
      * branch found)
      */
     virtual TBranch* attach(TTree* tree, const std::string& branch_name,
-                            bool can_create) = 0;
+                            bool can_create, const Layout& layout) = 0;
 
     /**
      * Clear this passenger
@@ -215,6 +276,24 @@ class Bus {
      */
     virtual void clear() = 0;
 
+    /**
+     * Create a new passenger carrying a default constructed
+     * object of the same type as this passenger.
+     *
+     * @return handle to the new passenger
+     */
+    virtual std::unique_ptr<Seat> emptyCopy() const = 0;
+
+    /**
+     * Copy the object carried by another passenger into ours.
+     *
+     * @throws std::bad_cast if the other passenger is not carrying
+     * the same type of object
+     *
+     * @param[in] other passenger whose object we should copy
+     */
+    virtual void copy(const Seat& other) = 0;
+
     /**
      * Define how we should stream the object to the input stream.
      *
@@ -329,20 +408,22 @@ class Bus {
      * we simply return the nullptr signifying that this branch
      * doesn't exist.
      *
-     * @see attach(the_type<T>,TTree*,const std::string&,bool)
+     * @see attach(the_type<T>,TTree*,const std::string&,bool,const Layout&)
      * for how we attach to higher-level classes
      *
-     * @see attachBasic(TTree*,const std::string&,bool)
+     * @see attachBasic(TTree*,const std::string&,bool,const Layout&)
      * for how we attach to basic types
      *
      * @param[in] tree pointer to TTree to attach to
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create allow us to create a branch on tree if needed
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null)
      */
     virtual TBranch* attach(TTree* tree, const std::string& branch_name,
-                            bool can_create) {
-      return attach(the_type<BaggageType>{}, tree, branch_name, can_create);
+                            bool can_create, const Layout& layout) {
+      return attach(the_type<BaggageType>{}, tree, branch_name, can_create,
+                    layout);
     }
 
     /**
@@ -376,6 +457,25 @@ class Bus {
      */
     virtual void clear() { clear(the_type<BaggageType>{}); }
 
+    /**
+     * Create a new passenger carrying the same type as us
+     * @return handle to a new passenger
+     */
+    virtual std::unique_ptr<Seat> emptyCopy() const {
+      return std::make_unique<Passenger<BaggageType>>();
+    }
+
+    /**
+     * Copy the baggage of another passenger into ours
+     *
+     * @see update for how the copy is done
+     * @throws std::bad_cast if other is not carrying a BaggageType
+     * @param[in] other passenger to copy from
+     */
+    virtual void copy(const Seat& other) {
+      update(dynamic_cast<const Passenger<BaggageType>&>(other).get());
+    }
+
     /**
      * Stream the passenger's object to the input ostream
      *
@@ -452,11 +552,12 @@ class Bus {
      * @param[in] tree pointer to TTree to attach to
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create allow us to create a branch on tree if needed
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null)
      */
     template <typename T>
     TBranch* attach(the_type<T> t, TTree* tree, const std::string& branch_name,
-                    bool can_create) {
+                    bool can_create, const Layout& layout) {
       TBranch* branch = tree->GetBranch(branch_name.c_str());
       if (branch) {
         /**
@@ -481,7 +582,10 @@ class Bus {
          * If the branch doesn't already exist and we are allowed to make
          * one, we make a new one passing our baggage.
          */
-        branch = tree->Branch(branch_name.c_str(), baggage_, 100000, 3);
+        branch = tree->Branch(
+            branch_name.c_str(), baggage_,
+            layout.basket_size_ > 0 ? layout.basket_size_ : 100000,
+            layout.split_level_);
       }
       return branch;
     }
@@ -508,10 +612,11 @@ class Bus {
      * @param[in] tree pointer to TTree to attach to
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create allow us to create a branch on tree if needed
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null)
      */
     TBranch* attachBasic(TTree* tree, const std::string& branch_name,
-                         bool can_create) {
+                         bool can_create, const Layout& layout) {
       TBranch* branch = tree->GetBranch(branch_name.c_str());
       if (branch) {
         // branch already exists
@@ -525,7 +630,8 @@ class Bus {
         std::string cpp_type = typeid(*baggage_).name();
         branch = tree->Branch(
             branch_name.c_str(), baggage_,
-            (branch_name + "/" + cpp_to_root_type_name.at(cpp_type)).c_str());
+            (branch_name + "/" + cpp_to_root_type_name.at(cpp_type)).c_str(),
+            layout.basket_size_ > 0 ? layout.basket_size_ : 32000);
       }
       return branch;
     }
@@ -539,11 +645,13 @@ class Bus {
      * @param[in] tree pointer to TTree to attach to
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create allow us to create a branch on tree if needed
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null)
      */
     TBranch* attach(the_type<bool> t, TTree* tree,
-                    const std::string& branch_name, bool can_create) {
-      return attachBasic(tree, branch_name, can_create);
+                    const std::string& branch_name, bool can_create,
+                    const Layout& layout) {
+      return attachBasic(tree, branch_name, can_create, layout);
     }
 
     /**
@@ -555,11 +663,13 @@ class Bus {
      * @param[in] tree pointer to TTree to attach to
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create allow us to create a branch on tree if needed
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null)
      */
     TBranch* attach(the_type<short> t, TTree* tree,
-                    const std::string& branch_name, bool can_create) {
-      return attachBasic(tree, branch_name, can_create);
+                    const std::string& branch_name, bool can_create,
+                    const Layout& layout) {
+      return attachBasic(tree, branch_name, can_create, layout);
     }
 
     /**
@@ -571,11 +681,13 @@ class Bus {
      * @param[in] tree pointer to TTree to attach to
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create allow us to create a branch on tree if needed
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null)
      */
     TBranch* attach(the_type<int> t, TTree* tree,
-                    const std::string& branch_name, bool can_create) {
-      return attachBasic(tree, branch_name, can_create);
+                    const std::string& branch_name, bool can_create,
+                    const Layout& layout) {
+      return attachBasic(tree, branch_name, can_create, layout);
     }
 
     /**
@@ -587,11 +699,13 @@ class Bus {
      * @param[in] tree pointer to TTree to attach to
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create allow us to create a branch on tree if needed
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null)
      */
     TBranch* attach(the_type<long> t, TTree* tree,
-                    const std::string& branch_name, bool can_create) {
-      return attachBasic(tree, branch_name, can_create);
+                    const std::string& branch_name, bool can_create,
+                    const Layout& layout) {
+      return attachBasic(tree, branch_name, can_create, layout);
     }
 
     /**
@@ -603,11 +717,13 @@ class Bus {
      * @param[in] tree pointer to TTree to attach to
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create allow us to create a branch on tree if needed
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null)
      */
     TBranch* attach(the_type<float> t, TTree* tree,
-                    const std::string& branch_name, bool can_create) {
-      return attachBasic(tree, branch_name, can_create);
+                    const std::string& branch_name, bool can_create,
+                    const Layout& layout) {
+      return attachBasic(tree, branch_name, can_create, layout);
     }
 
     /**
@@ -619,11 +735,13 @@ class Bus {
      * @param[in] tree pointer to TTree to attach to
      * @param[in] branch_name name of branch we should attach to
      * @param[in] can_create allow us to create a branch on tree if needed
+     * @param[in] layout layout of the branch if it is created
      * @returns pointer to branch that we attached to (maybe be null)
      */
     TBranch* attach(the_type<double> t, TTree* tree,
-                    const std::string& branch_name, bool can_create) {
-      return attachBasic(tree, branch_name, can_create);
+                    const std::string& branch_name, bool can_create,
+                    const Layout& layout) {
+      return attachBasic(tree, branch_name, can_create, layout);
     }
 
    private:  // specializations of clear
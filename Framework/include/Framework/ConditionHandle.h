@@ -0,0 +1,98 @@
+/**
+ * @file ConditionHandle.h
+ * @brief Typed handle for repeated access to a conditions object
+ */
+
+#ifndef FRAMEWORK_CONDITIONHANDLE_H_
+#define FRAMEWORK_CONDITIONHANDLE_H_
+
+#include <atomic>
+#include <string>
+
+#include "Framework/Conditions.h"
+
+namespace framework {
+
+/**
+ * @class ConditionHandle
+ * @brief Typed handle to a conditions object
+ *
+ * Conditions::getCondition looks up the cache entry of the requested
+ * object by name and checks its interval of validity against the
+ * current event header on every call. A handle does this the first time
+ * it is used and keeps the object along with the epoch of the Conditions
+ * it was found in. The epoch only changes when the cached objects may
+ * have become invalid (a change of run), so using a handle in later events is
+ * a single comparison of integers.
+ *
+ * Handles are meant to be members of a processor, given their
+ * names in configure and used in produce or analyze.
+ * ```cpp
+ * // in the processor declaration
+ * framework::ConditionHandle<ldmx::EcalGeometry> geometry_{
+ *     ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME};
+ * // in produce
+ * const ldmx::EcalGeometry& geometry{getCondition(geometry_)};
+ * ```
+ *
+ * The epoch is only changed between events while no processor is
+ * running, so a handle can be used by a processor running on several
+ * threads at once: they all find the same object when the epoch changes.
+ *
+ * @see Conditions::getConditionPtr for how the object is found
+ * @tparam T type of conditions object the handle points to
+ */
+template <class T>
+class ConditionHandle {
+ public:
+  /**
+   * Define the conditions object this handle points to
+   *
+   * @param[in] name name of the conditions object
+   */
+  ConditionHandle(const std::string &name = "") : name_{name} {}
+
+  /// copy the name of the object, the copy resolves it again
+  ConditionHandle(const ConditionHandle &other) : name_{other.name_} {}
+
+  /// copy the name of the object, the copy resolves it again
+  ConditionHandle &operator=(const ConditionHandle &other) {
+    name_ = other.name_;
+    epoch_.store(0, std::memory_order_relaxed);
+    return *this;
+  }
+
+  /**
+   * Get the conditions object for the current event
+   *
+   * @throws Exception if the object could not be provided,
+   * see Conditions::getConditionPtr
+   * @throws std::bad_cast if the object is not of type T
+   * @param[in] conditions conditions of the running process
+   * @return const reference to the conditions object
+   */
+  const T &operator()(Conditions &conditions) const {
+    std::size_t epoch{conditions.getEpoch()};
+    if (epoch_.load(std::memory_order_acquire) != epoch) {
+      obj_.store(&conditions.getCondition<T>(name_),
+                 std::memory_order_relaxed);
+      epoch_.store(epoch, std::memory_order_release);
+    }
+    return *obj_.load(std::memory_order_relaxed);
+  }
+
+  /// @return name of the conditions object this handle points to
+  const std::string &name() const { return name_; }
+
+ private:
+  /// name of the conditions object
+  std::string name_;
+  /// epoch of the conditions the object was found in, zero if never found
+  mutable std::atomic<std::size_t> epoch_{0};
+  /// the object found
+  mutable std::atomic<const T *> obj_{nullptr};
+};  // ConditionHandle
+
+}  // namespace framework
+
+#endif  // FRAMEWORK_CONDITIONHANDLE_H_
@@ -92,6 +92,21 @@ class Conditions {
    */
   ConditionsIOV getConditionIOV(const std::string& condition_name) const;
 
+  /**
+   * Current epoch of the conditions
+   *
+   * The intervals of validity are ranges of runs, so the cached objects
+   * can only become invalid when the run of the events changes. The epoch
+   * starts at one and goes up by one with each change of run, so objects
+   * found in the same epoch are still valid. This is how a ConditionHandle
+   * knows it can skip looking up its object.
+   *
+   * @see newEpoch for when the epoch changes
+   *
+   * @returns epoch of the cached conditions
+   */
+  std::size_t getEpoch() const { return epoch_; }
+
   /**
    * Calls onProcessStart for all ConditionsObjectProviders
    */
@@ -102,6 +117,15 @@ class Conditions {
    */
   void onProcessEnd();
 
+  /**
+   * Starts a new epoch, so the handles look up their objects again
+   *
+   * This is called whenever the run of the events changes, even if there
+   * is no run header for the new run and onNewRun isn't called. It is
+   * called between events, while no processors are running.
+   */
+  void newEpoch() { epoch_++; }
+
   /**
    * Calls onNewRun for all ConditionsObjectProviders
    */
@@ -135,6 +159,9 @@ class Conditions {
 
   /** Conditions cache */
   std::map<std::string, CacheEntry> cache_;
+
+  /** Epoch of the cached conditions, @see getEpoch */
+  std::size_t epoch_{1};
 };
 
 }  // namespace framework
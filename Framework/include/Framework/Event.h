@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
@@ -144,6 +145,35 @@ class Event {
    */
   void addDrop(const std::string &exp);
 
+  /**
+   * Add a rule for how the branches of new products are laid out
+   *
+   * When a product is first written to the output tree, the last rule
+   * (in the order they were added) whose regex matches its branch name
+   * chooses the layout of its branch. Products matching no rule get the
+   * default layout of Bus::Layout.
+   *
+   * @see layoutClonedBranches for the branches copied from the input
+   *
+   * @param exp regex to match the branch name
+   * @param layout basket size and split level of the branch
+   * @param compression compression setting of the branch, negative to
+   * use the setting of the output file
+   */
+  void addBranchLayout(const std::string &exp, const Bus::Layout &layout,
+                       int compression);
+
+  /**
+   * Apply the branch layout rules to the branches of an output tree
+   * cloned from the input tree
+   *
+   * Only the basket size and compression of a cloned branch can be
+   * changed, it keeps the split level it was written with.
+   *
+   * @param tree output tree cloned from the input tree
+   */
+  void layoutClonedBranches(TTree *tree) const;
+
   /**
    * Adds an object to the event bus
    *
@@ -207,7 +237,7 @@ class Event {
       if (outputTree_ and not shouldDrop(branchName)) {
         // we are writing this branch to an output file, so let's
         //  attach this passenger to the output tree
-        TBranch *outBranch = bus_.attach(outputTree_, branchName, true);
+        TBranch *outBranch = attachOutput(branchName);
         // get type name from branch if possible,
         //  otherwise use compiler level type name (above)
         std::string class_name{outBranch->GetClassName()};
@@ -217,11 +247,16 @@ class Event {
       // check for cache entry to remove
       auto it_known{knownLookups_.find(collectionName)};
       if (it_known != knownLookups_.end()) knownLookups_.erase(it_known);
+      // handles may have been resolved to a product of another pass
+      handleCache_.clear();
 
       // add us to list of products
       products_.emplace_back(collectionName, passName_, tname);
     }
 
+    // derived objects may depend on this product
+    invalidateDerived();
+
     // copy input contents into bus passenger
     try {
       bus_.update(branchName, obj);
@@ -235,6 +270,24 @@ class Event {
     return;
   }
 
+  /**
+   * Add all of the products created during this pass in another event
+   *
+   * This is used when several events are processed at once: each is
+   * processed with its own Event (and its own Bus) and the products they
+   * created are then copied, in order, into the Event attached to the
+   * output tree. The same checks and drop rules as in add are applied.
+   * The event header of the other event replaces ours, so that changes
+   * made to it while processing are written as well.
+   *
+   * @see add for adding a single product
+   * @throws Exception if one of the products has already been filled
+   * in this event.
+   *
+   * @param[in] other event to copy products from
+   */
+  void copyProducts(const Event &other);
+
   /**
    * Get an general object from the event bus
    *
@@ -351,12 +404,16 @@ class Event {
                             " when attempting to get '" + branchName + "'.");
       }
       branch->GetEntry(ientry);
+      if (lazy_) lazyBranches_[branchName] = {branch, ientry};
     } else if (not already_on_board) {
       // not found in loaded branches and there is no inputTree,
       // so no hope of finding an unloaded object
       EXCEPTION_RAISE("ProductNotFound", "No product found for name '" +
                                              collectionName + "' and pass '" +
                                              passName_ + "'");
+    } else if (lazy_ and inputTree_) {
+      // the entry was only loaded, read this branch if it isn't yet
+      readLazily(branchName);
     }
 
     // we've made sure the passenger is on the bus
@@ -407,6 +464,67 @@ class Event {
     return getObject<std::map<KeyType, ValType> >(collectionName, passName);
   }
 
+  /**
+   * Reserve a slot for a new ProductHandle in the cache of resolved products
+   *
+   * @see ProductHandle for how this is used
+   * @return index of the new handle
+   */
+  static std::size_t reserveHandle();
+
+  /**
+   * Get the object resolved by the handle with the input index
+   *
+   * @param[in] index handle index from reserveHandle
+   * @return pointer to the object or nullptr if the handle is not resolved
+   */
+  const void *getCachedProduct(std::size_t index) const {
+    return index < handleCache_.size() ? handleCache_[index] : nullptr;
+  }
+
+  /**
+   * Store the object resolved by the handle with the input index
+   *
+   * @param[in] index handle index from reserveHandle
+   * @param[in] obj pointer to the object the handle resolved to
+   */
+  void cacheProduct(std::size_t index, const void *obj) const {
+    if (index >= handleCache_.size()) handleCache_.resize(index + 1, nullptr);
+    handleCache_[index] = obj;
+  }
+
+  /**
+   * Get an object computed from the products of this event
+   *
+   * Several processors often need the same view of the event products
+   * (e.g. lookups into the SimParticles), which is wasteful to compute
+   * in each of them. The first processor asking for a type of derived
+   * object in an event has it updated from the event, the following
+   * ones get the same object back. Adding products to the event or
+   * going to the next event marks the derived objects out of date, so
+   * they are updated again on the next request, reusing their memory.
+   * ```cpp
+   * const auto &truth{event.getDerived<framework::TruthIndex>()};
+   * ```
+   *
+   * @tparam T type of derived object, default constructible with a
+   * method `void update(const Event&)` filling it from the event
+   * @return const reference to the up-to-date object
+   */
+  template <typename T>
+  const T &getDerived() const {
+    static const std::size_t index{reserveDerived()};
+    if (index >= derived_.size()) derived_.resize(index + 1);
+    Derived &slot{derived_[index]};
+    if (not slot.obj_) slot.obj_ = std::make_shared<T>();
+    T &obj{*static_cast<T *>(slot.obj_.get())};
+    if (not slot.valid_) {
+      obj.update(*this);
+      slot.valid_ = true;
+    }
+    return obj;
+  }
+
   /**
    * Set the input data tree.
    * @param tree The input data tree.
@@ -444,9 +562,35 @@ class Event {
 
   /**
    * Action to be executed before the tree is filled.
+   *
+   * Puts our copy of the event header on the bus, either as a new
+   * product or in place of the one read from the input tree.
    */
   void beforeFill();
 
+  /**
+   * Read branches on demand instead of with the whole entry
+   *
+   * The input file only loads the entry of the input tree and each
+   * branch is read the first time its product is asked for in an
+   * event. Branches that are never asked for are never read,
+   * unless they are copied to the output tree.
+   *
+   * @see readClonedBranches
+   * @param[in] lazy true if the input entries are only loaded
+   */
+  void setLazyReading(bool lazy) { lazy_ = lazy; }
+
+  /**
+   * Read the input branches that the output tree copies
+   *
+   * The output tree cloned from the input tree is filled from the
+   * same objects, so they need to be read for events that are kept
+   * even if no processor asked for them. This does nothing unless
+   * reading lazily, since otherwise they are read with the entry.
+   */
+  void readClonedBranches();
+
   /**
    * Clear this object's data (including passengers).
    */
@@ -492,6 +636,33 @@ class Event {
    */
   bool shouldDrop(const std::string &collName) const;
 
+  /**
+   * Attach a passenger to the output tree, making its branch with the
+   * layout chosen by the branch layout rules
+   *
+   * @param branchName name of the passenger and branch
+   * @return the branch on the output tree
+   */
+  TBranch *attachOutput(const std::string &branchName);
+
+  /// Reserve the index of a new type of derived object
+  static std::size_t reserveDerived();
+
+  /**
+   * Read one branch of the input tree for its current entry
+   *
+   * Does nothing if the branch was already read for this entry
+   * or if it isn't on the input tree (made in this pass).
+   *
+   * @param[in] branchName name of the branch
+   */
+  void readLazily(const std::string &branchName) const;
+
+  /// Mark all of the derived objects as out of date
+  void invalidateDerived() const {
+    for (Derived &slot : derived_) slot.valid_ = false;
+  }
+
   /**
    * Make a branch name from a collection and pass name.
    * @param collectionName The collection name.
@@ -531,6 +702,24 @@ class Event {
    */
   TTree *inputTree_{nullptr};
 
+  /**
+   * Are the input branches read on demand?
+   */
+  bool lazy_{false};
+
+  /// A branch of the input tree and the entry it was last read for
+  struct LazyBranch {
+    TBranch *branch_;
+    long long int entry_;
+  };
+
+  /**
+   * Input branches read on demand by name.
+   *
+   * The branch is null for products that are not on the input tree.
+   */
+  mutable std::map<std::string, LazyBranch> lazyBranches_;
+
   /// The total number of electrons in the event
   int electronCount_{1};
 
@@ -559,11 +748,46 @@ class Event {
    */
   std::vector<regex_t> regexDropCollections_;
 
+  /// A rule for the layout of the branches matching a regex
+  struct BranchLayout {
+    /// regex matching the branch names
+    regex_t regex_;
+    /// basket size and split level of the branch
+    Bus::Layout layout_;
+    /// compression setting of the branch, negative to use the file's
+    int compression_;
+  };
+
+  /**
+   * Rules for the layout of new branches, in the order they were added.
+   */
+  std::vector<BranchLayout> branchLayouts_;
+
   /**
    * Efficiency cache for empty pass name lookups.
    */
   mutable std::map<std::string, std::string> knownLookups_;
 
+  /**
+   * Objects on the bus resolved by ProductHandles, indexed by handle.
+   *
+   * Cleared whenever the passengers on the bus are replaced.
+   */
+  mutable std::vector<const void *> handleCache_;
+
+  /// A derived object and whether it is up to date with the event
+  struct Derived {
+    std::shared_ptr<void> obj_;
+    bool valid_{false};
+  };
+
+  /**
+   * Objects derived from the products, indexed by type.
+   *
+   * @see getDerived
+   */
+  mutable std::vector<Derived> derived_;
+
   /**
    * List of all the event products
    */
@@ -3,6 +3,7 @@
 
 //---< C++ >---//
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,8 @@
 #include "Framework/Event.h"
 
 //---< ROOT >---//
+#include "ROOT/TBufferMerger.hxx"
+#include "RVersion.h"
 #include "TFile.h"
 #include "TTree.h"
 
@@ -20,6 +23,14 @@ class RunHeader;
 
 namespace framework {
 
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 26, 0)
+using BufferMerger = ROOT::TBufferMerger;
+using BufferMergerFile = ROOT::TBufferMergerFile;
+#else
+using BufferMerger = ROOT::Experimental::TBufferMerger;
+using BufferMergerFile = ROOT::Experimental::TBufferMergerFile;
+#endif
+
 /**
  * This class manages all ROOT file input/output operations.
  */
@@ -38,10 +49,15 @@ class EventFile {
    * @param[in] isOutputFile true if this file is written out
    * @param[in] isSingleOutput true if only one output file is being written to
    * @param[in] isLoopable true for an input file where events can be reused
+   * @param[in] isMerged true for an output file written through a buffer
+   * merger, @see isMerged
+   * @param[in] merged output file whose buffer merger this file writes
+   * through, nullptr if this file doesn't share another's output
    */
   EventFile(const framework::config::Parameters &params,
             const std::string &filename, EventFile *parent, bool isOutputFile,
-            bool isSingleOutput, bool isLoopable);
+            bool isSingleOutput, bool isLoopable, bool isMerged = false,
+            EventFile *merged = nullptr);
 
   /**
    * Constructor to make a pileup overlay file.
@@ -69,10 +85,28 @@ class EventFile {
    * @param[in] parent Parent file for cloning data tree.
    * @param[in] isSingleOutput boolean check if only one output file is being
    * written to
+   * @param[in] isMerged true if the file is written through a buffer merger
+   * so that other files can write into it from several threads
    */
   EventFile(const framework::config::Parameters &param,
             const std::string &fileName, EventFile *parent,
-            bool isSingleOutput = false);
+            bool isSingleOutput = false, bool isMerged = false);
+
+  /**
+   * Class constructor for writing the events of a parent file into the
+   * same output as another file.
+   *
+   * This is used when events are processed on several threads, each
+   * event in flight is written into its own buffer in memory which is
+   * merged into the output file of the merged file. The tree of the
+   * parent is cloned by setupMergedOutput.
+   *
+   * @param[in] params The parameters used to configure this EventFile.
+   * @param[in] merged Output file constructed with isMerged.
+   * @param[in] parent Parent file for cloning data tree.
+   */
+  EventFile(const framework::config::Parameters &params, EventFile *merged,
+            EventFile *parent);
 
   /**
    * Class constructor to make a file to read in an event root file.
@@ -174,6 +208,72 @@ class EventFile {
    */
   void updateParent(EventFile *parent);
 
+  /**
+   * Copy the entries of the parent kept during a fast skim
+   *
+   * In a fast skim, only the event header and the branches made in this
+   * pass are filled as the events are processed, so changes processors
+   * make to the header are kept. The other branches cloned from the input are
+   * copied here for the kept entries, after all of the events of the
+   * parent file have been processed. If every entry was kept, the
+   * compressed baskets are copied as they are without being unzipped
+   * and streamed again. Otherwise only the kept entries are read.
+   *
+   * The branches are filled one by one instead of through TTree::Fill,
+   * so the auto flush setting doesn't group the entries of a fast skim
+   * into clusters. Baskets are written once they are full and copied
+   * baskets keep the clusters of the input file.
+   *
+   * This needs to be called before the parent file is closed and
+   * does nothing if we are not in a fast skim.
+   */
+  void copySkimmedEntries();
+
+  /**
+   * Is this file written through a buffer merger?
+   *
+   * The output of a merged file is kept in memory and handed to a
+   * ROOT::TBufferMerger which writes it to disk. Other files can write
+   * into the same output from other threads, so the events processed
+   * on several threads are compressed on those threads instead of one
+   * at a time when they are stored.
+   */
+  bool isMerged() const { return merger_ != nullptr; }
+
+  /**
+   * Clone the tree of the parent to write into the merged output
+   *
+   * This needs to be called *after* setupEvent and addDrop since the
+   * drop/keep rules are used to choose the branches that are cloned.
+   * The events are then written with writeEvent instead of nextEvent,
+   * since the parent is moved around with seekEvent.
+   */
+  void setupMergedOutput();
+
+  /**
+   * Write the current event of the parent into the merged output
+   *
+   * Unlike nextEvent, this does not go on to the next event.
+   *
+   * @param[in] storeCurrentEvent Should we save the current event?
+   */
+  void writeEvent(bool storeCurrentEvent);
+
+  /**
+   * Hand the events written so far to the buffer merger if they
+   * take up enough memory
+   *
+   * The buffers writing into the same output share MERGE_BYTES between
+   * them, so the memory they take up together doesn't grow with the
+   * number of buffers. Whatever is left is handed over when this file
+   * is destroyed. The merged output has the events of each buffer in
+   * the order these are called, so calling them in a fixed order gives
+   * the same output file from run to run.
+   *
+   * @param[in] n_buffers number of buffers writing into the same output
+   */
+  void mergeIfFull(std::size_t n_buffers);
+
   /**
    * Get the Event object containing the event data.
    * @return The Event object containing event data.
@@ -217,6 +317,20 @@ class EventFile {
    */
   int skipToEvent(int offset);
 
+  /**
+   * Load a specific entry of an input file into the event bus
+   *
+   * Unlike nextEvent, this allows the entries of an input file to
+   * be read out of order. It is used when several events are in flight
+   * at once and each of them is read through its own EventFile.
+   *
+   * @throws Exception if this file is an output file or has a parent
+   *
+   * @param[in] ientry index of the entry in the event tree to load
+   * @return true if the entry exists and was loaded
+   */
+  bool seekEvent(Long64_t ientry);
+
   /**
    * Write the run header into the run map
    *
@@ -276,7 +390,45 @@ class EventFile {
    */
   void importRunHeaders();
 
+  /**
+   * Configure the read cache of an input tree to read and decompress
+   * entries ahead of the entry being processed
+   *
+   * This uses ROOT's TTreeCache to read the baskets of the next entries
+   * in large blocks and TTreeCacheUnzip to decompress them on background
+   * threads while the current event is being processed.
+   *
+   * @param[in] depth number of entries to read ahead
+   */
+  void setupPrefetch(int depth);
+
+  /**
+   * Load the current entry of an input tree
+   *
+   * All of the active branches are read unless reading lazily, in which
+   * case the event reads the branches it is asked for.
+   */
+  void loadEntry();
+
+  /**
+   * Clone the tree of the parent into our tree
+   *
+   * Only the branches that are active after applying the pre-clone
+   * rules are cloned, the dropped branches are reactivated afterwards
+   * so they can still be read.
+   */
+  void cloneParentTree();
+
  private:
+  /// Smallest read cache we will create when prefetching entries
+  static constexpr Long64_t MIN_PREFETCH_BYTES{10 * 1024 * 1024};
+
+  /// Number of entries used to learn which branches are read
+  static constexpr int PREFETCH_LEARN_ENTRIES{10};
+
+  /// Memory the buffers of a merged output share before they are handed over
+  static constexpr Long64_t MERGE_BYTES{32 * 1024 * 1024};
+
   /// The number of entries in the tree.
   Long64_t entries_{-1};
 
@@ -295,6 +447,40 @@ class EventFile {
   /// True if this is an input file with pileup overlay events */
   bool isLoopable_{false};
 
+  /// True if the input entries are copied after processing
+  bool fastSkim_{false};
+
+  /// True if entries are only loaded and branches are read on demand
+  bool lazy_{false};
+
+  /**
+   * Auto flush setting of the event tree
+   *
+   * Positive to write the baskets out every this many entries,
+   * negative to write them out every this many bytes.
+   */
+  Long64_t autoFlush_{-30000000};
+
+  /// Rules for the layout of the branches made in this pass
+  std::vector<framework::config::Parameters> branchLayouts_;
+
+  /**
+   * Number of branches cloned from the input tree
+   *
+   * In a fast skim, the event header is moved behind these branches
+   * since it is filled with the events instead of being copied.
+   */
+  int n_cloned_{0};
+
+  /// Entries of the parent to copy in a fast skim
+  std::vector<Long64_t> kept_;
+
+  /// The merger writing the output file if it is merged
+  std::shared_ptr<BufferMerger> merger_;
+
+  /// The buffer in memory written into if the output is merged
+  std::shared_ptr<BufferMergerFile> merged_file_;
+
   /// The backing TFile for this EventFile.
   TFile *file_{nullptr};
 
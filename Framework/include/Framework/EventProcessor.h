@@ -10,6 +10,7 @@
 /*~~~~~~~~~~~~~~~*/
 /*   Framework   */
 /*~~~~~~~~~~~~~~~*/
+#include "Framework/ConditionHandle.h"
 #include "Framework/Conditions.h"
 #include "Framework/Configure/Parameters.h"
 #include "Framework/Event.h"
@@ -134,6 +135,24 @@ class EventProcessor {
    */
   virtual void onProcessEnd() {}
 
+  /**
+   * Can this processor be called on several events at once?
+   *
+   * When the Process is configured to use more than one thread
+   * (p.numThreads in the python configuration), processors that
+   * return true here are called concurrently from the worker threads.
+   * All other processors are called on one event at a time and in the
+   * order the events were read, so they see the same sequence of events
+   * as they would in a single-threaded run.
+   *
+   * A processor should only declare itself thread safe if it holds no
+   * state that is modified while processing an event (e.g. random number
+   * generators, counters, histograms or ntuples).
+   *
+   * @return false by default
+   */
+  virtual bool isThreadSafe() const { return false; }
+
   /**
    * Access a conditions object for the current event
    */
@@ -142,6 +161,31 @@ class EventProcessor {
     return getConditions().getCondition<T>(condition_name);
   }
 
+  /**
+   * Access a conditions object for the current event through a handle
+   *
+   * The object is only looked up again when a new run starts.
+   *
+   * @see ConditionHandle
+   * @param[in] handle handle to the conditions object
+   * @return const reference to the conditions object
+   */
+  template <class T>
+  const T &getCondition(const ConditionHandle<T> &handle) {
+    return handle(getConditions());
+  }
+
+  /**
+   * Interval of validity of a conditions object for the current event
+   *
+   * The object must have been accessed with getCondition before,
+   * objects not in the cache have a null interval of validity.
+   *
+   * @param[in] condition_name name of the conditions object
+   * @return interval over which the cached object is valid
+   */
+  ConditionsIOV getConditionIOV(const std::string &condition_name) const;
+
   /**
    * Access/create a directory in the histogram file for this event
    * processor to create histograms and analysis tuples.
@@ -182,6 +226,18 @@ class EventProcessor {
    */
   int getRunNumber() const;
 
+  /**
+   * Get the pass name from the process
+   * @return pass name of the products added in this process
+   */
+  const std::string &getPassName() const;
+
+  /**
+   * Get the number of events the process is going to end with
+   * @return event limit, negative if there isn't one
+   */
+  int getEventLimit() const;
+
   /**
    * Get the processor name
    */
@@ -6,7 +6,9 @@
 //----------------//
 #include <iostream>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 //----------//
 //   ROOT   //
@@ -14,6 +16,11 @@
 #include "TH1F.h"
 #include "TH2F.h"
 
+//----------//
+//   LDMX   //
+//----------//
+#include "Framework/Exception/Exception.h"
+
 namespace framework {
 
 /**
@@ -23,11 +30,25 @@ namespace framework {
  *
  * Helpful for managing all those TH1 pointers by name instead of using
  * variables.
+ *
+ * When events are processed on several threads, each thread fills its
+ * own copy (shard) of every histogram so that no locking is needed while
+ * filling. The shards are added into the pooled histograms once the
+ * processing is done.
  */
 class HistogramPool {
  private:
+  /** Index of each histogram in the pool by name. */
+  std::unordered_map<std::string, std::size_t> indices_;
+
   /** Container for all histograms. */
-  std::unordered_map<std::string, TH1*> histograms_;
+  std::vector<TH1*> histograms_;
+
+  /** Copies of all histograms for each thread filling them. */
+  std::vector<std::vector<TH1*>> shards_;
+
+  /** Shard filled by the calling thread, negative for the pooled ones. */
+  static thread_local int current_shard_;
 
   /**
    * Private constructor to prevent instantiation
@@ -49,9 +70,25 @@ class HistogramPool {
   /**
    * Insert a histogram into the pool
    *
+   * If the shards have already been made, each of them gets an empty
+   * copy of the histogram. This must not be done while other threads
+   * are filling histograms.
+   *
    * @note Does not check for any doubling of names!
+   * A histogram inserted with the name of another replaces it.
+   *
+   * @return index of the histogram in the pool
+   */
+  std::size_t insert(const std::string& name, TH1* hist);
+
+  /**
+   * Get the index of a histogram using its name.
+   *
+   * Checks if histogram exists.
+   *
+   * @return index of the histogram named "name" in the pool
    */
-  void insert(const std::string& name, TH1* hist) { histograms_[name] = hist; }
+  std::size_t index(const std::string& name) const;
 
   /**
    * Get a histogram using its name.
@@ -60,10 +97,115 @@ class HistogramPool {
    *
    * @return Retrieve the histogram named "name" from the pool.
    */
-  TH1* get(const std::string& name);
+  TH1* get(const std::string& name) { return histograms_[index(name)]; }
 
+  /**
+   * Get a histogram using its index.
+   *
+   * @return Retrieve the histogram at "index" in the pool.
+   */
+  TH1* get(std::size_t index) { return histograms_[index]; }
+
+  /**
+   * Get the histogram that the calling thread should fill
+   *
+   * This is the histogram in the pool unless the calling thread
+   * was assigned a shard.
+   *
+   * @param[in] index index of histogram in the pool
+   * @return histogram to fill
+   */
+  TH1* local(std::size_t index) {
+    if (current_shard_ < 0 or
+        static_cast<std::size_t>(current_shard_) >= shards_.size())
+      return histograms_[index];
+    return shards_[current_shard_][index];
+  }
+
+  /**
+   * Make a shard of all the histograms for each of the input
+   * number of threads
+   *
+   * Nothing is done if the shards already exist. Histograms inserted
+   * afterwards are added to the existing shards.
+   *
+   * @param[in] n_shards number of shards to make
+   */
+  void makeShards(int n_shards);
+
+  /**
+   * Assign a shard to the calling thread
+   *
+   * @param[in] i_shard index of shard, negative to fill the pooled histograms
+   */
+  static void useShard(int i_shard) { current_shard_ = i_shard; }
+
+  /**
+   * Add the contents of all of the shards into the pooled histograms
+   * and delete the shards.
+   *
+   * Must not be called while other threads are filling histograms.
+   */
+  void mergeShards();
+
+ private:
+  /**
+   * Make an empty copy of a histogram for a shard
+   *
+   * @param[in] hist histogram in the pool to copy
+   * @return new empty copy not attached to any directory
+   */
+  static TH1* makeShard(TH1* hist);
 };  // HistogramPool
 
+/**
+ * @class HistogramHandle
+ *
+ * Typed handle to a histogram in the HistogramPool
+ *
+ * Filling through a handle avoids building the full name of the
+ * histogram and looking it up in the pool for every fill.
+ *
+ * @tparam HistType type of ROOT histogram (e.g. TH1F or TH2F)
+ */
+template <typename HistType>
+class HistogramHandle {
+ public:
+  /// Default constructor, the handle can't be filled until it is assigned
+  HistogramHandle() = default;
+
+  /**
+   * Constructor
+   *
+   * @param[in] index index of the histogram in the pool
+   * @param[in] weight weight to fill the histogram with
+   */
+  HistogramHandle(std::size_t index, const double* weight)
+      : index_{index}, weight_{weight} {}
+
+  /**
+   * Fill the histogram with the current weight
+   *
+   * @param[in] values value to fill on each axis
+   */
+  template <typename... Values>
+  void fill(Values... values) const {
+    static_cast<HistType*>(HistogramPool::getInstance().local(index_))
+        ->Fill(values..., *weight_);
+  }
+
+  /// @return the histogram in the pool
+  HistType* get() const {
+    return static_cast<HistType*>(HistogramPool::getInstance().get(index_));
+  }
+
+ private:
+  /// index of histogram in the pool
+  std::size_t index_{0};
+  /// weight to fill with
+  const double* weight_{nullptr};
+};  // HistogramHandle
+
 /**
  * @class HistogramHelper
  *
@@ -101,9 +243,11 @@ class HistogramHelper {
    * @param bins Total number of histogram bins.
    * @param xmin The lower histogram limit.
    * @param xmax The upper histogram limit.
+   * @return handle to the new histogram
    */
-  void create(const std::string& name, const std::string& xLabel,
-              const double& bins, const double& xmin, const double& xmax);
+  HistogramHandle<TH1F> create(const std::string& name,
+                               const std::string& xLabel, const double& bins,
+                               const double& xmin, const double& xmax);
 
   /**
    * Create a ROOT 1D histogram of type TH1F and pool it for later use.
@@ -114,9 +258,11 @@ class HistogramHelper {
    *             title.
    * @param xLabel Title of the x axis.
    * @param bins vector of bin edges
+   * @return handle to the new histogram
    */
-  void create(const std::string& name, const std::string& xLabel,
-              const std::vector<double>& bins);
+  HistogramHandle<TH1F> create(const std::string& name,
+                               const std::string& xLabel,
+                               const std::vector<double>& bins);
 
   /**
    * Create a ROOT 2D histogram of type TH2F and pool it for later use.
@@ -133,11 +279,13 @@ class HistogramHelper {
    * @param ybins Total number of histogram bins in y.
    * @param ymin The lower histogram limit in y.
    * @param ymax The upper histogram limit in y.
+   * @return handle to the new histogram
    */
-  void create(const std::string& name, const std::string& xLabel,
-              const double& xbins, const double& xmin, const double& xmax,
-              const std::string& yLabel, const double& ybins,
-              const double& ymin, const double& ymax);
+  HistogramHandle<TH2F> create(const std::string& name,
+                               const std::string& xLabel, const double& xbins,
+                               const double& xmin, const double& xmax,
+                               const std::string& yLabel, const double& ybins,
+                               const double& ymin, const double& ymax);
 
   /**
    * Create a ROOT 2D histogram of type TH2F and pool it for later use.
@@ -150,10 +298,13 @@ class HistogramHelper {
    * @param xbins Bin edges on x axis
    * @param yLabel Title of the y axis.
    * @param ybins Bin edges on y axis
+   * @return handle to the new histogram
    */
-  void create(const std::string& name, const std::string& xLabel,
-              const std::vector<double>& xbins, const std::string& yLabel,
-              const std::vector<double>& ybins);
+  HistogramHandle<TH2F> create(const std::string& name,
+                               const std::string& xLabel,
+                               const std::vector<double>& xbins,
+                               const std::string& yLabel,
+                               const std::vector<double>& ybins);
 
   /**
    * Fill a 1D histogram
@@ -164,7 +315,7 @@ class HistogramHelper {
    * @param val value to fill
    */
   void fill(const std::string& name, const double& val) {
-    auto hist = dynamic_cast<TH1F*>(this->get(name));
+    auto hist = dynamic_cast<TH1F*>(this->local(name));
     if (hist) {
       hist->Fill(val, theWeight_);
     }
@@ -180,7 +331,7 @@ class HistogramHelper {
    * @param valy y value to fill
    */
   void fill(const std::string& name, const double& valx, const double& valy) {
-    auto hist = dynamic_cast<TH2F*>(this->get(name));
+    auto hist = dynamic_cast<TH2F*>(this->local(name));
     if (hist) {
       hist->Fill(valx, valy, theWeight_);
     }
@@ -194,6 +345,41 @@ class HistogramHelper {
   TH1* get(const std::string& name) {
     return HistogramPool::getInstance().get(name_ + "_" + name);
   }
+
+  /**
+   * Get a handle to a histogram by name
+   *
+   * This is helpful for histograms that were not created by
+   * this helper directly (e.g. from the python configuration).
+   * The handle should be retrieved once (e.g. in onProcessStart)
+   * and then used for filling.
+   *
+   * @throws Exception if the histogram isn't of the requested type
+   * @tparam HistType type of ROOT histogram
+   * @param name name of the histogram to get
+   * @return handle to the histogram
+   */
+  template <typename HistType>
+  HistogramHandle<HistType> handle(const std::string& name) const {
+    auto& pool{HistogramPool::getInstance()};
+    std::size_t index{pool.index(name_ + "_" + name)};
+    if (not dynamic_cast<HistType*>(pool.get(index))) {
+      EXCEPTION_RAISE("InvalidArg",
+                      "Histogram " + name + " is not of the requested type.");
+    }
+    return HistogramHandle<HistType>(index, &theWeight_);
+  }
+
+ private:
+  /**
+   * Get the histogram the calling thread should fill by name
+   *
+   * @param name name of the histogram to get
+   */
+  TH1* local(const std::string& name) {
+    auto& pool{HistogramPool::getInstance()};
+    return pool.local(pool.index(name_ + "_" + name));
+  }
 };
 }  // namespace framework
 
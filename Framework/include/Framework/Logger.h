@@ -9,9 +9,10 @@
  */
 #define BOOST_ALL_DYN_LINK 1
 
-#include <boost/log/core.hpp>                 //core logging service
-#include <boost/log/expressions.hpp>          //for attributes and expressions
-#include <boost/log/sinks/sync_frontend.hpp>  //syncronous sink frontend
+#include <boost/log/core.hpp>         //core logging service
+#include <boost/log/expressions.hpp>  //for attributes and expressions
+#include <boost/log/sinks/async_frontend.hpp>  //asynchronous sink frontend
+#include <boost/log/sinks/sync_frontend.hpp>   //syncronous sink frontend
 #include <boost/log/sinks/text_ostream_backend.hpp>  //output stream sink backend
 #include <boost/log/sources/global_logger_storage.hpp>  //for global logger default
 #include <boost/log/sources/severity_channel_logger.hpp>  //for the severity logger
@@ -24,6 +25,17 @@
 
 #include "Framework/Configure/Parameters.h"
 
+/**
+ * Lowest severity level compiled into ldmx_log
+ *
+ * Messages below this level are removed at compile time, so they
+ * cost nothing at run time, not even the check of the filter.
+ * Set with the LDMX_LOG_MIN_LEVEL cmake cache variable.
+ */
+#ifndef LDMX_LOG_MIN_LEVEL
+#define LDMX_LOG_MIN_LEVEL 0
+#endif
+
 namespace framework {
 
 namespace logging {
@@ -70,6 +82,12 @@ logger makeLogger(const std::string& name);
  * This function setups up the terminal and file sinks.
  * Sets their format and filtering level for this run.
  *
+ * By default, the sinks are asynchronous. A message is put on a bounded
+ * queue by the thread logging it and written out by a thread of the sink,
+ * so that the event loop doesn't wait on the terminal or the file.
+ * When the queue is full, the logging thread either waits for room
+ * ("block") or the message is dropped ("drop").
+ *
  * @note Will not setup printing log messages to file if filePath is empty
  * string.
  *
@@ -79,6 +97,8 @@ void open(const framework::config::Parameters& p);
 
 /**
  * Close up the logging
+ *
+ * Waits for the messages on the queues of asynchronous sinks to be written.
  */
 void close();
 
@@ -89,9 +109,12 @@ void close();
  * as an attribute and include it within the logs. This is easier than
  * attempting to update the event number in all of the different logging
  * sources floating around ldmx-sw.
+ *
+ * The event number is kept per thread so that the messages from
+ * worker threads processing different events are labeled correctly.
  */
 class Formatter {
-  int event_number_{0};
+  static thread_local int event_number_;
   Formatter() = default;
 
  public:
@@ -107,6 +130,14 @@ class Formatter {
   /// set the event number in the current Formatter
   static void set(int n);
 
+  /**
+   * get the event number of the current thread
+   *
+   * This is attached to each message when it is made, since
+   * an asynchronous sink formats it on a different thread.
+   */
+  static int number();
+
   /**
    * format the passed record view into the output stream
    *
@@ -143,7 +174,13 @@ class Formatter {
  *
  * Assumes to have access to a variable named theLog_ of type logger.
  * Input logging level (without namespace or enum).
+ *
+ * Levels below LDMX_LOG_MIN_LEVEL are discarded at compile time and
+ * the message is never evaluated.
  */
-#define ldmx_log(lvl) BOOST_LOG_SEV(theLog_, ::framework::logging::level::lvl)
+#define ldmx_log(lvl)                                                    \
+  if constexpr (::framework::logging::level::lvl < LDMX_LOG_MIN_LEVEL) { \
+  } else                                                                 \
+    BOOST_LOG_SEV(theLog_, ::framework::logging::level::lvl)
 
 #endif  // FRAMEWORK_LOGGER_H
@@ -123,6 +123,9 @@ class NtupleManager {
    */
   void reset();
 
+  /// @return true if no ntuples have been created
+  bool empty() const { return trees_.empty(); }
+
   /// Hide Copy Constructor
   NtupleManager(const NtupleManager&) = delete;
 
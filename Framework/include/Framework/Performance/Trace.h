@@ -0,0 +1,236 @@
+#ifndef FRAMEWORK_PERFORMANCE_TRACE
+#define FRAMEWORK_PERFORMANCE_TRACE
+
+#include <chrono>
+#include <iosfwd>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Framework/Performance/Callback.h"
+
+namespace framework::performance {
+
+/**
+ * Record spans of time spent in the framework and write them
+ * out in the Chrome trace event format
+ *
+ * The resulting JSON file can be opened in Perfetto
+ * (https://ui.perfetto.dev) or chrome://tracing to see how the
+ * processors, the reading of the input files and the loading of
+ * conditions overlap on the different threads.
+ *
+ * Each thread records into its own lane, a fixed-size ring buffer,
+ * so recording a span is a couple of clock readings and a copy
+ * without any locking or allocation. Threads that were not given a
+ * lane, like the Geant4 worker threads, don't record anything. When a lane is full, the oldest
+ * spans are overwritten so the file holds the end of the run.
+ * Spans recorded while processing an event are only kept for one
+ * out of every sample_frequency events. Spans outside of events
+ * (new runs, files, reading entries) are always kept.
+ *
+ * The names given to spans are not copied, they are required to stay
+ * valid until the trace is written. Use name() to get a pointer to a
+ * copy of a name that lives as long as the trace.
+ *
+ * ```cpp
+ * {
+ *   performance::Trace::Span span("conditions", name_ptr);
+ *   // ... work to be timed ...
+ * }  // span is recorded when it goes out of scope
+ * ```
+ */
+class Trace {
+  using clock = std::chrono::steady_clock;
+
+ public:
+  /**
+   * A span of time recorded by the calling thread
+   *
+   * The span starts when it is created and is recorded
+   * when it is destroyed. Nothing is done if the trace
+   * is not open or the current event is not sampled.
+   */
+  class Span {
+   public:
+    /**
+     * Start a span
+     *
+     * @param[in] category kind of work done during the span
+     * @param[in] name name of what is doing the work
+     */
+    Span(const char* category, const char* name)
+        : category_{category}, name_{name} {
+      if (active()) begin_ = clock::now();
+    }
+
+    /**
+     * Start a span for a processor callback
+     *
+     * @param[in] cb callback being called
+     * @param[in] name name of processor being called
+     */
+    Span(Callback cb, const char* name) : Span(category(cb), name) {}
+
+    /// record the span
+    ~Span() {
+      if (begin_ != clock::time_point())
+        Trace::get().record(category_, name_, begin_);
+    }
+
+    /// change the name after the span started
+    void rename(const char* name) { name_ = name; }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+   private:
+    /// kind of work done during the span
+    const char* category_;
+    /// name of what is doing the work
+    const char* name_;
+    /// start of the span, left at zero if it is not recorded
+    clock::time_point begin_;
+  };
+
+  /**
+   * Mark the calling thread as processing an event
+   *
+   * The event is recorded as a span enclosing the spans
+   * recorded by the processors. Whether the spans of this
+   * event are kept is decided by the index of the event.
+   */
+  class EventScope {
+   public:
+    /**
+     * Start processing an event
+     *
+     * @param[in] i_event index of the event in this process
+     * @param[in] event_number event number from the event header
+     */
+    EventScope(long int i_event, int event_number);
+
+    /// stop processing the event, later spans are always kept
+    ~EventScope();
+
+    EventScope(const EventScope&) = delete;
+    EventScope& operator=(const EventScope&) = delete;
+
+   private:
+    /// start of the event, left at zero if it is not recorded
+    clock::time_point begin_;
+  };
+
+  /// Hide copy constructor
+  Trace(Trace const&) = delete;
+
+  /// Hide assignment operator
+  void operator=(Trace const&) = delete;
+
+  /// Access the single instance of the trace
+  static Trace& get();
+
+  /**
+   * Start recording spans
+   *
+   * Any spans from a previous opening are discarded.
+   * The calling thread records into lane zero.
+   *
+   * @param[in] n_lanes number of threads recording at once,
+   * lane zero is the thread driving the process
+   * @param[in] buffer_size number of spans kept per lane
+   * @param[in] sample_frequency keep the spans of one out of this many events
+   */
+  void open(std::size_t n_lanes, std::size_t buffer_size,
+            int sample_frequency);
+
+  /**
+   * Stop recording and write the recorded spans
+   *
+   * @param[in] file_name path to JSON file to write
+   * @return false if the file could not be opened
+   */
+  bool close(const std::string& file_name);
+
+  /// Is the trace recording?
+  static bool enabled() { return enabled_; }
+
+  /// Is the trace recording spans from the calling thread?
+  static bool active() { return enabled_ and sampled_; }
+
+  /**
+   * Choose the lane the calling thread records into
+   *
+   * Spans of threads that don't choose a lane are dropped,
+   * so that no two threads record into the same lane.
+   */
+  static void useLane(std::size_t lane) { lane_ = lane; }
+
+  /**
+   * Get a name that lives as long as the trace
+   *
+   * @param[in] name name to copy
+   * @return pointer to the copy
+   */
+  const char* name(const std::string& name);
+
+  /// Category used for spans of the input callback
+  static const char* category(Callback cb);
+
+ private:
+  /// a span that has been recorded
+  struct Record {
+    /// kind of work
+    const char* category_;
+    /// what did the work
+    const char* name_;
+    /// start of span in ns since the trace opened
+    long int begin_;
+    /// length of span in ns
+    long int duration_;
+    /// event being processed, negative outside of events
+    int event_;
+  };
+
+  /// ring buffer of spans recorded by one thread
+  struct Lane {
+    std::vector<Record> records_;
+    /// number of spans recorded, including overwritten ones
+    std::size_t n_recorded_{0};
+  };
+
+  /// Private constructor to prevent instantiation
+  Trace() = default;
+
+  /// put a finished span into the lane of the calling thread
+  void record(const char* category, const char* name,
+              clock::time_point begin);
+
+  /// write the spans as Chrome trace JSON
+  void write(std::ostream& out) const;
+
+  /// is the trace recording?
+  static bool enabled_;
+  /// are the spans of the calling thread kept?
+  static thread_local bool sampled_;
+  /// lane of the calling thread, out of range if it has none
+  static thread_local std::size_t lane_;
+  /// event number being processed by calling thread
+  static thread_local int event_;
+
+  /// time the trace was opened
+  clock::time_point start_;
+  /// keep the spans of one out of this many events
+  int sample_frequency_{1};
+  /// spans recorded by each thread
+  std::vector<Lane> lanes_;
+  /// copies of names given to spans
+  std::set<std::string> names_;
+  /// protect the copies of names
+  std::mutex names_mutex_;
+};
+
+}  // namespace framework::performance
+
+#endif
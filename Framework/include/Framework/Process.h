@@ -11,6 +11,7 @@
 #include "Framework/Conditions.h"
 #include "Framework/Configure/Parameters.h"
 #include "Framework/Exception/Exception.h"
+#include "Framework/Performance/Trace.h"
 #include "Framework/Performance/Tracker.h"
 #include "Framework/RunHeader.h"
 #include "Framework/StorageControl.h"
@@ -64,8 +65,11 @@ class Process {
 
   /**
    * Get the pointer to the current event header, if defined
+   *
+   * When several events are processed at once, this is the header
+   * of the event the calling thread is working on.
    */
-  const ldmx::EventHeader *getEventHeader() const { return eventHeader_; }
+  const ldmx::EventHeader *getEventHeader() const;
 
   /**
    * Get the pointer to the current run header, if defined
@@ -83,6 +87,16 @@ class Process {
    */
   int getLogFrequency() const { return logFrequency_; }
 
+  /**
+   * Get the number of events the process is going to end with
+   *
+   * This is totalEvents if it was set and maxEvents otherwise.
+   * @return event limit, negative if there isn't one
+   */
+  int getEventLimit() const {
+    return totalEvents_ > 0 ? totalEvents_ : eventLimit_;
+  }
+
   /**
    * Run the process.
    */
@@ -105,8 +119,11 @@ class Process {
 
   /**
    * Access the storage control unit for this process
+   *
+   * When several events are processed at once, this is the storage
+   * control unit for the event the calling thread is working on.
    */
-  StorageControl &getStorageController() { return storageController_; }
+  StorageControl &getStorageController();
 
   /**
    * Set the pointer to the current event header, used only for tests
@@ -146,6 +163,48 @@ class Process {
    */
   bool process(int n, int n_tries, Event &event) const;
 
+  /**
+   * Print the event counter if we are configured to
+   *
+   * @param[in] n counter for number of events processed
+   * @param[in] n_tries counter for number of tries on current event
+   * @param[in] event reference to event we are going to process
+   */
+  void logProgress(int n, int n_tries, Event &event) const;
+
+  /**
+   * Process the events of an input file with several threads
+   *
+   * Each event in flight has its own Event bus and its own handle
+   * on the input file. Events are read and processed in windows of a
+   * few events per thread. Processors that declare themselves thread
+   * safe run on these events concurrently while the rest are called on
+   * one event at a time in the order the events were read. The products
+   * of each event are then copied into the output file in input order.
+   *
+   * A window never crosses a change of run, so newRun is only called
+   * while no events are being processed.
+   *
+   * @param[in] infilename name of the input file to process
+   * @param[in] masterFile file providing the run headers
+   * @param[in] outFile output file to write events into (may be null)
+   * @param[in,out] wasRun number of the last run we processed
+   * @param[in,out] n_events_processed counter for number of events processed
+   */
+  void processConcurrently(const std::string &infilename,
+                           EventFile &masterFile, EventFile *outFile,
+                           int &wasRun, int &n_events_processed);
+
+  /**
+   * Notify processors of a new run if the input run is
+   * different from the last one we processed
+   *
+   * @param[in] run number of the run of the current event
+   * @param[in,out] wasRun number of the last run we processed
+   * @param[in] file event file providing the run headers
+   */
+  void checkForNewRun(int run, int &wasRun, EventFile &file);
+
   /**
    * Run through the processors and let them know
    * that we are starting a new run.
@@ -190,6 +249,22 @@ class Process {
    */
   bool skipCorruptedInputFiles_;
 
+  /**
+   * Number of threads to process events with
+   *
+   * Only input files are processed concurrently, events
+   * are always generated on a single thread.
+   */
+  int numThreads_{1};
+
+  /**
+   * Write the events processed on several threads from those threads
+   *
+   * The events are compressed on the worker threads and merged into
+   * the output file, which then isn't in the order of the input.
+   */
+  bool parallelOutput_{false};
+
   /** Storage controller */
   StorageControl storageController_;
 
@@ -236,6 +311,12 @@ class Process {
   /** class with calls backs to track performance measurements of software */
   performance::Tracker *performance_{0};
 
+  /** File to write the trace of spans to, empty if not tracing */
+  std::string traceFile_;
+
+  /** Names of the processors in the sequence, as given to the trace */
+  std::vector<const char *> traceNames_;
+
   /// Turn on logging for our process
   enableLogging("Process");
 };
@@ -0,0 +1,108 @@
+/**
+ * @file ProductHandle.h
+ * @brief Typed handle for repeated access to a product on the event bus
+ */
+
+#ifndef FRAMEWORK_PRODUCTHANDLE_H_
+#define FRAMEWORK_PRODUCTHANDLE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Framework/Event.h"
+
+namespace framework {
+
+/**
+ * @class ProductHandle
+ * @brief Typed handle to an object on the event bus
+ *
+ * Event::getObject has to determine the branch name of the requested
+ * product on every call - searching the list of products when no pass
+ * name is given - and then look up the passenger carrying it by name.
+ * A handle does this lookup the first time it is used with an event
+ * and caches the address of the object inside of that Event, so later
+ * accesses are a single index into a vector. The cache is reset by the
+ * Event whenever its passengers change (new input file or a product
+ * with the same name added in this pass), so the handle resolves again
+ * with the exact same rules and exceptions as getObject.
+ *
+ * Handles are meant to be members of a processor, given their
+ * names in configure and used in produce or analyze.
+ * ```cpp
+ * // in the processor declaration
+ * framework::ProductHandle<std::vector<ldmx::EcalHit>> hits_;
+ * // in configure
+ * hits_ = {parameters.getParameter<std::string>("hitCollName"),
+ *          parameters.getParameter<std::string>("hitPassName")};
+ * // in produce
+ * const std::vector<ldmx::EcalHit>& hits{hits_(event)};
+ * ```
+ *
+ * @see Event::getObject for how the product is found
+ * @tparam T type of object the handle points to
+ */
+template <typename T>
+class ProductHandle {
+ public:
+  /**
+   * Define the product this handle points to
+   *
+   * @param[in] name name of the product
+   * @param[in] pass name of the pass that created the product,
+   * empty to search for the only product with the input name
+   */
+  ProductHandle(const std::string &name = "", const std::string &pass = "")
+      : name_{name}, pass_{pass}, index_{Event::reserveHandle()} {}
+
+  /**
+   * Get the object from the input event
+   *
+   * @throws Exception if the object could not be found, see Event::getObject
+   * @param[in] event event to get the object from
+   * @return const reference to the object in the event
+   */
+  const T &operator()(const Event &event) const {
+    const void *cached{event.getCachedProduct(index_)};
+    if (cached) return *static_cast<const T *>(cached);
+    const T &obj{event.getObject<T>(name_, pass_)};
+    event.cacheProduct(index_, &obj);
+    return obj;
+  }
+
+  /// @return name of product this handle points to
+  const std::string &name() const { return name_; }
+
+  /// @return pass name of product this handle points to
+  const std::string &pass() const { return pass_; }
+
+ private:
+  /// name of the product
+  std::string name_;
+  /// pass name of the product
+  std::string pass_;
+  /// index of this handle in the cache of each Event
+  std::size_t index_;
+};  // ProductHandle
+
+/**
+ * Handle to a collection (std::vector) of objects
+ *
+ * @tparam ContentType type of object stored in the vector
+ */
+template <typename ContentType>
+using CollectionHandle = ProductHandle<std::vector<ContentType>>;
+
+/**
+ * Handle to a map (std::map) of objects
+ *
+ * @tparam KeyType type of object used as the key in the map
+ * @tparam ValType type of object used as the value in the map
+ */
+template <typename KeyType, typename ValType>
+using MapHandle = ProductHandle<std::map<KeyType, ValType>>;
+
+}  // namespace framework
+
+#endif  // FRAMEWORK_PRODUCTHANDLE_H_
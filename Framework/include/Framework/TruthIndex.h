@@ -0,0 +1,250 @@
+/**
+ * @file TruthIndex.h
+ * @brief Per-event lookups into the simulated truth information
+ */
+
+#ifndef FRAMEWORK_TRUTHINDEX_H_
+#define FRAMEWORK_TRUTHINDEX_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Framework/Event.h"
+#include "SimCore/Event/SimParticle.h"
+#include "SimCore/Event/SimTrackerHit.h"
+
+namespace framework {
+
+/**
+ * @class TruthIndex
+ * @brief Lookups into the SimParticles and scoring plane hits of an event
+ *
+ * Processors looking at the truth information keep needing the same
+ * things: the particle with some track ID, the daughters of a particle
+ * that were saved, the scoring plane hits of a track or the recoil
+ * electron where it crosses the target and the ecal face. This index
+ * computes them once per event and is shared by all of the processors
+ * through Event::getDerived.
+ * ```cpp
+ * const auto &truth{event.getDerived<framework::TruthIndex>()};
+ * const ldmx::SimTrackerHit *at_ecal{truth.getRecoilAtEcal()};
+ * ```
+ *
+ * Each part is only computed the first time it is asked for in an event,
+ * so processors only pay for what they use.
+ * - The saved particles are numbered 0 to getNumParticles() - 1 in order
+ *   of their track IDs (dense index), with the saved parents and daughters
+ *   of each particle in flat arrays (compressed sparse rows).
+ * - The hits of a scoring plane collection are ordered by track ID, plane
+ *   and then their position in the collection, so the hits of a track on
+ *   a plane are a contiguous range of that order. Their members are copied
+ *   into columns (ldmx::SimTrackerHitColumns) which the ordering and the
+ *   search for the recoil hits loop over.
+ *
+ * The hits of a scoring plane collection are referred to by their index
+ * in the collection.
+ */
+class TruthIndex {
+ public:
+  /// Range of indices into the particles or a collection of hits
+  class Indices {
+   public:
+    Indices(const int *begin, const int *end) : begin_{begin}, end_{end} {}
+    const int *begin() const { return begin_; }
+    const int *end() const { return end_; }
+    std::size_t size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    int operator[](std::size_t i) const { return begin_[i]; }
+
+   private:
+    const int *begin_, *end_;
+  };
+
+  /// Name of the collection of particles
+  static const std::string PARTICLES;
+  /// Name of the collection of target scoring plane hits
+  static const std::string TARGET_SP_HITS;
+  /// Name of the collection of ecal scoring plane hits
+  static const std::string ECAL_SP_HITS;
+  /// Scoring plane downstream of the target
+  static const int TARGET_PLANE{1};
+  /// Scoring plane in front of the ecal
+  static const int ECAL_PLANE{31};
+
+  /**
+   * Find the recoil electron
+   *
+   * The recoil electron is the electron produced by the dark brem,
+   * or the primary electron (track ID 1) if there was no dark brem.
+   *
+   * @throws std::out_of_range if there is neither
+   * @param[in] particles map of SimParticles by track ID
+   * @return track ID of the recoil electron and the particle
+   */
+  static std::pair<int, const ldmx::SimParticle *> findRecoil(
+      const std::map<int, ldmx::SimParticle> &particles);
+
+  /**
+   * Start over with a new event
+   *
+   * Called by Event::getDerived, nothing is computed until asked for.
+   *
+   * @param[in] event event to index
+   */
+  void update(const Event &event);
+
+  /// Number of saved particles, zero if there are no SimParticles
+  std::size_t getNumParticles() const;
+
+  /**
+   * Dense index of a particle
+   *
+   * @param[in] track_id track ID of the particle
+   * @return index of the particle or -1 if it wasn't saved
+   */
+  int getIndex(int track_id) const;
+
+  /// Track ID of the particle with the input index
+  int getTrackID(int index) const;
+
+  /// The particle with the input index
+  const ldmx::SimParticle &getParticle(int index) const;
+
+  /**
+   * Find a particle by its track ID
+   *
+   * @param[in] track_id track ID of the particle
+   * @return the particle or nullptr if it wasn't saved
+   */
+  const ldmx::SimParticle *findParticle(int track_id) const;
+
+  /// Indices of the saved daughters of the particle with the input index
+  Indices getDaughters(int index) const;
+
+  /// Indices of the saved parents of the particle with the input index
+  Indices getParents(int index) const;
+
+  /**
+   * Track ID of the recoil electron
+   *
+   * @see findRecoil
+   * @throws std::out_of_range if there isn't a recoil electron
+   */
+  int getRecoilTrackID() const;
+
+  /**
+   * The recoil electron
+   *
+   * @see findRecoil
+   * @throws std::out_of_range if there isn't a recoil electron
+   */
+  const ldmx::SimParticle *getRecoil() const;
+
+  /**
+   * Hit of the recoil electron on the target scoring plane
+   *
+   * The hit with the largest momentum going downstream.
+   *
+   * @return the hit or nullptr if there isn't one
+   */
+  const ldmx::SimTrackerHit *getRecoilAtTarget() const;
+
+  /**
+   * Hit of the recoil electron on the scoring plane at the ecal face
+   *
+   * The hit with the largest momentum going downstream.
+   *
+   * @return the hit or nullptr if there isn't one
+   */
+  const ldmx::SimTrackerHit *getRecoilAtEcal() const;
+
+  /**
+   * Hits of a track on one scoring plane
+   *
+   * @param[in] collection name of the scoring plane hit collection
+   * @param[in] track_id track ID of the particle
+   * @param[in] plane scoring plane
+   * @return indices of the hits in the collection, in the order
+   * they are in the collection
+   */
+  Indices getScoringPlaneHits(const std::string &collection, int track_id,
+                              int plane) const;
+
+  /**
+   * Hits of a track on all of the planes of a collection
+   *
+   * @param[in] collection name of the scoring plane hit collection
+   * @param[in] track_id track ID of the particle
+   * @return indices of the hits in the collection, ordered by plane
+   */
+  Indices getScoringPlaneHits(const std::string &collection,
+                              int track_id) const;
+
+ private:
+  /// the hits of a scoring plane collection ordered by track and plane
+  struct ScoringPlane {
+    /// members of the hits in the order of the collection
+    ldmx::SimTrackerHitColumns columns_;
+    /// (track ID, plane) of each hit in the order below
+    std::vector<std::pair<int, int>> keys_;
+    /// indices of the hits in the collection
+    std::vector<int> order_;
+    /// has this been computed for this event?
+    bool valid_{false};
+  };
+
+  /// compute the particle tables if not done yet in this event
+  void indexParticles() const;
+
+  /// dense index of a track ID in the particle tables as they are
+  int find(int track_id) const;
+
+  /// compute the order of the hits in a collection if not done yet
+  const ScoringPlane &indexScoringPlane(const std::string &collection) const;
+
+  /// hit with the largest downstream momentum of the recoil on a plane
+  const ldmx::SimTrackerHit *findRecoilHit(const std::string &collection,
+                                           int plane) const;
+
+  /// range of the keys from begin to end in a scoring plane
+  Indices range(const ScoringPlane &sp, const std::pair<int, int> &begin,
+                const std::pair<int, int> &end) const;
+
+  /// event being indexed
+  const Event *event_{nullptr};
+
+  /// have the particles been indexed in this event?
+  mutable bool particles_valid_{false};
+  /// the saved particles, by dense index
+  mutable std::vector<const ldmx::SimParticle *> particles_;
+  /// track IDs of the saved particles, sorted
+  mutable std::vector<int> track_ids_;
+  /// start of the daughters of each particle, with one past the end
+  mutable std::vector<int> daughter_offsets_;
+  /// dense indices of the daughters
+  mutable std::vector<int> daughters_;
+  /// start of the parents of each particle, with one past the end
+  mutable std::vector<int> parent_offsets_;
+  /// dense indices of the parents
+  mutable std::vector<int> parents_;
+
+  /// have the recoil lookups been done in this event?
+  mutable bool recoil_valid_{false}, recoil_target_valid_{false},
+      recoil_ecal_valid_{false};
+  /// track ID of the recoil electron
+  mutable int recoil_track_id_{-1};
+  /// the recoil electron
+  mutable const ldmx::SimParticle *recoil_{nullptr};
+  /// recoil hits on the target and ecal face
+  mutable const ldmx::SimTrackerHit *recoil_target_{nullptr},
+      *recoil_ecal_{nullptr};
+
+  /// scoring plane collections by name
+  mutable std::map<std::string, ScoringPlane> scoring_planes_;
+};
+
+}  // namespace framework
+
+#endif  // FRAMEWORK_TRUTHINDEX_H_
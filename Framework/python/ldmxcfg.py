@@ -462,6 +462,14 @@ class Logger:
         path to file to direct logging to (if not provided, don't open a file for logging)
     logRules: List[_LogRule]
         list of custom logging rules that override the default terminal and file levels
+    asynchronous: bool
+        write messages out on a separate thread so that processing doesn't wait on them
+    overflow: str
+        what to do when too many messages are waiting to be written,
+        'block' waits for room and 'drop' throws the message away
+
+    Messages below a severity level can also be removed entirely when compiling
+    with the cmake variable LDMX_LOG_MIN_LEVEL.
     """
 
     def __init__(self):
@@ -469,6 +477,8 @@ class Logger:
         self.fileLevel = 0 # everything
         self.filePath  = '' # don't open file for logging
         self.logRules = []
+        self.asynchronous = True
+        self.overflow = 'block' # wait for room in the queue
 
 
     def custom(self, name, level):
@@ -500,6 +510,40 @@ class Logger:
         self.custom(name, level = 3)
 
     
+class BranchLayout:
+    """How the branches of some products are written to the output file
+
+    The regex is matched against the name of the branch of a product,
+    which is its name and the pass name joined by an underscore
+    (e.g. 'EcalSimHits_sim'). When several layouts match a branch,
+    the last one in Process.branchLayouts is used.
+
+    Branches copied from the input files keep the split level they were
+    written with, only their basket size and compression are changed.
+
+    Parameters
+    ----------
+    regex : str
+        Regular expression matching the branch names
+    basketSize : int
+        Size of the baskets of the branch in bytes. Small objects need less
+        than the default (100 kB) while large collections benefit from more.
+        Zero keeps the default.
+    splitLevel : int
+        How deep objects are split into a branch per data member. Zero writes
+        each object as a whole, which is faster for small objects always read together.
+    compression : int
+        Compression setting of the branch, built like Process.compressionSetting.
+        Negative (the default) uses the setting of the file.
+    """
+
+    def __init__(self, regex, basketSize = 0, splitLevel = 3, compression = -1):
+        self.regex = regex
+        self.basketSize = basketSize
+        self.splitLevel = splitLevel
+        self.compression = compression
+
+
 class Process:
     """Process configuration object
 
@@ -546,6 +590,47 @@ class Process:
         List of skimming rules for which processors the process should listen to when deciding whether to keep an event
     logFrequency : int
         Print the event number whenever its modulus with this frequency is zero
+    numThreads : int
+        Number of threads to process the events of input files with.
+        Processors that declare themselves thread safe run on several events at once,
+        the others see one event at a time in input order.
+    inputPrefetchDepth : int
+        Number of entries of the input files to read and decompress ahead of the
+        entry being processed. Zero (the default) leaves ROOT's default read cache in place.
+    ioThreads : int
+        Number of threads ROOT may use to decompress and deserialize branches
+        (ROOT implicit multi-threading). Zero (the default) keeps ROOT single-threaded.
+    lazyInputReading : bool
+        Only read the branches of the input files that are asked for (or copied to the
+        output file) instead of every branch of each entry.
+    fastSkim : bool
+        Copy the input branches of the kept events to the output file once each input file
+        is processed, instead of with each event. Branches of input files whose events are
+        all kept are copied without decompressing them. Implies lazyInputReading.
+        The event header is still filled with each event, so changes made to it
+        by the processors are kept. The autoFlush setting does not apply to the
+        output of a fast skim.
+    branchLayouts : list of BranchLayout
+        Basket size, split level and compression of the branches of new products
+    autoFlush : int
+        When the baskets of the event tree are written to the output file, which groups
+        them into clusters. Positive values flush every this many entries and negative
+        values every this many bytes, the default is ROOT's default of 30 MB.
+    parallelOutput : bool
+        Write the events processed on several threads (numThreads > 1) from those threads.
+        Each event in flight is compressed on the thread processing it into its own buffer
+        in memory. The buffers are merged into the output file once they take up about
+        32 MB together, however many threads there are. The output is the same from run
+        to run, but the events are not in the order of the input files like they are by
+        default (False).
+    traceFile : str
+        JSON file to write a trace of the time spent in each processor callback, reading
+        the input and loading conditions to, viewable in Perfetto. Empty (the default)
+        disables tracing.
+    traceSampleFrequency : int
+        Only keep the trace of one out of this many events.
+    traceBufferSize : int
+        Number of spans kept in the trace for each thread, the oldest are overwritten.
     logger : Logger
         configuration for logging system in ldmx-sw
     conditionsGlobalTag : str
@@ -580,6 +665,17 @@ class Process:
         self.skimDefaultIsKeep=True
         self.skimRules=[]
         self.logFrequency=-1
+        self.numThreads=1
+        self.inputPrefetchDepth=0
+        self.ioThreads=0
+        self.lazyInputReading=False
+        self.fastSkim=False
+        self.parallelOutput=False
+        self.branchLayouts=[]
+        self.autoFlush=-30000000
+        self.traceFile=''
+        self.traceSampleFrequency=1
+        self.traceBufferSize=65536
         self.logger = Logger()
         self.compressionSetting=9
         self.histogramFile=''
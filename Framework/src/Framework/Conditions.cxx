@@ -1,12 +1,27 @@
 #include "Framework/Conditions.h"
 
+#include <mutex>
 #include <sstream>
 
+#include "Framework/Performance/Trace.h"
 #include "Framework/PluginFactory.h"
 #include "Framework/Process.h"
 
 namespace framework {
 
+/**
+ * Guard for the conditions cache
+ *
+ * Processors running concurrently on worker threads may request
+ * conditions at the same time, so updates to the cache are serialized.
+ * The providers are called while it is held since they aren't written
+ * to be used from several threads at once. It is recursive because a
+ * provider may request its parent conditions from within getCondition.
+ * This lives here rather than as a member so that Conditions (and
+ * therefore Process) stays copyable.
+ */
+static std::recursive_mutex cache_mutex;
+
 Conditions::Conditions(Process& p) : process_{p} {}
 
 void Conditions::createConditionsObjectProvider(
@@ -45,6 +60,7 @@ void Conditions::onNewRun(ldmx::RunHeader& rh) {
 
 ConditionsIOV Conditions::getConditionIOV(
     const std::string& condition_name) const {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex);
   auto cacheptr = cache_.find(condition_name);
   if (cacheptr == cache_.end())
     return ConditionsIOV();
@@ -54,7 +70,10 @@ ConditionsIOV Conditions::getConditionIOV(
 
 const ConditionsObject* Conditions::getConditionPtr(
     const std::string& condition_name) {
+  // renamed to the condition once we have a name that outlives the call
+  performance::Trace::Span trace("conditions", "getConditionPtr");
   const ldmx::EventHeader& context = *(process_.getEventHeader());
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex);
   auto cacheptr = cache_.find(condition_name);
 
   if (cacheptr == cache_.end()) {
@@ -64,6 +83,7 @@ const ConditionsObject* Conditions::getConditionPtr(
       EXCEPTION_RAISE("ConditionUnavailable",
                       "No provider is available for : " + condition_name);
     }
+    trace.rename(copptr->first.c_str());
 
     std::pair<const ConditionsObject*, ConditionsIOV> cond =
         copptr->second->getCondition(context);
@@ -82,6 +102,7 @@ const ConditionsObject* Conditions::getConditionPtr(
     cache_[condition_name] = ce;
     return ce.obj;
   } else {
+    trace.rename(cacheptr->first.c_str());
     /// if still valid, we return what we have
     if (cacheptr->second.iov.validForEvent(context))
       return cacheptr->second.obj;
@@ -1,15 +1,30 @@
 #include "Framework/Event.h"
 
+#include <atomic>
+
 #include "TBranchElement.h"
 
 namespace framework {
 
+std::size_t Event::reserveHandle() {
+  static std::atomic<std::size_t> num_handles{0};
+  return num_handles++;
+}
+
+std::size_t Event::reserveDerived() {
+  static std::atomic<std::size_t> num_derived{0};
+  return num_derived++;
+}
+
 Event::Event(const std::string& thePassName) : passName_(thePassName) {}
 
 Event::~Event() {
   for (regex_t& reg : regexDropCollections_) {
     regfree(&reg);
   }
+  for (BranchLayout& rule : branchLayouts_) {
+    regfree(&rule.regex_);
+  }
 }
 
 void Event::Print() const {
@@ -28,6 +43,58 @@ void Event::addDrop(const std::string& exp) {
   }
 }
 
+void Event::addBranchLayout(const std::string& exp, const Bus::Layout& layout,
+                            int compression) {
+  BranchLayout rule{};
+  if (regcomp(&rule.regex_, exp.c_str(), REG_EXTENDED | REG_NOSUB)) {
+    EXCEPTION_RAISE("InvalidRegex", "The passed branch layout regex '" + exp +
+                                        "' is not a valid regex.");
+  }
+  rule.layout_ = layout;
+  rule.compression_ = compression;
+  branchLayouts_.push_back(rule);
+}
+
+void Event::layoutClonedBranches(TTree* tree) const {
+  if (branchLayouts_.empty()) return;
+  TObjArray* branches{tree->GetListOfBranches()};
+  for (int i{0}; i < branches->GetEntriesFast(); i++) {
+    auto branch{static_cast<TBranch*>(branches->At(i))};
+    const BranchLayout* match{nullptr};
+    for (const BranchLayout& rule : branchLayouts_) {
+      if (!regexec(&rule.regex_, branch->GetName(), 0, 0, 0)) match = &rule;
+    }
+    if (not match) continue;
+    if (match->compression_ >= 0)
+      branch->SetCompressionSettings(match->compression_);
+    if (match->layout_.basket_size_ > 0) {
+      // each of the branches an object is split into has its own baskets
+      std::vector<TBranch*> split{branch};
+      while (not split.empty()) {
+        TBranch* b{split.back()};
+        split.pop_back();
+        b->SetBasketSize(match->layout_.basket_size_);
+        TObjArray* sub{b->GetListOfBranches()};
+        for (int j{0}; j < sub->GetEntriesFast(); j++)
+          split.push_back(static_cast<TBranch*>(sub->At(j)));
+      }
+    }
+  }
+}
+
+TBranch* Event::attachOutput(const std::string& branchName) {
+  const BranchLayout* match{nullptr};
+  for (const BranchLayout& rule : branchLayouts_) {
+    if (!regexec(&rule.regex_, branchName.c_str(), 0, 0, 0)) match = &rule;
+  }
+  if (not match) return bus_.attach(outputTree_, branchName, true);
+
+  TBranch* branch{bus_.attach(outputTree_, branchName, true, match->layout_)};
+  if (match->compression_ >= 0)
+    branch->SetCompressionSettings(match->compression_);
+  return branch;
+}
+
 /**
  * Construct an actual regex from the pass pattern (and full-string flag)
  *
@@ -99,6 +166,57 @@ bool Event::exists(const std::string& name, const std::string& passName,
     return (matches.size() > 0);
 }
 
+void Event::copyProducts(const Event& other) {
+  invalidateDerived();
+  // the processors may have changed the header of the other event,
+  // it is put on the bus by beforeFill
+  eventHeader_ = other.eventHeader_;
+  for (const std::string& branchName : other.branchesFilled_) {
+    if (branchName == ldmx::EventHeader::BRANCH) continue;
+
+    if (branchesFilled_.find(branchName) != branchesFilled_.end()) {
+      EXCEPTION_RAISE("ProductExists",
+                      "A product on branch '" + branchName +
+                          "' already exists in the event.");
+    }
+    branchesFilled_.insert(branchName);
+
+    if (not bus_.isOnBoard(branchName)) {
+      bus_.board(other.bus_, branchName);
+
+      // find the type name the other event recorded for this product
+      std::string collectionName{branchName.substr(0, branchName.find('_'))};
+      auto tag{std::find_if(other.products_.begin(), other.products_.end(),
+                            [&](const ProductTag& t) {
+                              return t.name() == collectionName and
+                                     t.passname() == passName_;
+                            })};
+      std::string tname{tag != other.products_.end() ? tag->type() : ""};
+
+      if (outputTree_ and not shouldDrop(branchName)) {
+        TBranch* outBranch = attachOutput(branchName);
+        std::string class_name{outBranch->GetClassName()};
+        if (not class_name.empty()) tname = class_name;
+      }
+
+      auto it_known{knownLookups_.find(collectionName)};
+      if (it_known != knownLookups_.end()) knownLookups_.erase(it_known);
+      handleCache_.clear();
+
+      products_.emplace_back(collectionName, passName_, tname);
+    }
+
+    try {
+      bus_.update(other.bus_, branchName);
+    } catch (const std::bad_cast&) {
+      EXCEPTION_RAISE("TypeMismatch",
+                      "Attempting to copy a product on branch '" + branchName +
+                          "' whose type doesn't match the type stored in the "
+                          "collection.");
+    }
+  }
+}
+
 TTree* Event::createTree() {
   outputTree_ = new TTree("LDMX_Events", "LDMX Events");
 
@@ -114,6 +232,9 @@ void Event::setInputTree(TTree* tree) {
   // so reset branch listing before starting
   products_.clear();
   knownLookups_.clear();  // reset caching of empty pass requests
+  handleCache_.clear();   // reset objects resolved by handles
+  lazyBranches_.clear();  // forget branches of the previous tree
+  invalidateDerived();
   bus_.everybodyOff();
 
   // put in EventHeader (only one without pass name)
@@ -150,6 +271,7 @@ void Event::setInputTree(TTree* tree) {
 
 bool Event::nextEvent() {
   eventHeader_ = getObject<ldmx::EventHeader>(ldmx::EventHeader::BRANCH);
+  invalidateDerived();
   return true;
 }
 
@@ -159,12 +281,44 @@ void Event::beforeFill() {
     // Event Header not copied from input and hasn't been added yet, need to put
     // it in
     add(ldmx::EventHeader::BRANCH, eventHeader_);
+  } else if (inputTree_) {
+    // the cloned header branch writes the object read from the input,
+    // which doesn't have the changes the processors made to our copy
+    bus_.update(ldmx::EventHeader::BRANCH, eventHeader_);
+  }
+}
+
+void Event::readClonedBranches() {
+  if (not lazy_ or not inputTree_ or not outputTree_) return;
+  TObjArray* branches = outputTree_->GetListOfBranches();
+  for (int i = 0; i < branches->GetEntriesFast(); i++) {
+    readLazily(branches->At(i)->GetName());
+  }
+}
+
+void Event::readLazily(const std::string& branchName) const {
+  auto it{lazyBranches_.find(branchName)};
+  if (it == lazyBranches_.end()) {
+    // remember branches that aren't on the input tree as well
+    it = lazyBranches_
+             .emplace(branchName,
+                      LazyBranch{inputTree_->GetBranch(branchName.c_str()), -1})
+             .first;
+  }
+  LazyBranch& lazy{it->second};
+  long long int ientry{inputTree_->GetReadEntry()};
+  if (lazy.branch_ and lazy.entry_ != ientry) {
+    lazy.branch_->GetEntry(ientry);
+    lazy.entry_ = ientry;
   }
 }
 
 void Event::Clear() {
   branchesFilled_.clear();  // forget names of branches we filled
   bus_.clear();  // clear the event objects individually but leave them on bus
+  invalidateDerived();
+  // objects resolved by handles have to go through getObject to be read
+  if (lazy_) std::fill(handleCache_.begin(), handleCache_.end(), nullptr);
 }
 
 void Event::onEndOfEvent() {}
@@ -175,6 +329,9 @@ void Event::onEndOfFile() {
   if (inputTree_)
     inputTree_ = nullptr;  // detach old inputTree (owned by EventFile)
   knownLookups_.clear();   // reset caching of empty pass requests
+  handleCache_.clear();    // reset objects resolved by handles
+  lazyBranches_.clear();   // forget branches of the old inputTree
+  invalidateDerived();     // forget objects derived from the buffers
   bus_.everybodyOff();     // delete buffer objects
 }
 
@@ -1,37 +1,64 @@
+#include <algorithm>
 #include <ctime>
 
+#include "TTreeCloner.h"
 #include "TTreeReader.h"
 
 // LDMX
 #include "Framework/Event.h"
 #include "Framework/EventFile.h"
 #include "Framework/Exception/Exception.h"
+#include "Framework/Performance/Trace.h"
 #include "Framework/RunHeader.h"
 
 namespace framework {
 
 EventFile::EventFile(const framework::config::Parameters &params,
                      const std::string &filename, EventFile *parent,
-                     bool isOutputFile, bool isSingleOutput, bool isLoopable)
+                     bool isOutputFile, bool isSingleOutput, bool isLoopable,
+                     bool isMerged, EventFile *merged)
     : fileName_(filename),
       isOutputFile_(isOutputFile),
       isSingleOutput_(isSingleOutput),
       isLoopable_(isLoopable),
+      fastSkim_(params.getParameter<bool>("fastSkim", false)),
+      // a fast skim reads the input branches after processing
+      lazy_(fastSkim_ or params.getParameter<bool>("lazyInputReading", false)),
       parent_(parent) {
   if (isOutputFile_) {
-    // we are writting out so open the file and make sure it is writable
-    file_ = new TFile(fileName_.c_str(), "RECREATE");
-    if (!file_->IsOpen() or !file_->IsWritable()) {
-      EXCEPTION_RAISE("FileError",
-                      "Output file '" + fileName_ + "' is not writable.");
-    }
-
     // set compression settings
     //  Check out the TFile constructor for explanation of how this integer is
     //  built Short Reference: setting = 100*algorithem + level algorithm = 0
     //  ==> use global default
-    file_->SetCompressionSettings(
-        params.getParameter<int>("compressionSetting", 9));
+    int compression{params.getParameter<int>("compressionSetting", 9)};
+
+    if (merged) {
+      // we write into a buffer that is merged into the other's file
+      merger_ = merged->merger_;
+    } else if (isMerged) {
+      merger_ = std::make_shared<BufferMerger>(fileName_.c_str(), "RECREATE",
+                                               compression);
+    }
+
+    if (merger_) {
+      merged_file_ = merger_->GetFile();
+      file_ = merged_file_.get();
+    } else {
+      // we are writting out so open the file and make sure it is writable
+      file_ = new TFile(fileName_.c_str(), "RECREATE");
+      if (!file_->IsOpen() or !file_->IsWritable()) {
+        EXCEPTION_RAISE("FileError",
+                        "Output file '" + fileName_ + "' is not writable.");
+      }
+    }
+
+    file_->SetCompressionSettings(compression);
+
+    // how the event tree is written
+    autoFlush_ = params.getParameter<int>("autoFlush", -30000000);
+    branchLayouts_ =
+        params.getParameter<std::vector<framework::config::Parameters>>(
+            "branchLayouts", {});
 
     if (parent_) {
       // output file when there are input files
@@ -85,9 +112,14 @@ EventFile::EventFile(const framework::config::Parameters &params,
       return;
     }
     entries_ = tree_->GetEntriesFast();
+
+    // read (and decompress) entries ahead of the one being processed
+    int prefetch_depth{params.getParameter<int>("inputPrefetchDepth", 0)};
+    if (prefetch_depth > 0) setupPrefetch(prefetch_depth);
   }
 
-  importRunHeaders();
+  // the run tree of a shared output is written by the file it is merged into
+  if (not merged) importRunHeaders();
 }
 
 EventFile::EventFile(const framework::config::Parameters &params,
@@ -100,21 +132,52 @@ EventFile::EventFile(const framework::config::Parameters &params,
 
 EventFile::EventFile(const framework::config::Parameters &params,
                      const std::string &filename, EventFile *parent,
-                     bool isSingleOutput)
-    : EventFile(params, filename, parent, true, isSingleOutput, false) {}
+                     bool isSingleOutput, bool isMerged)
+    : EventFile(params, filename, parent, true, isSingleOutput, false,
+                isMerged) {}
+
+EventFile::EventFile(const framework::config::Parameters &params,
+                     EventFile *merged, EventFile *parent)
+    : EventFile(params, merged->fileName_, parent, true, false, false, false,
+                merged) {}
 
 EventFile::~EventFile() {
   // Before an output file, the Event tree needs to be written.
   if (isOutputFile_) {
     // make sure we are in output file before writing
     file_->cd();
-    tree_->Write();
+    if (merged_file_) {
+      // hand whatever is left (including the run tree) to the merger,
+      // which writes the file once all of its buffers are gone
+      merged_file_->Write();
+    } else {
+      tree_->Write();
+    }
   }
 
   // Close the file
   file_->Close();
 }
 
+void EventFile::setupPrefetch(int depth) {
+  /**
+   * The TTreeCache is sized in bytes, so we translate the requested number
+   * of entries using the average compressed size of an entry. The branches
+   * held in the cache are learned from the ones read in the first few
+   * entries so branches that are never requested are not read ahead.
+   */
+  Long64_t bytes_per_entry{entries_ > 0 ? tree_->GetZipBytes() / entries_
+                                        : 0};
+  Long64_t cache_size{std::max(bytes_per_entry * depth, MIN_PREFETCH_BYTES)};
+  tree_->SetCacheSize(cache_size);
+  tree_->SetCacheLearnEntries(PREFETCH_LEARN_ENTRIES);
+  /**
+   * Unzip the baskets in the cache in the background, this uses the
+   * ROOT implicit multi-threading pool if it has been enabled (ioThreads).
+   */
+  tree_->SetParallelUnzip(true);
+}
+
 bool EventFile::isCorrupted() const {
   if (isOutputFile_) return file_->IsZombie();
   return (!tree_ or file_->IsZombie());
@@ -180,6 +243,7 @@ void EventFile::addDrop(const std::string &rule) {
 }
 
 bool EventFile::nextEvent(bool storeCurrentEvent) {
+  performance::Trace::Span trace("io", "EventFile::nextEvent");
   if (ientry_ < 0) {
     // first entry of this file
     if (parent_) {
@@ -191,22 +255,7 @@ bool EventFile::nextEvent(bool storeCurrentEvent) {
       // Only clone parent tree if either
       //  1) There is no tree setup yet (first input file)
       //  2) This is not single output (new input file --> new output file)
-      if (!tree_ or !isSingleOutput_) {
-        // clones parent_->tree_ to our tree_ keeping drop/keep rules in mind
-        // clone tree (only copies over branches that are active on input tree)
-
-        file_->cd();  // go into output file
-
-        for (auto const &rulePair : preCloneRules_)
-          parent_->tree_->SetBranchStatus(rulePair.first.c_str(),
-                                          rulePair.second);
-
-        tree_ = parent_->tree_->CloneTree(0);
-
-        // reactivate any drop branches (drop) on input tree
-        for (auto const &rule : reactivateRules_)
-          parent_->tree_->SetBranchStatus(rule.c_str(), 1);
-      }
+      if (!tree_ or !isSingleOutput_) cloneParentTree();
       event_->setInputTree(parent_->tree_);
       event_->setOutputTree(tree_);
     }  // we have a parent file
@@ -214,9 +263,20 @@ bool EventFile::nextEvent(bool storeCurrentEvent) {
     // later than first entry of file
     if (isOutputFile_) {
       event_->beforeFill();
-      if (storeCurrentEvent)  // we should store before moving on
-        tree_->Fill();        // fill the clones...
-    }                         // we are an output file
+      if (storeCurrentEvent and fastSkim_ and parent_) {
+        // only the event header and the branches made in this pass are
+        // filled now, the cloned ones are copied at the end of the input file;
+        // filling the branches by themselves skips the auto flush
+        // of TTree::Fill, so baskets are only written once full
+        TObjArray *branches{tree_->GetListOfBranches()};
+        for (int i{n_cloned_}; i < branches->GetEntriesFast(); i++)
+          static_cast<TBranch *>(branches->At(i))->Fill();
+        kept_.push_back(ientry_);
+      } else if (storeCurrentEvent) {  // we should store before moving on
+        event_->readClonedBranches();
+        tree_->Fill();  // fill the clones...
+      }
+    }  // we are an output file
 
     // the event bus may not be defined
     //  for this file if we are input file and
@@ -253,7 +313,7 @@ bool EventFile::nextEvent(bool storeCurrentEvent) {
         return false;
     }
     ientry_++;
-    tree_->GetEntry(ientry_);
+    loadEntry();
   }
 
   // if we have an event_
@@ -261,14 +321,94 @@ bool EventFile::nextEvent(bool storeCurrentEvent) {
   return event_ ? event_->nextEvent() : true;
 }
 
+void EventFile::cloneParentTree() {
+  // clones parent_->tree_ to our tree_ keeping drop/keep rules in mind
+  // clone tree (only copies over branches that are active on input tree)
+
+  file_->cd();  // go into output file
+
+  for (auto const &rulePair : preCloneRules_)
+    parent_->tree_->SetBranchStatus(rulePair.first.c_str(), rulePair.second);
+
+  tree_ = parent_->tree_->CloneTree(0);
+  TObjArray *branches{tree_->GetListOfBranches()};
+  n_cloned_ = branches->GetEntriesFast();
+  if (fastSkim_) {
+    // the processors may change the event header, so it is filled with
+    // the events like the branches of this pass instead of being copied
+    TObject *header{branches->FindObject(ldmx::EventHeader::BRANCH.c_str())};
+    if (header) {
+      branches->Remove(header);
+      branches->Compress();
+      branches->Add(header);
+      n_cloned_--;
+    }
+  }
+  // the clone would otherwise keep the clusters and baskets of the parent
+  tree_->SetAutoFlush(autoFlush_);
+  event_->layoutClonedBranches(tree_);
+
+  // reactivate any drop branches (drop) on input tree
+  for (auto const &rule : reactivateRules_)
+    parent_->tree_->SetBranchStatus(rule.c_str(), 1);
+}
+
+void EventFile::setupMergedOutput() {
+  if (not merged_file_ or not parent_ or not parent_->tree_) {
+    EXCEPTION_RAISE("MisCall",
+                    "Only a merged output file with a parent can clone the "
+                    "tree of its parent ahead of time.");
+  }
+  cloneParentTree();
+  event_->setOutputTree(tree_);
+}
+
+void EventFile::writeEvent(bool storeCurrentEvent) {
+  performance::Trace::Span trace("io", "EventFile::writeEvent");
+  event_->beforeFill();
+  if (storeCurrentEvent) {
+    event_->readClonedBranches();
+    tree_->Fill();
+    entries_++;
+  }
+}
+
+void EventFile::mergeIfFull(std::size_t n_buffers) {
+  if (not merged_file_ or
+      merged_file_->GetEND() < MERGE_BYTES / Long64_t(n_buffers))
+    return;
+  performance::Trace::Span trace("io", "EventFile::mergeIfFull");
+  // the buffer is emptied once it is handed over
+  merged_file_->Write();
+}
+
+void EventFile::loadEntry() {
+  if (lazy_) {
+    // the event reads the branches it needs
+    tree_->LoadTree(ientry_);
+  } else {
+    tree_->GetEntry(ientry_);
+  }
+}
+
 void EventFile::setupEvent(Event *evt) {
   event_ = evt;
+  event_->setLazyReading(lazy_);
   if (isOutputFile_) {
     // we are an output file
+    for (const auto &rule : branchLayouts_) {
+      Bus::Layout layout;
+      layout.basket_size_ = rule.getParameter<int>("basketSize");
+      layout.split_level_ = rule.getParameter<int>("splitLevel");
+      event_->addBranchLayout(rule.getParameter<std::string>("regex"), layout,
+                              rule.getParameter<int>("compression"));
+    }
+
     if (!tree_ && !parent_) {
       // we don't have a tree and we don't have a parent
       //  ==> *Production Mode* create a new tree
       tree_ = event_->createTree();
+      tree_->SetAutoFlush(autoFlush_);
       ientry_ = 0;
       entries_ = 0;
     }
@@ -295,6 +435,81 @@ int EventFile::skipToEvent(int offset) {
   return ientry_;
 }
 
+bool EventFile::seekEvent(Long64_t ientry) {
+  performance::Trace::Span trace("io", "EventFile::seekEvent");
+  if (isOutputFile_ or parent_) {
+    EXCEPTION_RAISE("MisCall",
+                    "Cannot seek to a specific entry of an output file or a "
+                    "file with a parent.");
+  }
+
+  if (ientry < 0 or ientry >= entries_) return false;
+
+  if (event_) {
+    event_->Clear();
+    event_->onEndOfEvent();
+  }
+
+  ientry_ = ientry;
+  loadEntry();
+
+  return event_ ? event_->nextEvent() : true;
+}
+
+void EventFile::copySkimmedEntries() {
+  if (not fastSkim_ or not parent_ or kept_.empty()) return;
+  performance::Trace::Span trace("io", "EventFile::copySkimmedEntries");
+  file_->cd();
+
+  if (Long64_t(kept_.size()) == parent_->entries_) {
+    // every entry is kept, so the baskets of the cloned branches are copied
+    // over without decompressing them; the branches already filled with
+    // the events are taken off the tree while copying so they are left alone
+    TObjArray *branches{tree_->GetListOfBranches()};
+    std::vector<TObject *> filled;
+    while (branches->GetEntriesFast() > n_cloned_)
+      filled.push_back(branches->RemoveLast());
+    TTreeCloner cloner(
+        parent_->tree_, tree_, "",
+        TTreeCloner::kIgnoreMissingTopLevel | TTreeCloner::kNoWarnings);
+    bool copied{false};
+    if (cloner.IsValid()) {
+      // neither the copied baskets nor TBranch::Fill advance the entries
+      // of the tree, so count them before the cluster ranges of the
+      // parent are imported like TTree::CopyEntries does
+      tree_->SetEntries(tree_->GetEntries() + parent_->entries_);
+      copied = cloner.Exec();
+    }
+    for (auto branch{filled.rbegin()}; branch != filled.rend(); branch++)
+      branches->Add(*branch);
+    if (cloner.IsValid() and not copied) {
+      EXCEPTION_RAISE("FileError", "Unable to copy the baskets of '" +
+                                       parent_->fileName_ + "' into '" +
+                                       fileName_ + "'.");
+    }
+    if (copied) {
+      kept_.clear();
+      return;
+    }
+  }
+
+  // only read the branches that are copied
+  for (auto const &rulePair : preCloneRules_)
+    parent_->tree_->SetBranchStatus(rulePair.first.c_str(), rulePair.second);
+
+  TObjArray *branches{tree_->GetListOfBranches()};
+  for (Long64_t ientry : kept_) {
+    parent_->tree_->GetEntry(ientry);
+    for (int i{0}; i < n_cloned_; i++)
+      static_cast<TBranch *>(branches->At(i))->Fill();
+  }
+  tree_->SetEntries(tree_->GetEntries() + kept_.size());
+
+  for (auto const &rule : reactivateRules_)
+    parent_->tree_->SetBranchStatus(rule.c_str(), 1);
+  kept_.clear();
+}
+
 void EventFile::updateParent(EventFile *parent) {
   parent_ = parent;
 
@@ -310,8 +525,9 @@ void EventFile::updateParent(EventFile *parent) {
   for (auto const &rulePair : preCloneRules_)
     parent_->tree_->SetBranchStatus(rulePair.first.c_str(), rulePair.second);
 
-  // Copy over addresses from the new parent
-  parent_->tree_->CopyAddresses(tree_);
+  // Copy over addresses from the new parent, a merged output may not
+  // have cloned a tree if its events were written by other files
+  if (tree_) parent_->tree_->CopyAddresses(tree_);
 
   // and reactivate any dropping rules
   for (auto const &rule : reactivateRules_)
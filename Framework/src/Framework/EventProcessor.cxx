@@ -18,6 +18,11 @@ Conditions &EventProcessor::getConditions() const {
   return process_.getConditions();
 }
 
+ConditionsIOV EventProcessor::getConditionIOV(
+    const std::string &condition_name) const {
+  return getConditions().getConditionIOV(condition_name);
+}
+
 const ldmx::EventHeader &EventProcessor::getEventHeader() const {
   return *(process_.getEventHeader());
 }
@@ -41,6 +46,12 @@ int EventProcessor::getLogFrequency() const {
 
 int EventProcessor::getRunNumber() const { return process_.getRunNumber(); }
 
+const std::string &EventProcessor::getPassName() const {
+  return process_.getPassName();
+}
+
+int EventProcessor::getEventLimit() const { return process_.getEventLimit(); }
+
 void EventProcessor::declare(const std::string &classname, int classtype,
                              EventProcessorMaker *maker) {
   PluginFactory::getInstance().registerEventProcessor(classname, classtype,
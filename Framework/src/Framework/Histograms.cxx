@@ -43,18 +43,68 @@ HistogramPool& HistogramPool::getInstance() {
   return instance;
 }
 
-TH1* HistogramPool::get(const std::string& name) {
-  auto histo = histograms_.find(name);
-  if (histo == histograms_.end()) {
+thread_local int HistogramPool::current_shard_{-1};
+
+std::size_t HistogramPool::insert(const std::string& name, TH1* hist) {
+  auto histo = indices_.find(name);
+  if (histo != indices_.end()) {
+    histograms_[histo->second] = hist;
+    for (auto& shard : shards_) {
+      delete shard[histo->second];
+      shard[histo->second] = makeShard(hist);
+    }
+    return histo->second;
+  }
+
+  indices_[name] = histograms_.size();
+  histograms_.push_back(hist);
+  // histograms created after the shards were made (e.g. in onNewRun)
+  // need their own copies in each shard as well
+  for (auto& shard : shards_) shard.push_back(makeShard(hist));
+  return histograms_.size() - 1;
+}
+
+std::size_t HistogramPool::index(const std::string& name) const {
+  auto histo = indices_.find(name);
+  if (histo == indices_.end()) {
     EXCEPTION_RAISE("InvalidArg", "Histogram " + name + " not found in pool.");
   }
 
-  return histograms_[name];
+  return histo->second;
+}
+
+void HistogramPool::makeShards(int n_shards) {
+  if (not shards_.empty()) return;
+
+  shards_.resize(n_shards);
+  for (auto& shard : shards_) {
+    for (TH1* hist : histograms_) shard.push_back(makeShard(hist));
+  }
+}
+
+TH1* HistogramPool::makeShard(TH1* hist) {
+  auto copy = dynamic_cast<TH1*>(hist->Clone());
+  // shards are only filled and merged, they are not written
+  copy->SetDirectory(nullptr);
+  copy->Reset();
+  return copy;
+}
+
+void HistogramPool::mergeShards() {
+  for (auto& shard : shards_) {
+    for (std::size_t i{0}; i < shard.size(); i++) {
+      histograms_[i]->Add(shard[i]);
+      delete shard[i];
+    }
+  }
+  shards_.clear();
 }
 
-void HistogramHelper::create(const std::string& name, const std::string& xLabel,
-                             const double& bins, const double& xmin,
-                             const double& xmax) {
+HistogramHandle<TH1F> HistogramHelper::create(const std::string& name,
+                                              const std::string& xLabel,
+                                              const double& bins,
+                                              const double& xmin,
+                                              const double& xmax) {
   std::string fullName = name_ + "_" + name;
 
   // Create a histogram of type T
@@ -68,11 +118,13 @@ void HistogramHelper::create(const std::string& name, const std::string& xLabel,
   hist->GetXaxis()->CenterTitle();
 
   // Insert it into the pool of histograms for later use
-  HistogramPool::getInstance().insert(fullName, hist);
+  return HistogramHandle<TH1F>(
+      HistogramPool::getInstance().insert(fullName, hist), &theWeight_);
 }
 
-void HistogramHelper::create(const std::string& name, const std::string& xLabel,
-                             const std::vector<double>& bins) {
+HistogramHandle<TH1F> HistogramHelper::create(const std::string& name,
+                                              const std::string& xLabel,
+                                              const std::vector<double>& bins) {
   std::string fullName = name_ + "_" + name;
 
   // copy bin edges into a C98 form acceptable by ROOT
@@ -93,14 +145,19 @@ void HistogramHelper::create(const std::string& name, const std::string& xLabel,
   hist->GetXaxis()->CenterTitle();
 
   // Insert it into the pool of histograms for later use
-  HistogramPool::getInstance().insert(fullName, hist);
+  return HistogramHandle<TH1F>(
+      HistogramPool::getInstance().insert(fullName, hist), &theWeight_);
 }
 
-void HistogramHelper::create(const std::string& name, const std::string& xLabel,
-                             const double& xbins, const double& xmin,
-                             const double& xmax, const std::string& yLabel,
-                             const double& ybins, const double& ymin,
-                             const double& ymax) {
+HistogramHandle<TH2F> HistogramHelper::create(const std::string& name,
+                                              const std::string& xLabel,
+                                              const double& xbins,
+                                              const double& xmin,
+                                              const double& xmax,
+                                              const std::string& yLabel,
+                                              const double& ybins,
+                                              const double& ymin,
+                                              const double& ymax) {
   std::string fullName = name_ + "_" + name;
 
   // Create a histogram of type T
@@ -119,13 +176,14 @@ void HistogramHelper::create(const std::string& name, const std::string& xLabel,
   hist->GetYaxis()->CenterTitle();
 
   // Insert it into the pool of histograms for later use
-  HistogramPool::getInstance().insert(fullName, hist);
+  return HistogramHandle<TH2F>(
+      HistogramPool::getInstance().insert(fullName, hist), &theWeight_);
 }
 
-void HistogramHelper::create(const std::string& name, const std::string& xLabel,
-                             const std::vector<double>& xbins,
-                             const std::string& yLabel,
-                             const std::vector<double>& ybins) {
+HistogramHandle<TH2F> HistogramHelper::create(
+    const std::string& name, const std::string& xLabel,
+    const std::vector<double>& xbins, const std::string& yLabel,
+    const std::vector<double>& ybins) {
   std::string fullName = name_ + "_" + name;
 
   // copy bin edges into a C98 form acceptable by ROOT
@@ -157,6 +215,7 @@ void HistogramHelper::create(const std::string& name, const std::string& xLabel,
   hist->GetYaxis()->CenterTitle();
 
   // Insert it into the pool of histograms for later use
-  HistogramPool::getInstance().insert(fullName, hist);
+  return HistogramHandle<TH2F>(
+      HistogramPool::getInstance().insert(fullName, hist), &theWeight_);
 }
 }  // namespace framework
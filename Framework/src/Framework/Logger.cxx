@@ -2,13 +2,21 @@
 
 // STL
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <ostream>
+#include <type_traits>
 
 // Boost
 #include <boost/core/null_deleter.hpp>  //to avoid deleting std::cout
+#include <boost/log/attributes/function.hpp>  //for the event number
+#include <boost/log/sinks/block_on_overflow.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
+#include <boost/log/sinks/drop_on_overflow.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>  //for loading commont attributes
 
+#include "Framework/Exception/Exception.h"
+
 namespace framework {
 
 namespace logging {
@@ -72,11 +80,50 @@ class Filter {
   }
 };
 
-void open(const framework::config::Parameters& p) {
-  // some helpful types
-  typedef sinks::text_ostream_backend ourSinkBack_t;
-  typedef sinks::synchronous_sink<ourSinkBack_t> ourSinkFront_t;
+/**
+ * Maximum number of messages waiting to be written by an asynchronous sink
+ */
+static const std::size_t QUEUE_SIZE{8192};
+
+// some helpful types
+typedef sinks::text_ostream_backend ourSinkBack_t;
+typedef sinks::synchronous_sink<ourSinkBack_t> ourSyncSink_t;
+template <typename OverflowStrategy>
+using ourAsyncSink_t = sinks::asynchronous_sink<
+    ourSinkBack_t, sinks::bounded_fifo_queue<QUEUE_SIZE, OverflowStrategy>>;
 
+/**
+ * Stop the asynchronous sinks, writing out what is left on their queues
+ */
+static std::vector<std::function<void()>> stop_sinks;
+
+/**
+ * Attach a sink to a backend and add it to the logging core
+ *
+ * @tparam Sink type of sink frontend
+ * @param[in] back backend the sink writes to
+ * @param[in] filter filter deciding which messages are written
+ */
+template <typename Sink>
+void addSink(boost::shared_ptr<ourSinkBack_t> back, const Filter& filter) {
+  boost::shared_ptr<Sink> sink = boost::make_shared<Sink>(back);
+  // this is where the logging level is set
+  sink->set_filter(filter);
+  // need to wrap formatter in lambda to enforce singleton formatter
+  sink->set_formatter(
+      [](const log::record_view& view, log::formatting_ostream& os) {
+        Formatter::get()(view, os);
+      });
+  log::core::get()->add_sink(sink);
+  if constexpr (not std::is_same_v<Sink, ourSyncSink_t>) {
+    stop_sinks.push_back([sink]() {
+      sink->stop();
+      sink->flush();
+    });
+  }
+}
+
+void open(const framework::config::Parameters& p) {
   level fileLevel{convertLevel(p.getParameter<int>("fileLevel", 0))};
   std::string filePath{p.getParameter<std::string>("filePath", "")};
 
@@ -90,15 +137,32 @@ void open(const framework::config::Parameters& p) {
         convertLevel(logRule.getParameter<int>("level"));
   }
 
+  bool asynchronous{p.getParameter<bool>("asynchronous", true)};
+  std::string overflow{p.getParameter<std::string>("overflow", "block")};
+  if (overflow != "block" and overflow != "drop") {
+    EXCEPTION_RAISE("LoggerConfig", "Unknown overflow policy '" + overflow +
+                                        "', it should be 'block' or 'drop'.");
+  }
+  auto add_sink = [&](boost::shared_ptr<ourSinkBack_t> back, level lvl) {
+    Filter filter(lvl, custom_levels);
+    if (not asynchronous) {
+      addSink<ourSyncSink_t>(back, filter);
+    } else if (overflow == "drop") {
+      addSink<ourAsyncSink_t<sinks::drop_on_overflow>>(back, filter);
+    } else {
+      addSink<ourAsyncSink_t<sinks::block_on_overflow>>(back, filter);
+    }
+  };
+
   // allow our logs to access common attributes, the ones availabe are
   //  "LineID"    : counter increments for each record being made (terminal or
   //  file) "TimeStamp" : time the log message was created "ProcessID" : machine
   //  ID for the process that is running "ThreadID"  : machine ID for the thread
   //  the message is in
   log::add_common_attributes();
-
-  // get the core logging service
-  boost::shared_ptr<log::core> core = log::core::get();
+  // the event number of the thread making the message
+  log::core::get()->add_global_attribute(
+      "EventNumber", log::attributes::make_function(&Formatter::number));
 
   // file sink is optional
   //  don't even make it if no filePath is provided
@@ -106,17 +170,7 @@ void open(const framework::config::Parameters& p) {
     boost::shared_ptr<ourSinkBack_t> fileBack =
         boost::make_shared<ourSinkBack_t>();
     fileBack->add_stream(boost::make_shared<std::ofstream>(filePath));
-
-    boost::shared_ptr<ourSinkFront_t> fileSink =
-        boost::make_shared<ourSinkFront_t>(fileBack);
-
-    // this is where the logging level is set
-    fileSink->set_filter(Filter(fileLevel, custom_levels));
-    fileSink->set_formatter(
-        [](const log::record_view& view, log::formatting_ostream& os) {
-          Formatter::get()(view, os);
-        });
-    core->add_sink(fileSink);
+    add_sink(fileBack, fileLevel);
   }  // file set to pass something
 
   // terminal sink is always created
@@ -128,18 +182,7 @@ void open(const framework::config::Parameters& p) {
       ));
   // flushes message to screen **after each message**
   termBack->auto_flush(true);
-
-  boost::shared_ptr<ourSinkFront_t> termSink =
-      boost::make_shared<ourSinkFront_t>(termBack);
-
-  // translate integer level to enum
-  termSink->set_filter(Filter(termLevel, custom_levels));
-  // need to wrap formatter in lambda to enforce singleton formatter
-  termSink->set_formatter(
-      [](const log::record_view& view, log::formatting_ostream& os) {
-        Formatter::get()(view, os);
-      });
-  core->add_sink(termSink);
+  add_sink(termBack, termLevel);
 
   return;
 
@@ -148,21 +191,28 @@ void open(const framework::config::Parameters& p) {
 void close() {
   // prevents crashes on some systems when logging to a file
   log::core::get()->remove_all_sinks();
+  // write out the messages still waiting on the queues
+  for (auto& stop : stop_sinks) stop();
+  stop_sinks.clear();
 
   return;
 }
 
+thread_local int Formatter::event_number_{0};
+
 Formatter& Formatter::get() {
   static Formatter the_formatter;
   return the_formatter;
 }
 
-void Formatter::set(int n) { Formatter::get().event_number_ = n; }
+void Formatter::set(int n) { Formatter::event_number_ = n; }
+
+int Formatter::number() { return Formatter::event_number_; }
 
 void Formatter::operator()(const log::record_view& view,
                            log::formatting_ostream& os) {
   os << "[ " << log::extract<std::string>("Channel", view) << " ] "
-     << event_number_ << " ";
+     << safe_extract<int>(view["EventNumber"]) << " ";
   /**
    * We de-reference the value out of the log into our own type
    * so that we can compare and convert it into a string.
@@ -0,0 +1,140 @@
+#include "Framework/Performance/Trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include "Framework/Exception/Exception.h"
+
+namespace framework::performance {
+
+bool Trace::enabled_{false};
+thread_local bool Trace::sampled_{true};
+thread_local std::size_t Trace::lane_{std::size_t(-1)};
+thread_local int Trace::event_{-1};
+
+Trace::EventScope::EventScope(long int i_event, int event_number) {
+  sampled_ = (i_event % Trace::get().sample_frequency_ == 0);
+  event_ = event_number;
+  if (active()) begin_ = clock::now();
+}
+
+Trace::EventScope::~EventScope() {
+  if (begin_ != clock::time_point())
+    Trace::get().record("event", "event", begin_);
+  sampled_ = true;
+  event_ = -1;
+}
+
+Trace& Trace::get() {
+  static Trace instance;
+  return instance;
+}
+
+void Trace::open(std::size_t n_lanes, std::size_t buffer_size,
+                 int sample_frequency) {
+  if (buffer_size == 0 or sample_frequency < 1) {
+    EXCEPTION_RAISE("TraceConfig",
+                    "The trace needs room for at least one span per thread "
+                    "and a sample frequency of at least one.");
+  }
+  sample_frequency_ = sample_frequency;
+  lanes_.clear();
+  lanes_.resize(n_lanes);
+  for (Lane& lane : lanes_) lane.records_.resize(buffer_size);
+  lane_ = 0;
+  start_ = clock::now();
+  enabled_ = true;
+}
+
+bool Trace::close(const std::string& file_name) {
+  if (not enabled_) return true;
+  enabled_ = false;
+  std::ofstream out(file_name);
+  if (not out) return false;
+  write(out);
+  return true;
+}
+
+const char* Trace::name(const std::string& name) {
+  std::lock_guard<std::mutex> lock(names_mutex_);
+  return names_.insert(name).first->c_str();
+}
+
+const char* Trace::category(Callback cb) {
+  // literals matching to_name so no string is built per span
+  static const char* names[] = {"onProcessStart", "onProcessEnd",
+                                "onFileOpen",     "onFileClose",
+                                "beforeNewRun",   "onNewRun",
+                                "process"};
+  return names[to_index(cb)];
+}
+
+void Trace::record(const char* category, const char* name,
+                   clock::time_point begin) {
+  auto end{clock::now()};
+  if (lane_ >= lanes_.size()) return;
+  Lane& lane{lanes_[lane_]};
+  Record& r{lane.records_[lane.n_recorded_ % lane.records_.size()]};
+  r.category_ = category;
+  r.name_ = name;
+  r.begin_ =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(begin - start_)
+          .count();
+  r.duration_ =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+          .count();
+  r.event_ = event_;
+  lane.n_recorded_++;
+}
+
+/**
+ * Write a string as a JSON string literal
+ */
+static void writeJSON(std::ostream& out, const char* str) {
+  out << '"';
+  for (const char* c{str}; c and *c; c++) {
+    if (*c == '"' or *c == '\\')
+      out << '\\' << *c;
+    else if (static_cast<unsigned char>(*c) < 0x20)
+      out << ' ';
+    else
+      out << *c;
+  }
+  out << '"';
+}
+
+void Trace::write(std::ostream& out) const {
+  // times in the chrome format are in microseconds
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+         "\"args\":{\"name\":\"fire\"}}";
+  for (std::size_t i_lane{0}; i_lane < lanes_.size(); i_lane++) {
+    const Lane& lane{lanes_[i_lane]};
+    std::string thread_name{i_lane == 0 ? "main"
+                                        : "worker " + std::to_string(i_lane)};
+    out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+        << i_lane << ",\"args\":{\"name\":\"" << thread_name
+        << "\",\"recorded\":" << lane.n_recorded_ << "}}";
+    // oldest span still in the ring first
+    std::size_t size{lane.records_.size()},
+        n{std::min(lane.n_recorded_, size)},
+        first{lane.n_recorded_ > size ? lane.n_recorded_ % size : 0};
+    for (std::size_t i{0}; i < n; i++) {
+      const Record& r{lane.records_[(first + i) % size]};
+      out << ",\n{\"name\":";
+      writeJSON(out, r.name_);
+      out << ",\"cat\":";
+      writeJSON(out, r.category_);
+      out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << i_lane
+          << ",\"ts\":" << r.begin_ / 1000.
+          << ",\"dur\":" << r.duration_ / 1000.;
+      if (r.event_ >= 0) out << ",\"args\":{\"event\":" << r.event_ << "}";
+      out << "}";
+    }
+  }
+  out << "\n]}\n";
+}
+
+}  // namespace framework::performance
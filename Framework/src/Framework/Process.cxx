@@ -5,12 +5,18 @@
 
 #include "Framework/Process.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 #include "Framework/Event.h"
 #include "Framework/EventFile.h"
 #include "Framework/EventProcessor.h"
 #include "Framework/Exception/Exception.h"
+#include "Framework/Histograms.h"
 #include "Framework/Logger.h"
 #include "Framework/NtupleManager.h"
 #include "Framework/PluginFactory.h"
@@ -20,6 +26,143 @@
 
 namespace framework {
 
+namespace {
+
+/**
+ * Context of the event being processed by the calling thread
+ *
+ * When several events are processed at once, the event header and the
+ * storage controller that processors should see depend on which event
+ * the calling thread is working on. These are left null while processing
+ * on a single thread so that the members of Process are used.
+ */
+thread_local const ldmx::EventHeader *current_event_header{nullptr};
+thread_local StorageControl *current_storage_controller{nullptr};
+
+/**
+ * Number of events each thread may have in flight at once
+ *
+ * Giving each thread a few events per window lets the threads balance
+ * events that take different amounts of time before the window is
+ * written out in order.
+ */
+constexpr std::size_t events_per_thread{4};
+
+/**
+ * An event in flight while processing several events at once
+ */
+struct EventSlot {
+  EventSlot(const std::string &pass, const StorageControl &controller)
+      : event{pass}, storage{controller} {}
+  /// event bus for this slot
+  Event event;
+  /// handle on the input file this slot reads its entries through
+  std::unique_ptr<EventFile> input;
+  /// buffer this slot writes its events into with parallel output
+  std::unique_ptr<EventFile> output;
+  /// storage hints given by the processors for this event
+  StorageControl storage;
+  /// was an entry of the input file loaded into the event?
+  bool loaded{false};
+  /// was the event fully processed?
+  bool completed{false};
+};
+
+/**
+ * Keeps processors that are not thread safe running on one event at a
+ * time and in the order the events were read
+ *
+ * Each processor has a turn which is the index (within the current
+ * window) of the next event allowed to be passed to it.
+ */
+class Turnstile {
+ public:
+  Turnstile(std::size_t n_processors) : turns_(n_processors, 0) {}
+
+  /// let the first event of a new window through first
+  void reset() {
+    std::fill(turns_.begin(), turns_.end(), 0);
+    stopped_ = false;
+  }
+
+  /**
+   * Wait until it is the turn of the input event for the input processor
+   * @return false if processing was stopped while waiting
+   */
+  bool wait(std::size_t i_proc, std::size_t i_event) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    turn_changed_.wait(
+        lock, [&]() { return stopped_ or turns_[i_proc] == i_event; });
+    return not stopped_;
+  }
+
+  /// give the turn for the input processor to the next event
+  void pass(std::size_t i_proc) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      turns_[i_proc]++;
+    }
+    turn_changed_.notify_all();
+  }
+
+  /// stop all waiting, used when a processor throws an exception
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    turn_changed_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable turn_changed_;
+  std::vector<std::size_t> turns_;
+  bool stopped_{false};
+};
+
+/**
+ * Call task(i) for each i in [0,n) using n_threads threads
+ *
+ * The first exception thrown by a task is re-thrown after all
+ * of the threads have finished.
+ *
+ * @param[in] n_threads number of threads to use
+ * @param[in] n number of tasks
+ * @param[in] task function to call with the index of each task
+ * @param[in] on_error function to call when a task throws
+ */
+void forEachConcurrently(
+    int n_threads, std::size_t n, const std::function<void(std::size_t)> &task,
+    const std::function<void()> &on_error = []() {}) {
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  std::vector<std::thread> threads;
+  for (int i_thread{0}; i_thread < n_threads; i_thread++) {
+    threads.emplace_back([&, i_thread]() {
+      // histograms filled by this thread go into its own shard
+      HistogramPool::useShard(i_thread);
+      // lane zero of the trace is left to the thread driving the process
+      performance::Trace::useLane(i_thread + 1);
+      try {
+        for (std::size_t i{next++}; i < n; i = next++) task(i);
+      } catch (...) {
+        {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (not error) error = std::current_exception();
+        }
+        next = n;
+        on_error();
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  if (error) std::rethrow_exception(error);
+}
+
+}  // namespace
+
 Process::Process(const framework::config::Parameters &configuration)
     : conditions_{*this} {
   config_ = configuration;
@@ -35,6 +178,17 @@ Process::Process(const framework::config::Parameters &configuration)
       configuration.getParameter<int>("compressionSetting", 9);
   skipCorruptedInputFiles_ =
       configuration.getParameter<bool>("skipCorruptedInputFiles", false);
+  numThreads_ = configuration.getParameter<int>("numThreads", 1);
+  parallelOutput_ = configuration.getParameter<bool>("parallelOutput", false);
+  int ioThreads{configuration.getParameter<int>("ioThreads", 0)};
+  if (ioThreads > 0) {
+    // let ROOT decompress and deserialize branches on a pool of threads
+    ROOT::EnableImplicitMT(ioThreads);
+  }
+  if (numThreads_ > 1) {
+    // several threads will be reading from the input files at once
+    ROOT::EnableThreadSafety();
+  }
 
   inputFiles_ =
       configuration.getParameter<std::vector<std::string>>("inputFiles", {});
@@ -120,6 +274,20 @@ Process::Process(const framework::config::Parameters &configuration)
     }
     performance_ =
         new performance::Tracker(makeHistoDirectory("performance"), names);
+    if (numThreads_ > 1) {
+      ldmx_log(warn) << "Event-by-event performance information is not "
+                        "recorded when processing with several threads.";
+    }
+  }
+
+  auto &trace{performance::Trace::get()};
+  for (auto module : sequence_)
+    traceNames_.push_back(trace.name(module->getName()));
+  traceFile_ = configuration.getParameter<std::string>("traceFile", "");
+  if (not traceFile_.empty()) {
+    trace.open(numThreads_ + 1,
+               configuration.getParameter<int>("traceBufferSize", 65536),
+               configuration.getParameter<int>("traceSampleFrequency", 1));
   }
 }
 
@@ -127,6 +295,10 @@ Process::~Process() {
   // need to delete the performance object so that it is
   // written before we close the histogram file below
   if (performance_) delete performance_;
+  if (not traceFile_.empty() and
+      not performance::Trace::get().close(traceFile_)) {
+    ldmx_log(warn) << "Unable to write the trace to '" << traceFile_ << "'.";
+  }
   for (EventProcessor *ep : sequence_) {
     delete ep;
   }
@@ -162,6 +334,8 @@ void Process::run() {
   conditions_.onProcessStart();
   for (auto module : sequence_) {
     i_proc++;
+    performance::Trace::Span trace(performance::Callback::onProcessStart,
+                                   traceNames_[i_proc - 1]);
     if (performance_)
       performance_->start(performance::Callback::onProcessStart, i_proc);
     module->onProcessStart();
@@ -171,6 +345,15 @@ void Process::run() {
   if (performance_)
     performance_->stop(performance::Callback::onProcessStart, 0);
 
+  if (numThreads_ > 1 and not NtupleManager::getInstance().empty()) {
+    // ntuple variables are set on the shared NtupleManager while the
+    // events are processed so they can't have several events in flight
+    ldmx_log(warn) << "Ntuples were created, processing events on a single "
+                      "thread instead of "
+                   << numThreads_ << ".";
+    numThreads_ = 1;
+  }
+
   // If we have no input files, but do have an event number, run for
   // that number of events and generate an output file.
   if (inputFiles_.empty() && eventLimit_ > 0) {
@@ -184,6 +367,12 @@ void Process::run() {
     }
     std::string outputFileName = outputFiles_.at(0);
 
+    if (numThreads_ > 1) {
+      ldmx_log(warn) << "Events are generated on a single thread, ignoring "
+                        "the request for "
+                     << numThreads_ << " threads.";
+    }
+
     // Configure the event file to create an output file with no parent. This
     // requires setting the parameters isOutputFile and isSingleOutput to true.
     EventFile outFile(config_, outputFileName, nullptr, true, true, false);
@@ -302,7 +491,8 @@ void Process::run() {
         if (!singleOutput or ifile == 0) {
           // setup new output file
           outFile = new EventFile(config_, outputFiles_[ifile], &inFile,
-                                  singleOutput);
+                                  singleOutput,
+                                  parallelOutput_ and numThreads_ > 1);
           ifile++;
 
           // setup theEvent we will iterate over
@@ -330,36 +520,29 @@ void Process::run() {
       }
 
       bool event_completed = true;
-      while (masterFile->nextEvent(
-                 storageController_.keepEvent(event_completed)) &&
-             (eventLimit_ < 0 || (n_events_processed) < eventLimit_)) {
-        // clean up for storage control calculation
-        storageController_.resetEventState();
-        logging::Formatter::set(theEvent.getEventNumber());
-
-        // notify for new run if necessary
-        if (theEvent.getEventHeader().getRun() != wasRun) {
-          wasRun = theEvent.getEventHeader().getRun();
-          ldmx::RunHeader *rh{masterFile->getRunHeaderPtr(wasRun)};
-          if (rh != nullptr) {
-            runHeader_ = rh;
-            ldmx_log(info) << "Got new run header from '"
-                           << masterFile->getFileName() << "' ...\n"
-                           << *runHeader_;
-            newRun(*runHeader_);
-          } else {
-            ldmx_log(warn) << "Run header for run " << wasRun
-                           << " was not found!";
-          }
-        }
+      if (numThreads_ > 1) {
+        processConcurrently(infilename, *masterFile, outFile, wasRun,
+                            n_events_processed);
+      } else {
+        while (masterFile->nextEvent(
+                   storageController_.keepEvent(event_completed)) &&
+               (eventLimit_ < 0 || (n_events_processed) < eventLimit_)) {
+          // clean up for storage control calculation
+          storageController_.resetEventState();
+          logging::Formatter::set(theEvent.getEventNumber());
 
-        event_completed = process(n_events_processed, 1, theEvent);
+          // notify for new run if necessary
+          checkForNewRun(theEvent.getEventHeader().getRun(), wasRun,
+                         *masterFile);
 
-        if (event_completed) NtupleManager::getInstance().fill();
-        NtupleManager::getInstance().clear();
+          event_completed = process(n_events_processed, 1, theEvent);
 
-        n_events_processed++;
-      }  // loop through events
+          if (event_completed) NtupleManager::getInstance().fill();
+          NtupleManager::getInstance().clear();
+
+          n_events_processed++;
+        }  // loop through events
+      }
 
       bool leave_early{false};
       if (eventLimit_ > 0 && n_events_processed == eventLimit_) {
@@ -372,6 +555,9 @@ void Process::run() {
         leave_early = true;
       }
 
+      // the kept entries of a fast skim are copied from the open input file
+      if (outFile) outFile->copySkimmedEntries();
+
       ldmx_log(info) << "Closing file " << infilename;
       onFileClose(inFile);
 
@@ -399,11 +585,16 @@ void Process::run() {
 
   }  // are there input files? if-else tree
 
+  // collect the histograms filled on several threads before they are used
+  HistogramPool::getInstance().mergeShards();
+
   // finally, notify everyone that we are stopping
   if (performance_) performance_->start(performance::Callback::onProcessEnd, 0);
   i_proc = 0;
   for (auto module : sequence_) {
     i_proc++;
+    performance::Trace::Span trace(performance::Callback::onProcessEnd,
+                                   traceNames_[i_proc - 1]);
     if (performance_)
       performance_->start(performance::Callback::onProcessEnd, i_proc);
     module->onProcessEnd();
@@ -418,7 +609,17 @@ void Process::run() {
 }
 
 int Process::getRunNumber() const {
-  return (eventHeader_) ? (eventHeader_->getRun()) : (runForGeneration_);
+  const ldmx::EventHeader *header{getEventHeader()};
+  return (header) ? (header->getRun()) : (runForGeneration_);
+}
+
+const ldmx::EventHeader *Process::getEventHeader() const {
+  return current_event_header ? current_event_header : eventHeader_;
+}
+
+StorageControl &Process::getStorageController() {
+  return current_storage_controller ? *current_storage_controller
+                                    : storageController_;
 }
 
 TDirectory *Process::makeHistoDirectory(const std::string &dirName) {
@@ -457,6 +658,8 @@ void Process::newRun(ldmx::RunHeader &header) {
   for (auto module : sequence_) {
     i_proc++;
     if (dynamic_cast<Producer *>(module)) {
+      performance::Trace::Span trace(performance::Callback::beforeNewRun,
+                                     traceNames_[i_proc - 1]);
       if (performance_)
         performance_->start(performance::Callback::beforeNewRun, i_proc);
       dynamic_cast<Producer *>(module)->beforeNewRun(header);
@@ -472,6 +675,8 @@ void Process::newRun(ldmx::RunHeader &header) {
   i_proc = 0;
   for (auto module : sequence_) {
     i_proc++;
+    performance::Trace::Span trace(performance::Callback::onNewRun,
+                                   traceNames_[i_proc - 1]);
     if (performance_)
       performance_->start(performance::Callback::onNewRun, i_proc);
     module->onNewRun(header);
@@ -481,7 +686,25 @@ void Process::newRun(ldmx::RunHeader &header) {
   if (performance_) performance_->stop(performance::Callback::onNewRun, 0);
 }
 
-bool Process::process(int n, int n_try, Event &event) const {
+void Process::checkForNewRun(int run, int &wasRun, EventFile &file) {
+  if (run == wasRun) return;
+  wasRun = run;
+  // the cached conditions may be out of date whether or not
+  // the header of the new run is found
+  conditions_.newEpoch();
+  ldmx::RunHeader *rh{file.getRunHeaderPtr(wasRun)};
+  if (rh != nullptr) {
+    runHeader_ = rh;
+    ldmx_log(info) << "Got new run header from '" << file.getFileName()
+                   << "' ...\n"
+                   << *runHeader_;
+    newRun(*runHeader_);
+  } else {
+    ldmx_log(warn) << "Run header for run " << wasRun << " was not found!";
+  }
+}
+
+void Process::logProgress(int n, int n_try, Event &event) const {
   if ((logFrequency_ != -1) && ((n + 1) % logFrequency_ == 0) && (n_try < 2)) {
     // only printout event counter if we've enabled log frequency, the event
     // matches the frequency and we are on the first try
@@ -491,12 +714,19 @@ bool Process::process(int n, int n_try, Event &event) const {
                    << event.getEventHeader().getEventNumber() << "  ("
                    << t.AsString("lc") << ")";
   }
+}
+
+bool Process::process(int n, int n_try, Event &event) const {
+  logProgress(n, n_try, event);
+  performance::Trace::EventScope trace_event(n, event.getEventNumber());
 
   if (performance_) performance_->start(performance::Callback::process, 0);
   std::size_t i_proc{0};
   try {
     for (auto module : sequence_) {
       i_proc++;
+      performance::Trace::Span trace(performance::Callback::process,
+                                     traceNames_[i_proc - 1]);
       if (performance_)
         performance_->start(performance::Callback::process, i_proc);
       if (dynamic_cast<Producer *>(module)) {
@@ -522,11 +752,152 @@ bool Process::process(int n, int n_try, Event &event) const {
   return true;
 }
 
+void Process::processConcurrently(const std::string &infilename,
+                                  EventFile &masterFile, EventFile *outFile,
+                                  int &wasRun, int &n_events_processed) {
+  // which processors need to see the events one at a time and in order
+  std::vector<bool> in_order;
+  for (auto module : sequence_) in_order.push_back(not module->isThreadSafe());
+
+  // with parallel output, each event in flight is written on its worker
+  // into a buffer that is merged into the output file
+  bool parallel_output{outFile and outFile->isMerged()};
+
+  // each event in flight reads through its own handle on the input file
+  std::vector<std::unique_ptr<EventSlot>> slots;
+  for (std::size_t i{0}; i < numThreads_ * events_per_thread; i++) {
+    auto &slot{slots.emplace_back(
+        std::make_unique<EventSlot>(passname_, storageController_))};
+    slot->input = std::make_unique<EventFile>(config_, infilename);
+    slot->input->setupEvent(&slot->event);
+    if (parallel_output) {
+      slot->output =
+          std::make_unique<EventFile>(config_, outFile, slot->input.get());
+      slot->output->setupEvent(&slot->event);
+      for (auto rule : dropKeepRules_) slot->output->addDrop(rule);
+      slot->output->setupMergedOutput();
+    }
+  }
+
+  HistogramPool::getInstance().makeShards(numThreads_);
+
+  Turnstile turnstile(sequence_.size());
+  Long64_t first_entry{0};
+  bool keep_previous{true};
+  while (eventLimit_ < 0 || n_events_processed < eventLimit_) {
+    std::size_t n_window{slots.size()};
+    if (eventLimit_ >= 0) {
+      n_window =
+          std::min(n_window, std::size_t(eventLimit_ - n_events_processed));
+    }
+
+    // read the next window of entries
+    forEachConcurrently(numThreads_, n_window, [&](std::size_t i) {
+      slots[i]->loaded = slots[i]->input->seekEvent(first_entry + i);
+    });
+    if (not slots[0]->loaded) break;
+
+    // notify for new run if necessary, this is done with the first event
+    // of the new run as the current event like in single-threaded running
+    current_event_header = slots[0]->event.getEventHeaderPtr();
+    checkForNewRun(slots[0]->event.getEventHeader().getRun(), wasRun,
+                   masterFile);
+    current_event_header = nullptr;
+
+    // only process up to the end of the file or the next change of run,
+    // the rest are read again in the next window
+    std::size_t n_ready{1};
+    while (n_ready < n_window and slots[n_ready]->loaded and
+           slots[n_ready]->event.getEventHeader().getRun() == wasRun)
+      n_ready++;
+
+    turnstile.reset();
+    forEachConcurrently(
+        numThreads_, n_ready,
+        [&](std::size_t i_event) {
+          EventSlot &slot{*slots[i_event]};
+          current_event_header = slot.event.getEventHeaderPtr();
+          current_storage_controller = &slot.storage;
+          slot.storage.resetEventState();
+          logging::Formatter::set(slot.event.getEventNumber());
+          logProgress(n_events_processed + i_event, 1, slot.event);
+          performance::Trace::EventScope trace_event(
+              n_events_processed + i_event, slot.event.getEventNumber());
+
+          slot.completed = true;
+          for (std::size_t i_proc{0}; i_proc < sequence_.size(); i_proc++) {
+            if (in_order[i_proc]) {
+              performance::Trace::Span trace("wait", traceNames_[i_proc]);
+              if (not turnstile.wait(i_proc, i_event)) break;
+            }
+            // an aborted event still needs to give up its turns
+            if (slot.completed) {
+              performance::Trace::Span trace(performance::Callback::process,
+                                             traceNames_[i_proc]);
+              auto module{sequence_[i_proc]};
+              try {
+                if (dynamic_cast<Producer *>(module)) {
+                  (dynamic_cast<Producer *>(module))->produce(slot.event);
+                } else if (dynamic_cast<Analyzer *>(module)) {
+                  (dynamic_cast<Analyzer *>(module))->analyze(slot.event);
+                }
+              } catch (AbortEventException &) {
+                slot.completed = false;
+              }
+            }
+            if (in_order[i_proc]) turnstile.pass(i_proc);
+          }
+
+          if (parallel_output) {
+            slot.output->writeEvent(slot.storage.keepEvent(slot.completed));
+          }
+
+          current_event_header = nullptr;
+          current_storage_controller = nullptr;
+        },
+        [&]() { turnstile.stop(); });
+
+    // write the events out in the order they were read
+    for (std::size_t i{0}; i < n_ready; i++) {
+      if (parallel_output) {
+        // the buffers are handed over in a fixed order so that the
+        // output is the same from run to run, each event in flight has
+        // its own buffer so they share the memory given to them
+        slots[i]->output->mergeIfFull(slots.size());
+      } else if (outFile) {
+        // the output file follows its parent so this loads the entry
+        // we are writing and stores the previous one
+        if (not outFile->nextEvent(keep_previous)) {
+          EXCEPTION_RAISE("BadCode",
+                          "Output file ran out of entries before the events "
+                          "processed on the worker threads.");
+        }
+        outFile->getEvent()->copyProducts(slots[i]->event);
+        keep_previous = slots[i]->storage.keepEvent(slots[i]->completed);
+      }
+      n_events_processed++;
+    }
+
+    first_entry += n_ready;
+  }
+
+  if (parallel_output) {
+    // hand over the rest of the buffers in order
+    for (auto &slot : slots) slot->output.reset();
+  } else if (outFile) {
+    // store the last event and move the output file to where
+    // a single-threaded run would leave it
+    outFile->nextEvent(keep_previous);
+  }
+}
+
 void Process::onFileOpen(EventFile &file) const {
   if (performance_) performance_->start(performance::Callback::onFileOpen, 0);
   std::size_t i_proc{0};
   for (auto module : sequence_) {
     i_proc++;
+    performance::Trace::Span trace(performance::Callback::onFileOpen,
+                                   traceNames_[i_proc - 1]);
     if (performance_)
       performance_->start(performance::Callback::onFileOpen, i_proc);
     module->onFileOpen(file);
@@ -541,6 +912,8 @@ void Process::onFileClose(EventFile &file) const {
   std::size_t i_proc{0};
   for (auto module : sequence_) {
     i_proc++;
+    performance::Trace::Span trace(performance::Callback::onFileClose,
+                                   traceNames_[i_proc - 1]);
     if (performance_)
       performance_->start(performance::Callback::onFileClose, i_proc);
     module->onFileClose(file);
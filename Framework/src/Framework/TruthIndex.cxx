@@ -0,0 +1,223 @@
+#include "Framework/TruthIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+#include "DetDescr/SimSpecialID.h"
+
+namespace framework {
+
+const std::string TruthIndex::PARTICLES{"SimParticles"};
+const std::string TruthIndex::TARGET_SP_HITS{"TargetScoringPlaneHits"};
+const std::string TruthIndex::ECAL_SP_HITS{"EcalScoringPlaneHits"};
+
+namespace {
+/// scoring plane of the ID of a hit, -1 if it isn't on a scoring plane
+int plane(int id) {
+  ldmx::DetectorID detid(id);
+  if (detid.subdet() != ldmx::SD_SIM_SPECIAL) return -1;
+  return ldmx::SimSpecialID(detid).plane();
+}
+}  // namespace
+
+std::pair<int, const ldmx::SimParticle *> TruthIndex::findRecoil(
+    const std::map<int, ldmx::SimParticle> &particles) {
+  // The recoil electron is "produced" in the dark brem generation
+  for (const auto &[track_id, particle] : particles) {
+    if (particle.getPdgID() == 11 and
+        particle.getProcessType() ==
+            ldmx::SimParticle::ProcessType::eDarkBrem) {
+      return {track_id, &particle};
+    }
+  }
+  // only get here if recoil electron was not "produced" by dark brem
+  //   in this case (bkgd), we interpret the primary electron as also the
+  //   recoil electron
+  return {1, &(particles.at(1))};
+}
+
+void TruthIndex::update(const Event &event) {
+  event_ = &event;
+  particles_valid_ = false;
+  recoil_valid_ = false;
+  recoil_target_valid_ = false;
+  recoil_ecal_valid_ = false;
+  for (auto &[name, sp] : scoring_planes_) sp.valid_ = false;
+}
+
+void TruthIndex::indexParticles() const {
+  if (particles_valid_) return;
+  particles_.clear();
+  track_ids_.clear();
+  daughter_offsets_.assign(1, 0);
+  daughters_.clear();
+  parent_offsets_.assign(1, 0);
+  parents_.clear();
+
+  if (event_->exists(PARTICLES)) {
+    const auto &particles{event_->getMap<int, ldmx::SimParticle>(PARTICLES)};
+    // the map is sorted, so the track IDs are too
+    for (const auto &[track_id, particle] : particles) {
+      track_ids_.push_back(track_id);
+      particles_.push_back(&particle);
+    }
+    for (const ldmx::SimParticle *particle : particles_) {
+      for (int track_id : particle->getDaughters()) {
+        int index{find(track_id)};
+        if (index >= 0) daughters_.push_back(index);
+      }
+      daughter_offsets_.push_back(daughters_.size());
+      for (int track_id : particle->getParents()) {
+        int index{find(track_id)};
+        if (index >= 0) parents_.push_back(index);
+      }
+      parent_offsets_.push_back(parents_.size());
+    }
+  }
+  particles_valid_ = true;
+}
+
+std::size_t TruthIndex::getNumParticles() const {
+  indexParticles();
+  return particles_.size();
+}
+
+int TruthIndex::getIndex(int track_id) const {
+  indexParticles();
+  return find(track_id);
+}
+
+int TruthIndex::find(int track_id) const {
+  auto it{std::lower_bound(track_ids_.begin(), track_ids_.end(), track_id)};
+  if (it == track_ids_.end() or *it != track_id) return -1;
+  return it - track_ids_.begin();
+}
+
+int TruthIndex::getTrackID(int index) const {
+  indexParticles();
+  return track_ids_.at(index);
+}
+
+const ldmx::SimParticle &TruthIndex::getParticle(int index) const {
+  indexParticles();
+  return *particles_.at(index);
+}
+
+const ldmx::SimParticle *TruthIndex::findParticle(int track_id) const {
+  int index{getIndex(track_id)};
+  return index < 0 ? nullptr : particles_[index];
+}
+
+TruthIndex::Indices TruthIndex::getDaughters(int index) const {
+  indexParticles();
+  return {daughters_.data() + daughter_offsets_.at(index),
+          daughters_.data() + daughter_offsets_.at(index + 1)};
+}
+
+TruthIndex::Indices TruthIndex::getParents(int index) const {
+  indexParticles();
+  return {parents_.data() + parent_offsets_.at(index),
+          parents_.data() + parent_offsets_.at(index + 1)};
+}
+
+int TruthIndex::getRecoilTrackID() const {
+  if (not recoil_valid_) {
+    std::tie(recoil_track_id_, recoil_) =
+        findRecoil(event_->getMap<int, ldmx::SimParticle>(PARTICLES));
+    recoil_valid_ = true;
+  }
+  return recoil_track_id_;
+}
+
+const ldmx::SimParticle *TruthIndex::getRecoil() const {
+  getRecoilTrackID();
+  return recoil_;
+}
+
+const ldmx::SimTrackerHit *TruthIndex::getRecoilAtTarget() const {
+  if (not recoil_target_valid_) {
+    recoil_target_ = findRecoilHit(TARGET_SP_HITS, TARGET_PLANE);
+    recoil_target_valid_ = true;
+  }
+  return recoil_target_;
+}
+
+const ldmx::SimTrackerHit *TruthIndex::getRecoilAtEcal() const {
+  if (not recoil_ecal_valid_) {
+    recoil_ecal_ = findRecoilHit(ECAL_SP_HITS, ECAL_PLANE);
+    recoil_ecal_valid_ = true;
+  }
+  return recoil_ecal_;
+}
+
+const ldmx::SimTrackerHit *TruthIndex::findRecoilHit(
+    const std::string &collection, int plane) const {
+  if (not event_->exists(collection)) return nullptr;
+  const auto &hits{event_->getCollection<ldmx::SimTrackerHit>(collection)};
+  const ScoringPlane &sp{indexScoringPlane(collection)};
+  const float *px{sp.columns_.px().data()}, *py{sp.columns_.py().data()},
+      *pz{sp.columns_.pz().data()};
+  int track_id{getRecoilTrackID()}, found{-1};
+  float pmax{0};
+  for (int i : range(sp, {track_id, plane}, {track_id, plane + 1})) {
+    if (pz[i] <= 0) continue;
+    double p = std::sqrt(std::pow(px[i], 2) + std::pow(py[i], 2) +
+                         std::pow(pz[i], 2));
+    if (p > pmax) {
+      found = i;
+      pmax = p;
+    }
+  }
+  return found < 0 ? nullptr : &hits[found];
+}
+
+const TruthIndex::ScoringPlane &TruthIndex::indexScoringPlane(
+    const std::string &collection) const {
+  ScoringPlane &sp{scoring_planes_[collection]};
+  if (sp.valid_) return sp;
+  sp.keys_.clear();
+  sp.order_.clear();
+  if (event_->exists(collection)) {
+    sp.columns_.fill(event_->getCollection<ldmx::SimTrackerHit>(collection));
+    const int *track_ids{sp.columns_.trackID().data()},
+        *ids{sp.columns_.id().data()};
+    sp.order_.resize(sp.columns_.size());
+    std::iota(sp.order_.begin(), sp.order_.end(), 0);
+    std::stable_sort(sp.order_.begin(), sp.order_.end(), [&](int a, int b) {
+      return std::make_pair(track_ids[a], plane(ids[a])) <
+             std::make_pair(track_ids[b], plane(ids[b]));
+    });
+    sp.keys_.reserve(sp.columns_.size());
+    for (int i : sp.order_) sp.keys_.emplace_back(track_ids[i], plane(ids[i]));
+  }
+  sp.valid_ = true;
+  return sp;
+}
+
+TruthIndex::Indices TruthIndex::range(const ScoringPlane &sp,
+                                      const std::pair<int, int> &begin,
+                                      const std::pair<int, int> &end) const {
+  auto first{std::lower_bound(sp.keys_.begin(), sp.keys_.end(), begin)};
+  auto last{std::lower_bound(first, sp.keys_.end(), end)};
+  const int *order{sp.order_.data()};
+  return {order + (first - sp.keys_.begin()),
+          order + (last - sp.keys_.begin())};
+}
+
+TruthIndex::Indices TruthIndex::getScoringPlaneHits(
+    const std::string &collection, int track_id, int plane) const {
+  return range(indexScoringPlane(collection), {track_id, plane},
+               {track_id, plane + 1});
+}
+
+TruthIndex::Indices TruthIndex::getScoringPlaneHits(
+    const std::string &collection, int track_id) const {
+  return range(indexScoringPlane(collection),
+               {track_id, std::numeric_limits<int>::min()},
+               {track_id + 1, std::numeric_limits<int>::min()});
+}
+
+}  // namespace framework
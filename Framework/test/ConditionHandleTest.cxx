@@ -0,0 +1,131 @@
+/**
+ * @file ConditionHandleTest.cxx
+ * @brief Test the resolution of conditions through handles
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <vector>
+
+#include "Framework/ConditionHandle.h"
+#include "Framework/ConditionsObject.h"
+#include "Framework/ConditionsObjectProvider.h"
+#include "Framework/EventHeader.h"
+#include "Framework/Process.h"
+#include "Framework/RunHeader.h"
+
+namespace framework {
+namespace test {
+
+/// conditions object only valid for the run it was made for
+class RunCondition : public ConditionsObject {
+ public:
+  RunCondition(int run) : ConditionsObject("RunCondition"), run_{run} {}
+  int run_;
+};
+
+/**
+ * Provides a new RunCondition for the run of each request
+ *
+ * The objects are kept until the end of the test, so that handles
+ * still pointing to an object the conditions have released can be
+ * compared with the new one.
+ */
+class RunConditionProvider : public ConditionsObjectProvider {
+ public:
+  RunConditionProvider(const std::string& name, const std::string& tagname,
+                       const config::Parameters& parameters, Process& process)
+      : ConditionsObjectProvider(name, tagname, parameters, process) {}
+
+  std::pair<const ConditionsObject*, ConditionsIOV> getCondition(
+      const ldmx::EventHeader& context) final override {
+    provided_.push_back(std::make_unique<RunCondition>(context.getRun()));
+    return {provided_.back().get(),
+            ConditionsIOV(context.getRun(), context.getRun())};
+  }
+
+  void releaseConditionsObject(const ConditionsObject*) final override {}
+
+  /// objects provided so far
+  static std::vector<std::unique_ptr<RunCondition>> provided_;
+};
+
+std::vector<std::unique_ptr<RunCondition>> RunConditionProvider::provided_;
+
+}  // namespace test
+}  // namespace framework
+
+DECLARE_CONDITIONS_PROVIDER_NS(framework::test, RunConditionProvider)
+
+/**
+ * Test for the ConditionHandle
+ *
+ * The process starts a new epoch of the conditions whenever the run of
+ * the events changes, whether or not it finds a header for the new run.
+ *
+ * - a handle resolves its object once within a run
+ * - a handle resolves its object again after the run changed
+ * - copied and assigned handles resolve their object again
+ */
+TEST_CASE("ConditionHandle", "[Framework][functionality]") {
+  using framework::test::RunCondition;
+  using framework::test::RunConditionProvider;
+
+  framework::config::Parameters configuration;
+  framework::Process process(configuration);
+  ldmx::EventHeader header;
+  process.setEventHeader(&header);
+
+  auto& conditions{process.getConditions()};
+  conditions.createConditionsObjectProvider(
+      "framework::test::RunConditionProvider", "RunCondition", "",
+      framework::config::Parameters());
+  auto& provided{RunConditionProvider::provided_};
+  provided.clear();
+
+  framework::ConditionHandle<RunCondition> handle{"RunCondition"};
+  CHECK(handle.name() == "RunCondition");
+
+  ldmx::RunHeader run1(1);
+  header.setRun(1);
+  conditions.newEpoch();
+  conditions.onNewRun(run1);
+
+  const RunCondition& first{handle(conditions)};
+  CHECK(first.run_ == 1);
+  CHECK(provided.size() == 1);
+
+  SECTION("resolve once within a run") {
+    CHECK(&handle(conditions) == &first);
+    CHECK(&conditions.getCondition<RunCondition>("RunCondition") == &first);
+    CHECK(provided.size() == 1);
+  }
+
+  SECTION("resolve again after the run changed") {
+    // no header for the new run, so only the epoch changes
+    header.setRun(2);
+    conditions.newEpoch();
+
+    const RunCondition& second{handle(conditions)};
+    CHECK(second.run_ == 2);
+    CHECK(provided.size() == 2);
+    CHECK(&handle(conditions) == &second);
+    CHECK(&conditions.getCondition<RunCondition>("RunCondition") == &second);
+  }
+
+  SECTION("copies resolve again") {
+    framework::ConditionHandle<RunCondition> assigned{"RunCondition"};
+    CHECK(&assigned(conditions) == &first);
+
+    // the run changes without a new epoch, so only handles looking
+    // up their object again find the one for the changed run
+    header.setRun(2);
+    framework::ConditionHandle<RunCondition> copied{handle};
+    CHECK(copied.name() == "RunCondition");
+    CHECK(copied(conditions).run_ == 2);
+
+    assigned = handle;
+    CHECK(assigned.name() == "RunCondition");
+    CHECK(&assigned(conditions) == &copied(conditions));
+    CHECK(&handle(conditions) == &first);
+  }
+}
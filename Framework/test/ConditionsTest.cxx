@@ -0,0 +1,115 @@
+/**
+ * @file ConditionsTest.cxx
+ * @brief Test the caching of conditions objects
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+#include "Framework/Conditions.h"
+#include "Framework/ConditionsObject.h"
+#include "Framework/ConditionsObjectProvider.h"
+#include "Framework/EventHeader.h"
+#include "Framework/Process.h"
+
+namespace framework {
+namespace test {
+
+/// conditions object holding a single number
+class NumberCondition : public ConditionsObject {
+ public:
+  NumberCondition(const std::string& name, int value)
+      : ConditionsObject(name), value_{value} {}
+  int value_;
+};
+
+/// provides ten times the run number, valid for that run
+class ParentConditionProvider : public ConditionsObjectProvider {
+ public:
+  ParentConditionProvider(const std::string& name, const std::string& tagname,
+                          const config::Parameters& parameters,
+                          Process& process)
+      : ConditionsObjectProvider(name, tagname, parameters, process) {}
+
+  std::pair<const ConditionsObject*, ConditionsIOV> getCondition(
+      const ldmx::EventHeader& context) final override {
+    int run{context.getRun()};
+    return {new NumberCondition(getConditionObjectName(), 10 * run),
+            ConditionsIOV(run, run)};
+  }
+};
+
+/// provides one more than its parent, valid as long as the parent is
+class ChildConditionProvider : public ConditionsObjectProvider {
+ public:
+  ChildConditionProvider(const std::string& name, const std::string& tagname,
+                         const config::Parameters& parameters, Process& process)
+      : ConditionsObjectProvider(name, tagname, parameters, process) {}
+
+  std::pair<const ConditionsObject*, ConditionsIOV> getCondition(
+      const ldmx::EventHeader& context) final override {
+    auto [parent, iov] = requestParentCondition("Parent", context);
+    int value{dynamic_cast<const NumberCondition&>(*parent).value_};
+    return {new NumberCondition(getConditionObjectName(), value + 1), iov};
+  }
+};
+
+}  // namespace test
+}  // namespace framework
+
+DECLARE_CONDITIONS_PROVIDER_NS(framework::test, ParentConditionProvider)
+DECLARE_CONDITIONS_PROVIDER_NS(framework::test, ChildConditionProvider)
+
+/**
+ * Test for the conditions cache
+ *
+ * - a provider can request its parent conditions while providing
+ * - objects are provided again once they are out of date
+ * - threads requesting the same object at once all get the cached one
+ */
+TEST_CASE("Conditions Cache", "[Framework][functionality]") {
+  using framework::test::NumberCondition;
+
+  framework::config::Parameters configuration;
+  framework::Process process(configuration);
+  ldmx::EventHeader header;
+  process.setEventHeader(&header);
+
+  auto& conditions{process.getConditions()};
+  conditions.createConditionsObjectProvider(
+      "framework::test::ParentConditionProvider", "Parent", "",
+      framework::config::Parameters());
+  conditions.createConditionsObjectProvider(
+      "framework::test::ChildConditionProvider", "Child", "",
+      framework::config::Parameters());
+
+  header.setRun(1);
+
+  SECTION("request the parent while providing") {
+    const auto& child{conditions.getCondition<NumberCondition>("Child")};
+    CHECK(child.value_ == 11);
+    CHECK(&conditions.getCondition<NumberCondition>("Child") == &child);
+    CHECK(conditions.getCondition<NumberCondition>("Parent").value_ == 10);
+
+    header.setRun(2);
+    CHECK(conditions.getCondition<NumberCondition>("Child").value_ == 21);
+    CHECK(conditions.getCondition<NumberCondition>("Parent").value_ == 20);
+  }
+
+  SECTION("request from several threads") {
+    std::vector<const NumberCondition*> found(4, nullptr);
+    std::vector<std::thread> threads;
+    for (std::size_t i{0}; i < found.size(); i++) {
+      threads.emplace_back([&, i]() {
+        found[i] = &conditions.getCondition<NumberCondition>("Child");
+      });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (auto child : found) {
+      REQUIRE(child);
+      CHECK(child == found.front());
+      CHECK(child->value_ == 11);
+    }
+  }
+}
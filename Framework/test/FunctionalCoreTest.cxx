@@ -1,11 +1,15 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
+#include <chrono>
 #include <cstdio>  //for remove
+#include <cstdlib>
+#include <filesystem>
 
 #include "Framework/EventFile.h"
 #include "Framework/EventProcessor.h"
 #include "Framework/Process.h"
+#include "Framework/ProductHandle.h"
 #include "Framework/RunHeader.h"
 #include "Hcal/Event/HcalHit.h"
 #include "Hcal/Event/HcalVetoResult.h"
@@ -31,6 +35,8 @@ namespace test {
  * - The input object is an HcalVetoResult where events with an event index pass
  * - The max PE hit in the HcalVetoResult has an ID equal to the event index
  * - If a run header is created, the event count and the run number are equal
+ * - If a header parameter is named, the event header gets an int parameter
+ * with that name equal to the event number
  *
  * Checks
  * - Event::add function does not throw any errors.
@@ -45,12 +51,16 @@ class TestProducer : public Producer {
   /// should we create the run header?
   bool createRunHeader_;
 
+  /// name of the event header parameter to set, none if empty
+  std::string headerParameter_;
+
  public:
   TestProducer(const std::string& name, Process& p) : Producer(name, p) {}
   ~TestProducer() {}
 
   void configure(framework::config::Parameters& p) final override {
     createRunHeader_ = p.getParameter<bool>("createRunHeader");
+    headerParameter_ = p.getParameter<std::string>("headerParameter", "");
   }
 
   void beforeNewRun(ldmx::RunHeader& header) final override {
@@ -91,6 +101,9 @@ class TestProducer : public Producer {
 
     if (res.passesVeto()) setStorageHint(StorageControl::Hint::MustKeep);
 
+    if (not headerParameter_.empty())
+      event.getEventHeader().setIntParameter(headerParameter_, i_event);
+
     return;
   }
 };  // TestProducer
@@ -103,6 +116,7 @@ class TestProducer : public Producer {
  * - the correct number and contents following the pattern produced by
  * TestProducer.
  * - Event::getCollection and Event::getObject don't throw errors.
+ * - ProductHandle gives the same objects as Event::getCollection.
  */
 class TestAnalyzer : public Analyzer {
  public:
@@ -147,10 +161,18 @@ class TestAnalyzer : public Analyzer {
     CHECK(i_event_from_bus.at(0) == i_event);
     CHECK(i_event_from_bus.at(1) == i_event);
 
+    CHECK(&index_handle_(event) == &i_event_from_bus);
+    CHECK(&collection_handle_(event) == &caloHits);
+
     return;
   }
 
  private:
+  /// handle to the event indices, resolved on first use
+  framework::CollectionHandle<int> index_handle_{"EventIndex"};
+  /// handle to the test collection, resolved on first use
+  framework::CollectionHandle<ldmx::CalorimeterHit> collection_handle_{
+      "TestCollection"};
   /// test histogram filled with event indices
   TH1F* test_hist_;
 };  // TestAnalyzer
@@ -389,6 +411,29 @@ static bool removeFile(const std::string& filepath) {
   return remove(filepath.c_str()) == 0;
 }
 
+/**
+ * @func hasHeaderParameter
+ * Checks that the event header of each event in the file has the
+ * int parameter set by the TestProducer to the event number.
+ */
+static bool hasHeaderParameter(const std::string& filepath,
+                               const std::string& name) {
+  TFile f(filepath.c_str());
+  TTreeReader events("LDMX_Events", &f);
+  TTreeReaderValue<ldmx::EventHeader> header(events, "EventHeader");
+  int checked{0};
+  try {
+    while (events.Next()) {
+      if (header->getIntParameter(name) != header->getEventNumber())
+        return false;
+      checked++;
+    }
+  } catch (framework::exception::Exception&) {
+    return false;
+  }
+  return checked > 0;
+}
+
 /**
  * @func run the process for the input parameters
  */
@@ -516,6 +561,35 @@ TEST_CASE("Core Framework Functionality", "[Framework][functionality]") {
                    framework::test::isGoodEventFile("test", 3, 1, false));
       }
 
+      SECTION("unsplit TestObject in small baskets") {
+        std::map<std::string, std::any> layout;
+        layout["regex"] = std::string("^TestObject_");
+        layout["basketSize"] = 4000;
+        layout["splitLevel"] = 0;
+        layout["compression"] = 101;
+        framework::config::Parameters layoutConfig;
+        layoutConfig.setParameters(layout);
+        process["branchLayouts"] =
+            std::vector<framework::config::Parameters>{layoutConfig};
+        process["autoFlush"] = 2;
+        REQUIRE(framework::test::runProcess(process));
+        CHECK_THAT(outputFiles.at(0),
+                   framework::test::isGoodEventFile("test", 3, 1));
+
+        TFile f(outputFiles.at(0).c_str());
+        auto events{static_cast<TTree*>(f.Get("LDMX_Events"))};
+        REQUIRE(events);
+        CHECK(events->GetAutoFlush() == 2);
+        TBranch* object{events->GetBranch("TestObject_test")};
+        REQUIRE(object);
+        CHECK(object->GetBasketSize() == 4000);
+        CHECK(object->GetSplitLevel() == 0);
+        CHECK(object->GetCompressionSettings() == 101);
+        TBranch* collection{events->GetBranch("TestCollection_test")};
+        REQUIRE(collection);
+        CHECK(collection->GetSplitLevel() == 3);
+      }
+
       SECTION("skim for even indexed events") {
         process["skimDefaultIsKeep"] = false;
         std::vector<std::string> rules = {"TestProducer", ""};
@@ -665,13 +739,47 @@ TEST_CASE("Core Framework Functionality", "[Framework][functionality]") {
                                           "makeInputs", 2 + 3 + 4, 3, false));
         }
 
+        SECTION("read input lazily") {
+          process["lazyInputReading"] = true;
+          REQUIRE(framework::test::runProcess(process));
+          CHECK_THAT(event_file_path, framework::test::isGoodEventFile(
+                                          "makeInputs", 2 + 3 + 4, 3));
+        }
+
+        SECTION("fast skim keeping everything") {
+          process["fastSkim"] = true;
+          REQUIRE(framework::test::runProcess(process));
+          CHECK_THAT(event_file_path, framework::test::isGoodEventFile(
+                                          "makeInputs", 2 + 3 + 4, 3));
+
+          // the baskets of each input file are copied as they are,
+          // refilling the entries would have merged them into one
+          int input_baskets{0};
+          for (auto const& input_file : inputFiles) {
+            TFile f(input_file.c_str());
+            auto events{static_cast<TTree*>(f.Get("LDMX_Events"))};
+            REQUIRE(events);
+            input_baskets += events->GetBranch("TestCollection_makeInputs")
+                                 ->GetWriteBasket();
+          }
+          TFile f(event_file_path.c_str());
+          auto events{static_cast<TTree*>(f.Get("LDMX_Events"))};
+          REQUIRE(events);
+          CHECK(events->GetEntries() == 2 + 3 + 4);
+          CHECK(input_baskets == 3);
+          CHECK(events->GetBranch("TestCollection_makeInputs")
+                    ->GetWriteBasket() == input_baskets);
+        }
+
         CHECK_THAT(hist_file_path, framework::test::isGoodHistogramFile(
                                        1 + 2 + 1 + 2 + 3 + 1 + 2 + 3 + 4));
         CHECK(framework::test::removeFile(hist_file_path));
       }
 
       SECTION("with producers") {
+        // the producer changes the event header read from the input
         producerParameters["createRunHeader"] = false;
+        producerParameters["headerParameter"] = std::string("Produced");
         producerConfig.setParameters(producerParameters);
         sequence = {producerConfig};
 
@@ -691,6 +799,53 @@ TEST_CASE("Core Framework Functionality", "[Framework][functionality]") {
           CHECK_THAT(event_file_path,
                      framework::test::isGoodEventFile("test", 1 + 1 + 2, 3));
         }
+
+        SECTION("several threads") {
+          process["numThreads"] = 2;
+          REQUIRE(framework::test::runProcess(process));
+          CHECK_THAT(event_file_path,
+                     framework::test::isGoodEventFile("test", 2 + 3 + 4, 3));
+        }
+
+        SECTION("skim on several threads with parallel output") {
+          process["numThreads"] = 2;
+          process["parallelOutput"] = true;
+          process["skimDefaultIsKeep"] = false;
+          std::vector<std::string> rules = {"TestProducer", ""};
+          process["skimRules"] = rules;
+          REQUIRE(framework::test::runProcess(process));
+          CHECK_THAT(event_file_path,
+                     framework::test::isGoodEventFile("test", 1 + 1 + 2, 3));
+        }
+
+        SECTION("fast skim keeping everything") {
+          process["fastSkim"] = true;
+          REQUIRE(framework::test::runProcess(process));
+          CHECK_THAT(event_file_path,
+                     framework::test::isGoodEventFile("test", 2 + 3 + 4, 3));
+        }
+
+        SECTION("fast skim for even indexed events") {
+          process["fastSkim"] = true;
+          process["skimDefaultIsKeep"] = false;
+          std::vector<std::string> rules = {"TestProducer", ""};
+          process["skimRules"] = rules;
+          REQUIRE(framework::test::runProcess(process));
+          CHECK_THAT(event_file_path,
+                     framework::test::isGoodEventFile("test", 1 + 1 + 2, 3));
+        }
+
+        SECTION("skim reading input lazily") {
+          process["lazyInputReading"] = true;
+          process["skimDefaultIsKeep"] = false;
+          std::vector<std::string> rules = {"TestProducer", ""};
+          process["skimRules"] = rules;
+          REQUIRE(framework::test::runProcess(process));
+          CHECK_THAT(event_file_path,
+                     framework::test::isGoodEventFile("test", 1 + 1 + 2, 3));
+        }
+
+        CHECK(framework::test::hasHeaderParameter(event_file_path, "Produced"));
       }
 
       CHECK(framework::test::removeFile(event_file_path));
@@ -700,3 +855,78 @@ TEST_CASE("Core Framework Functionality", "[Framework][functionality]") {
   }  // need input files
 
 }  // process test
+
+/**
+ * Write and read speed and size of an output file with different layouts
+ *
+ * The reference sample (an LDMX_Events file from the simulation) is copied
+ * into a new output file with each layout of its branches. The branches
+ * keep their split level, so only the basket sizes and compression differ.
+ * Run explicitly with the path to the sample in LDMX_REFERENCE_SAMPLE,
+ *
+ *  LDMX_REFERENCE_SAMPLE=sim.root run_test "[benchmark]"
+ */
+TEST_CASE("Output Layout Throughput", "[.][benchmark]") {
+  const char* sample{std::getenv("LDMX_REFERENCE_SAMPLE")};
+  if (not sample) {
+    WARN("Set LDMX_REFERENCE_SAMPLE to the file to benchmark with.");
+    return;
+  }
+
+  auto layout = [](const std::string& regex, int basket_size,
+                   int split_level, int compression) {
+    std::map<std::string, std::any> parameters;
+    parameters["regex"] = regex;
+    parameters["basketSize"] = basket_size;
+    parameters["splitLevel"] = split_level;
+    parameters["compression"] = compression;
+    framework::config::Parameters config;
+    config.setParameters(parameters);
+    return config;
+  };
+
+  using Layouts = std::vector<framework::config::Parameters>;
+  std::vector<std::pair<std::string, Layouts>> layouts{
+      {"default", {}},
+      {"large hit baskets",
+       {layout(".*SimHits_.*", 1000000, 3, -1),
+        layout(".*ScoringPlaneHits_.*", 1000000, 3, -1)}},
+      {"small baskets for small objects",
+       {layout(".*(Result|Header).*", 8000, 3, -1)}},
+      {"large hit baskets, LZ4 particles",
+       {layout(".*SimHits_.*", 1000000, 3, -1),
+        layout("SimParticles_.*", 0, 3, 404)}}};
+
+  std::string output{"test_output_layout_events.root"};
+  for (const auto& [name, rules] : layouts) {
+    std::map<std::string, std::any> process;
+    process["passName"] = std::string("layout");
+    process["compressionSetting"] = 9;
+    process["logFrequency"] = -1;
+    process["tree_name"] = std::string("LDMX_Events");
+    process["inputFiles"] = std::vector<std::string>{sample};
+    process["outputFiles"] = std::vector<std::string>{output};
+    process["branchLayouts"] = rules;
+
+    auto start{std::chrono::steady_clock::now()};
+    REQUIRE(framework::test::runProcess(process));
+    std::chrono::duration<double> write{std::chrono::steady_clock::now() -
+                                        start};
+
+    TFile f(output.c_str());
+    auto events{static_cast<TTree*>(f.Get("LDMX_Events"))};
+    REQUIRE(events);
+    double mb{1e-6 * events->GetTotBytes()};
+    start = std::chrono::steady_clock::now();
+    for (Long64_t i{0}; i < events->GetEntries(); i++) events->GetEntry(i);
+    std::chrono::duration<double> read{std::chrono::steady_clock::now() -
+                                       start};
+
+    std::cout << name << " : write " << mb / write.count() << " MB/s, read "
+              << mb / read.count() << " MB/s, "
+              << 1e-6 * std::filesystem::file_size(output) << " MB on disk"
+              << std::endl;
+    f.Close();
+    CHECK(framework::test::removeFile(output));
+  }
+}
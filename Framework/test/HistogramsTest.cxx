@@ -0,0 +1,39 @@
+/**
+ * @file HistogramsTest.cxx
+ * @brief Test the filling of histograms through per-thread shards
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "Framework/Histograms.h"
+
+/**
+ * Test for the shards of the HistogramPool
+ *
+ * - fills on a shard are added to the pooled histogram when merged
+ * - histograms created after the shards are made (e.g. in onNewRun
+ *   of a later input file) get shards of their own
+ */
+TEST_CASE("HistogramPool Shards", "[Framework][functionality]") {
+  using framework::HistogramPool;
+
+  auto& pool{HistogramPool::getInstance()};
+  framework::HistogramHelper histograms("shards");
+
+  auto before{histograms.create("before", "x", 10, 0., 10.)};
+  pool.makeShards(2);
+  auto after{histograms.create("after", "x", 10, 0., 10.)};
+
+  HistogramPool::useShard(1);
+  before.fill(1.);
+  after.fill(2.);
+  histograms.fill("after", 3.);
+  HistogramPool::useShard(-1);
+
+  // nothing has reached the pooled histograms yet
+  CHECK(before.get()->GetEntries() == 0);
+  CHECK(after.get()->GetEntries() == 0);
+
+  pool.mergeShards();
+  CHECK(before.get()->GetEntries() == 1);
+  CHECK(after.get()->GetEntries() == 2);
+}
@@ -0,0 +1,73 @@
+/**
+ * @file LoggerTest.cxx
+ * @brief Test the asynchronous logging to a file
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>  //for remove
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Framework/Logger.h"
+
+/**
+ * Test for logging from several threads through the asynchronous sinks
+ *
+ * - all of the messages are in the file once the logging is closed
+ * - each message has the event number of the thread that made it
+ * - messages below the level of the file are not written
+ */
+TEST_CASE("Logger", "[Framework][functionality]") {
+  using framework::logging::Formatter;
+
+  const std::string log_file{"test_logger.log"};
+  const int n_messages{1000};
+
+  framework::config::Parameters p;
+  p.addParameter<int>("fileLevel", 1);
+  p.addParameter<std::string>("filePath", log_file);
+  p.addParameter<int>("termLevel", 4);
+  p.addParameter<std::string>("overflow", "block");
+  framework::logging::open(p);
+
+  auto log = [&](int event_number) {
+    auto theLog_{framework::logging::makeLogger("test")};
+    Formatter::set(event_number);
+    for (int i{0}; i < n_messages; i++) {
+      if (i % 2 == 0)
+        ldmx_log(info) << "even";
+      else
+        ldmx_log(debug) << "odd";
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int event_number{1}; event_number < 4; event_number++) {
+    threads.emplace_back(log, event_number);
+  }
+  for (auto& t : threads) t.join();
+
+  framework::logging::close();
+
+  std::ifstream f(log_file);
+  std::vector<int> n_lines(4, 0);
+  for (std::string line; std::getline(f, line);) {
+    CHECK(line.find("[ test ]") == 0);
+    CHECK(line.find("info: even") != std::string::npos);
+    int event_number{std::stoi(line.substr(9))};
+    REQUIRE(event_number >= 1);
+    REQUIRE(event_number < 4);
+    n_lines[event_number]++;
+  }
+  CHECK(n_lines == std::vector<int>{0, n_messages / 2, n_messages / 2,
+                                    n_messages / 2});
+
+  CHECK_THROWS([]() {
+    framework::config::Parameters bad;
+    bad.addParameter<std::string>("overflow", "wait");
+    framework::logging::open(bad);
+  }());
+  framework::logging::close();
+
+  std::remove(log_file.c_str());
+}
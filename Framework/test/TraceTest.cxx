@@ -0,0 +1,100 @@
+/**
+ * @file TraceTest.cxx
+ * @brief Test the recording of spans and their export as JSON
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>  //for remove
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Framework/Performance/Trace.h"
+
+/**
+ * Count the number of times a piece of text appears in a file
+ */
+static int count(const std::string& file_name, const std::string& text) {
+  std::ifstream f(file_name);
+  std::stringstream ss;
+  ss << f.rdbuf();
+  std::string content{ss.str()};
+  int n{0};
+  for (auto pos{content.find(text)}; pos != std::string::npos;
+       pos = content.find(text, pos + text.size()))
+    n++;
+  return n;
+}
+
+/**
+ * Test for recording spans on several threads
+ *
+ * Lane zero is small enough to wrap around and only the
+ * spans of one out of two events are kept. Threads without
+ * a lane are ignored.
+ */
+TEST_CASE("Trace", "[Framework][functionality]") {
+  using framework::performance::Trace;
+  using framework::performance::Callback;
+
+  const std::string trace_file{"test_trace.json"};
+  auto& trace{Trace::get()};
+
+  SECTION("nothing is recorded when closed") {
+    CHECK_FALSE(Trace::enabled());
+    CHECK_FALSE(Trace::active());
+    { Trace::Span span("test", "closed"); }
+    CHECK(trace.close(trace_file));
+  }
+
+  SECTION("spans are recorded into lanes") {
+    trace.open(2, 5, 2);
+    CHECK(Trace::enabled());
+    const char* name{trace.name("proc")};
+    CHECK(name == trace.name(std::string("proc")));
+
+    // seven spans on lane zero, only the last five are kept
+    for (int i{0}; i < 7; i++) {
+      Trace::Span span(Callback::onNewRun, name);
+    }
+
+    // assertions are made on the main thread
+    std::vector<bool> active;
+    std::thread worker([&]() {
+      Trace::useLane(1);
+      for (int i_event{0}; i_event < 4; i_event++) {
+        Trace::EventScope event(i_event, 100 + i_event);
+        active.push_back(Trace::active());
+        Trace::Span span(Callback::process, name);
+      }
+      // outside of events, spans are always kept
+      active.push_back(Trace::active());
+      Trace::Span span("io", "read");
+    });
+    worker.join();
+
+    // a thread without a lane doesn't record anything
+    std::thread stray([]() { Trace::Span span("io", "stray"); });
+    stray.join();
+
+    CHECK(active == std::vector<bool>{true, false, true, false, true});
+
+    CHECK(trace.close(trace_file));
+    CHECK_FALSE(Trace::enabled());
+
+    // two sampled events with one processor and one read on the worker
+    CHECK(count(trace_file, "\"ph\":\"X\"") == 5 + 2 * 2 + 1);
+    CHECK(count(trace_file, "\"cat\":\"onNewRun\"") == 5);
+    CHECK(count(trace_file, "\"recorded\":7") == 1);
+    CHECK(count(trace_file, "\"cat\":\"process\"") == 2);
+    CHECK(count(trace_file, "\"event\":100") == 2);
+    CHECK(count(trace_file, "\"event\":101") == 0);
+    CHECK(count(trace_file, "\"event\":102") == 2);
+    CHECK(count(trace_file, "\"name\":\"read\"") == 1);
+    CHECK(count(trace_file, "\"name\":\"stray\"") == 0);
+  }
+
+  remove(trace_file.c_str());
+
+  CHECK_THROWS(trace.open(1, 0, 1));
+}
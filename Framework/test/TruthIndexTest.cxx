@@ -0,0 +1,94 @@
+/**
+ * @file TruthIndexTest.cxx
+ * @brief Test the per-event index into the truth information
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <vector>
+
+#include "DetDescr/SimSpecialID.h"
+#include "Framework/Event.h"
+#include "Framework/TruthIndex.h"
+
+/**
+ * Make a scoring plane hit
+ */
+static ldmx::SimTrackerHit makeHit(int track_id, int plane, float z, float px,
+                                   float pz) {
+  ldmx::SimTrackerHit hit;
+  hit.setID(ldmx::SimSpecialID::ScoringPlaneID(plane).raw());
+  hit.setTrackID(track_id);
+  hit.setPosition(0., 0., z);
+  hit.setMomentum(px, 0., pz);
+  return hit;
+}
+
+/**
+ * Test for the lookups of the TruthIndex
+ *
+ * - particles are indexed by track ID with only the saved daughters
+ * - hits of a track on a plane are in the order of the collection
+ * - the recoil hit is the one with the largest forward momentum
+ * - adding products updates the index
+ */
+TEST_CASE("TruthIndex", "[Framework][functionality]") {
+  using framework::TruthIndex;
+
+  framework::Event event("test");
+
+  std::map<int, ldmx::SimParticle> particles;
+  particles[1].setPdgID(11);
+  particles[1].addDaughter(2);
+  particles[1].addDaughter(5);  // not saved
+  particles[1].addDaughter(3);
+  particles[2].setPdgID(22);
+  particles[2].addParent(1);
+  particles[3].setPdgID(11);
+  particles[3].addParent(1);
+  event.add("SimParticles", particles);
+
+  std::vector<ldmx::SimTrackerHit> target{
+      makeHit(1, 1, 1., 0., 10.), makeHit(2, 1, 1., 0., 5.),
+      makeHit(1, 1, 1., 0., 20.), makeHit(1, 0, -1., 0., 30.),
+      makeHit(1, 1, 1., 0., -50.)};
+  event.add("TargetScoringPlaneHits", target);
+
+  const auto& truth{event.getDerived<TruthIndex>()};
+
+  CHECK(truth.getNumParticles() == 3);
+  CHECK(truth.getIndex(3) == 2);
+  CHECK(truth.getIndex(5) == -1);
+  CHECK(truth.findParticle(5) == nullptr);
+  CHECK(truth.getTrackID(1) == 2);
+
+  auto daughters{truth.getDaughters(truth.getIndex(1))};
+  REQUIRE(daughters.size() == 2);
+  CHECK(daughters[0] == truth.getIndex(2));
+  CHECK(daughters[1] == truth.getIndex(3));
+  CHECK(truth.getParents(truth.getIndex(3)).size() == 1);
+
+  CHECK(truth.getRecoilTrackID() == 1);
+
+  const auto& target_hits{event.getCollection<ldmx::SimTrackerHit>(
+      TruthIndex::TARGET_SP_HITS)};
+  auto on_plane{truth.getScoringPlaneHits(TruthIndex::TARGET_SP_HITS, 1, 1)};
+  REQUIRE(on_plane.size() == 3);
+  CHECK(on_plane[0] == 0);
+  CHECK(on_plane[1] == 2);
+  CHECK(on_plane[2] == 4);
+  CHECK(truth.getScoringPlaneHits(TruthIndex::TARGET_SP_HITS, 1).size() == 4);
+  CHECK(truth.getScoringPlaneHits(TruthIndex::ECAL_SP_HITS, 1).empty());
+
+  CHECK(truth.getRecoilAtTarget() == &target_hits[2]);
+  CHECK(truth.getRecoilAtEcal() == nullptr);
+
+  std::vector<ldmx::SimTrackerHit> ecal{makeHit(1, 31, 200., 0., 3.),
+                                        makeHit(1, 31, 200., 1., 3.)};
+  event.add("EcalScoringPlaneHits", ecal);
+
+  // same object, updated for the new product
+  CHECK(&event.getDerived<TruthIndex>() == &truth);
+  CHECK(truth.getRecoilAtEcal() ==
+        &event.getCollection<ldmx::SimTrackerHit>(
+            TruthIndex::ECAL_SP_HITS)[1]);
+}
@@ -39,7 +39,6 @@ from LDMX.DQM import dqm
 import os
 from LDMX.Hcal.DetectorMap import HcalDetectorMap
 detmap = HcalDetectorMap(f'{os.environ["LDMX_BASE"]}/ldmx-sw/Hcal/data/testbeam_connections.csv')
-detmap.want_d2e = True # helps quicken the det -> elec translation                                                                                                                                                                                                                                                                                                   
 
 # extract and deduce parameters from input file name                                                                                                                                                                                                                                                                                                                 
 params = os.path.basename(arg.input_file).replace('.root','').split('_')
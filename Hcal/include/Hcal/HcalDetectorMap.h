@@ -40,11 +40,9 @@ class HcalDetectorMap
   /**
    * Default constructor which builds the necessary maps.
    *
-   * @param[in] want_d2e true if we want to build a reverse mapping
-   * Building a reverse (detector->electronics) map takes extra time
-   * and memory so it should be off by default.
+   * @param[in] connections_table path to table of connections in Hcal
    */
-  HcalDetectorMap(const std::string& connections_table, bool want_d2e);
+  HcalDetectorMap(const std::string& connections_table);
 
   /// Provider which loads the map
   friend class HcalDetectorMapLoader;
@@ -13,6 +13,7 @@
 #include "DetDescr/HcalDigiID.h"
 #include "DetDescr/HcalGeometry.h"
 #include "DetDescr/HcalID.h"
+#include "Framework/ConditionHandle.h"
 #include "Framework/EventProcessor.h"
 #include "Recon/Event/EventConstants.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
@@ -95,6 +96,14 @@ class HcalDigiProducer : public framework::Producer {
 
   /// Generates Gaussian noise on top of real hits
   std::unique_ptr<TRandom3> noiseInjector_;
+
+  /// Conditions of the readout chips
+  framework::ConditionHandle<conditions::DoubleTableCondition>
+      hgcrocConditions_{"HcalHgcrocConditions"};
+
+  /// Geometry of the hcal
+  framework::ConditionHandle<ldmx::HcalGeometry> geometry_{
+      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME};
 };
 }  // namespace hcal
 
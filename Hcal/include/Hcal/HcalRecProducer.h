@@ -23,14 +23,9 @@
 #include "DetDescr/HcalGeometry.h"
 #include "DetDescr/HcalID.h"
 #include "Framework/EventProcessor.h"
+#include "Hcal/InterpolationTable.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 
-//---------//
-//  ROOT   //
-//---------//
-#include "TF1.h"
-#include "TGraph.h"
-
 namespace hcal {
 
 /**
@@ -104,16 +99,13 @@ class HcalRecProducer : public framework::Producer {
   /// Strip attenuation length [m]
   double attlength_;
 
-  /// Pulse function
-  mutable TF1 pulseFunc_;
-
   /**
    * Correction to the pulse's measured amplitude at the peak.
    * The correction is calculated by comparing the amplitude at the sample time
    *(T) over its correct value (1.0) with the ratio between sample T and sample
    *T+25ns.
    **/
-  mutable TGraph correctionAmpl_;
+  InterpolationTable correctionAmpl_;
 
   /**
    * Correction to the measured TOA relative to the peak.
@@ -124,7 +116,7 @@ class HcalRecProducer : public framework::Producer {
    * TOA threshold) with the amplitude at the sample time (T) over its correct
    * value (1.0).
    */
-  mutable TGraph correctionTOA_;
+  InterpolationTable correctionTOA_;
 
   /// Minimum amplitude fraction to apply amplitude correction
   double minAmplFraction_;
@@ -0,0 +1,90 @@
+/**
+ * @file InterpolationTable.h
+ * @brief Flat table for linear interpolation of a sampled curve
+ */
+
+#ifndef HCAL_INTERPOLATIONTABLE_H_
+#define HCAL_INTERPOLATIONTABLE_H_
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace hcal {
+
+/**
+ * @class InterpolationTable
+ * @brief Linear interpolation between knots stored in flat arrays
+ *
+ * The knots are sorted in x so a lookup is a binary search followed by
+ * a linear interpolation between the two neighbouring knots. Outside
+ * of the range of the knots, the first or last segment is extrapolated
+ * linearly, like TGraph::Eval does.
+ *
+ * The knots are chosen by sampling a parametric curve (x(t), y(t))
+ * adaptively: an interval in t is split in two as long as the linear
+ * interpolation between its ends misses the curve at its middle by
+ * more than the requested tolerance in y.
+ */
+class InterpolationTable {
+ public:
+  /// A curve maps its parameter t to a point (x, y)
+  using Curve = std::function<std::pair<double, double>(double)>;
+
+  /// Empty table, evaluates to zero everywhere
+  InterpolationTable() = default;
+
+  /**
+   * Sample the input curve on the parameter interval [begin, end]
+   *
+   * The curve is required to be monotonic in x along the interval,
+   * it can be increasing or decreasing.
+   *
+   * @param[in] curve parametric curve to sample
+   * @param[in] begin first value of the curve parameter
+   * @param[in] end last value of the curve parameter
+   * @param[in] tolerance maximum difference in y between the table and
+   * the curve at the middle of each segment
+   * @param[in] n_seed number of uniform intervals to start refining from
+   */
+  InterpolationTable(const Curve& curve, double begin, double end,
+                     double tolerance, int n_seed = 64);
+
+  /**
+   * Evaluate the table
+   *
+   * @param[in] x position to evaluate at
+   * @return y linearly interpolated between the neighbouring knots
+   */
+  double operator()(double x) const;
+
+  /// @return number of knots in the table
+  std::size_t size() const { return x_.size(); }
+
+  /// @return smallest x of the knots
+  double minX() const { return x_.front(); }
+
+  /// @return y of the knot with the smallest x
+  double yAtMinX() const { return y_.front(); }
+
+ private:
+  /**
+   * Add the knots needed to describe the curve between two knots
+   *
+   * The knot at the start of the interval has already been added,
+   * the knot at the end of the interval is not added.
+   */
+  void refine(const Curve& curve, double t0, double t1,
+              const std::pair<double, double>& p0,
+              const std::pair<double, double>& p1, double tolerance,
+              int depth);
+
+  /// x of knots
+  std::vector<double> x_;
+  /// y of knots
+  std::vector<double> y_;
+};  // InterpolationTable
+
+}  // namespace hcal
+
+#endif  // HCAL_INTERPOLATIONTABLE_H_
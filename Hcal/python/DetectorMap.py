@@ -11,11 +11,11 @@ class HcalDetectorMap(ldmxcfg.ConditionsObjectProvider) :
     connections_table : str
         Path to table of connections in Hcal
     want_d2e : bool
-        Flag determining if we should spend the time to create a detID->EID LUT
+        Deprecated and ignored, the detector ID to electronics ID lookup
+        is always built
     """
 
     def __init__(self, connections_table, want_d2e = False) :
         super().__init__('HcalDetectorMap','hcal::HcalDetectorMapLoader','Hcal')
         self.connections_table = connections_table
-        self.want_d2e = want_d2e
 
@@ -15,7 +15,6 @@ class HcalDetectorMapLoader : public framework::ConditionsObjectProvider {
       : ConditionsObjectProvider(HcalDetectorMap::CONDITIONS_OBJECT_NAME,
                                  tagname, parameters, process),
         the_map_{nullptr} {
-    want_d2e_ = parameters.getParameter<bool>("want_d2e");
     connections_table_ =
         parameters.getParameter<std::string>("connections_table");
   }
@@ -24,7 +23,7 @@ class HcalDetectorMapLoader : public framework::ConditionsObjectProvider {
                     framework::ConditionsIOV>
   getCondition(const ldmx::EventHeader& context) {
     if (!the_map_) {
-      the_map_ = new HcalDetectorMap(connections_table_, want_d2e_);
+      the_map_ = new HcalDetectorMap(connections_table_);
     }
 
     return std::make_pair(
@@ -41,14 +40,11 @@ class HcalDetectorMapLoader : public framework::ConditionsObjectProvider {
  private:
   HcalDetectorMap* the_map_;
   std::string connections_table_;
-  bool want_d2e_;
 };
 
-HcalDetectorMap::HcalDetectorMap(const std::string& connections_table,
-                                 bool want_d2e)
+HcalDetectorMap::HcalDetectorMap(const std::string& connections_table)
     : framework::ConditionsObject(CONDITIONS_OBJECT_NAME),
-      ldmx::ElectronicsMap<ldmx::HcalElectronicsID, ldmx::HcalDigiID>(
-          want_d2e) {
+      ldmx::ElectronicsMap<ldmx::HcalElectronicsID, ldmx::HcalDigiID>() {
   this->clear();
   conditions::StreamCSVLoader csv(connections_table);
   while (csv.nextRow()) {
@@ -82,12 +82,10 @@ void HcalDigiProducer::produce(framework::Event& event) {
   }
 
   // Get the Hgcroc Conditions
-  hgcroc_->condition(
-      getCondition<conditions::DoubleTableCondition>("HcalHgcrocConditions"));
+  hgcroc_->condition(getCondition(hgcrocConditions_));
 
   // Get the Hcal Geometry
-  const auto& hcalGeometry = getCondition<ldmx::HcalGeometry>(
-      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
+  const auto& hcalGeometry{getCondition(geometry_)};
 
   // Empty collection to be filled
   ldmx::HgcrocDigiCollection hcalDigis;
@@ -131,7 +131,7 @@ void HcalRawDecoder::produce(framework::Event& event) {
     std::cout << "Translating EIDs into DetIDs. Printing skipped EIDs..."
               << std::endl;
 #endif
-    auto detmap{
+    const auto& detmap{
         getCondition<HcalDetectorMap>(HcalDetectorMap::CONDITIONS_OBJECT_NAME)};
     for (auto const& [eid, digi] : eid_to_samples) {
       // The electronics map returns an empty ID of the correct
@@ -7,6 +7,9 @@
 
 #include "Hcal/HcalRecProducer.h"
 
+#include <cmath>
+#include <functional>
+
 #include "Hcal/Event/HcalHit.h"
 #include "Hcal/HcalReconConditions.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
@@ -14,6 +17,27 @@
 
 namespace hcal {
 
+/**
+ * Find the root of a function by bisection
+ *
+ * @param[in] f function changing sign between a and b
+ * @param[in] a start of interval
+ * @param[in] b end of interval
+ * @return position of the root
+ */
+static double bisect(const std::function<double(double)>& f, double a,
+                     double b) {
+  bool negative_at_a{f(a) < 0};
+  for (int i{0}; i < 100 and b - a > 1e-12; i++) {
+    double mid{(a + b) / 2};
+    if ((f(mid) < 0) == negative_at_a)
+      a = mid;
+    else
+      b = mid;
+  }
+  return (a + b) / 2;
+}
+
 HcalRecProducer::HcalRecProducer(const std::string& name,
                                  framework::Process& process)
     : Producer(name, process) {}
@@ -34,53 +58,52 @@ void HcalRecProducer::configure(framework::config::Parameters& ps) {
   attlength_ = ps.getParameter<double>("attenuationLength");
   nADCs_ = ps.getParameter<int>("nADCs");
 
-  // configuring corrections graphs derived on the fly
-  // TODO: maybe we should save these as a graph instead?
+  // configuring corrections tables derived on the fly
   rateUpSlope_ = ps.getParameter<double>("rateUpSlope");
   timeUpSlope_ = ps.getParameter<double>("timeUpSlope");
   rateDnSlope_ = ps.getParameter<double>("rateDnSlope");
   timeDnSlope_ = ps.getParameter<double>("timeDnSlope");
   timePeak_ = ps.getParameter<double>("timePeak");
-  pulseFunc_ =
-      TF1("pulseFunc",
-          "[0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/"
-          "((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))",
-          (double)nADCs_ * clock_cycle_ * -1, (double)nADCs_ * clock_cycle_);
-  pulseFunc_.FixParameter(1, rateUpSlope_);
-  pulseFunc_.FixParameter(2, timeUpSlope_);
-  pulseFunc_.FixParameter(3, timePeak_);
-  pulseFunc_.FixParameter(5, rateDnSlope_);
-  pulseFunc_.FixParameter(6, timeDnSlope_);
-  pulseFunc_.FixParameter(4, 0);
-  pulseFunc_.FixParameter(0, 1);
+
+  // pulse shape with unit amplitude at t = 0
+  auto pulse = [this](double t) {
+    return ((1.0 + exp(rateUpSlope_ * (-timeUpSlope_ + timePeak_))) *
+            (1.0 + exp(rateDnSlope_ * (-timeDnSlope_ + timePeak_)))) /
+           ((1.0 + exp(rateUpSlope_ * (t - timeUpSlope_ + timePeak_))) *
+            (1.0 + exp(rateDnSlope_ * (t - timeDnSlope_ + timePeak_))));
+  };
 
   // build amplitude correction (Ampl[t-1]/Ampl[t]) with pulse-shape
-  int n = 0;
-  for (double t = -clock_cycle_; t < clock_cycle_; t += 0.01) {
-    double ampl_t = pulseFunc_.Eval(t);
-    double ampl_tm1 = pulseFunc_.Eval(t - clock_cycle_);
-    if (ampl_tm1 > ampl_t) continue;
-    correctionAmpl_.SetPoint(n, ampl_tm1 / ampl_t, ampl_t);
-    if (n == 0) minAmplFraction_ = ampl_tm1 / ampl_t;
-    n++;
-  }
+  // from t = -clock_cycle until the sample before stops being smaller
+  double t_end = bisect(
+      [&](double t) { return pulse(t - clock_cycle_) - pulse(t); },
+      -clock_cycle_, clock_cycle_);
+  correctionAmpl_ = InterpolationTable(
+      [&](double t) {
+        return std::make_pair(pulse(t - clock_cycle_) / pulse(t), pulse(t));
+      },
+      -clock_cycle_, t_end, 1e-5);
+  minAmplFraction_ = correctionAmpl_.minX();
 
   // build TOA timewalk correction with pulse-shape
+  // the front edge of a pulse with amplitude A crosses the threshold at the
+  // time t where A*pulse(t) = threshold, so we walk along t instead of A
   double toaThreshold = ps.getParameter<double>("avgToaThreshold");
   double gain = ps.getParameter<double>("avgGain");
   double pedestal = ps.getParameter<double>("avgPedestal");
-  n = 0;
-  for (double ampl = toaThreshold + 0.1; ampl < 10000; ampl += 0.01) {
-    pulseFunc_.FixParameter(0, ampl);
-    double ampl_t = gain * pedestal + pulseFunc_.Eval(0);
-    double toa =
-        fabs(pulseFunc_.GetX(toaThreshold, (double)nADCs_ * clock_cycle_ * -1,
-                             (double)nADCs_ * clock_cycle_));
-    correctionTOA_.SetPoint(n, ampl_t, toa);
-    if (n == 0) minAmpl_ = ampl_t;
-    n++;
-  }
-  correctionTOA_.SetBit(TGraph::kIsSortedX);
+  double t_min = (double)nADCs_ * clock_cycle_ * -1;
+  double t_largest = bisect(
+      [&](double t) { return pulse(t) * 10000 - toaThreshold; }, t_min, 0.);
+  double t_smallest = bisect(
+      [&](double t) { return pulse(t) * (toaThreshold + 0.1) - toaThreshold; },
+      t_min, 0.);
+  correctionTOA_ = InterpolationTable(
+      [&](double t) {
+        return std::make_pair(gain * pedestal + toaThreshold / pulse(t),
+                              fabs(t));
+      },
+      t_largest, t_smallest, 1e-4);
+  minAmpl_ = correctionTOA_.minX();
 }
 
 double HcalRecProducer::getTOA(
@@ -199,8 +222,8 @@ void HcalRecProducer::produce(framework::Event& event) {
         // above the boundary of the correction)
         if (amplTm1_posend / amplT_posend > minAmplFraction_ &&
             amplTm1_negend / amplT_negend > minAmplFraction_) {
-          amplT_posend *= correctionAmpl_.Eval(amplTm1_posend / amplT_posend);
-          amplT_negend *= correctionAmpl_.Eval(amplTm1_negend / amplT_negend);
+          amplT_posend *= correctionAmpl_(amplTm1_posend / amplT_posend);
+          amplT_negend *= correctionAmpl_(amplTm1_negend / amplT_negend);
         }
 
         // set voltage
@@ -222,8 +245,8 @@ void HcalRecProducer::produce(framework::Event& event) {
       // correction otherwise, one TOA gets corrected and the other does not,
       // which results in a large TOA difference and an out-of-bounds position
       if (amplT_posend > minAmpl_ && amplT_negend > minAmpl_) {
-        TOA_posend = correctionTOA_.Eval(amplT_posend) - TOA_posend;
-        TOA_negend = correctionTOA_.Eval(amplT_negend) - TOA_negend;
+        TOA_posend = correctionTOA_(amplT_posend) - TOA_posend;
+        TOA_negend = correctionTOA_(amplT_negend) - TOA_negend;
       }
 
       // get x(y) coordinate from TOA measurement = (dt*v/2)
@@ -310,7 +333,7 @@ void HcalRecProducer::produce(framework::Event& event) {
           getTOA(digi_posend, the_conditions.adcPedestal(id_posend), iSOI);
 
       // correct TOA
-      TOA = correctionTOA_.Eval(amplT) - TOA;
+      TOA = correctionTOA_(amplT) - TOA;
 
       // set hit time
       hitTime = TOA;  // ns
@@ -0,0 +1,60 @@
+#include "Hcal/InterpolationTable.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hcal {
+
+/// Maximum number of times a seed interval is split in two
+static const int MAX_REFINE_DEPTH{24};
+
+InterpolationTable::InterpolationTable(const Curve& curve, double begin,
+                                       double end, double tolerance,
+                                       int n_seed) {
+  std::vector<std::pair<double, double>> seeds;
+  for (int i{0}; i <= n_seed; i++)
+    seeds.push_back(curve(begin + (end - begin) * i / n_seed));
+
+  x_.push_back(seeds.front().first);
+  y_.push_back(seeds.front().second);
+  for (int i{0}; i < n_seed; i++) {
+    refine(curve, begin + (end - begin) * i / n_seed,
+           begin + (end - begin) * (i + 1) / n_seed, seeds[i], seeds[i + 1],
+           tolerance, 0);
+    x_.push_back(seeds[i + 1].first);
+    y_.push_back(seeds[i + 1].second);
+  }
+
+  // curves decreasing in x were added back to front
+  if (x_.size() > 1 and x_.back() < x_.front()) {
+    std::reverse(x_.begin(), x_.end());
+    std::reverse(y_.begin(), y_.end());
+  }
+}
+
+void InterpolationTable::refine(const Curve& curve, double t0, double t1,
+                                const std::pair<double, double>& p0,
+                                const std::pair<double, double>& p1,
+                                double tolerance, int depth) {
+  if (depth >= MAX_REFINE_DEPTH) return;
+  double t{(t0 + t1) / 2};
+  auto p{curve(t)};
+  double y{p0.second + (p.first - p0.first) * (p1.second - p0.second) /
+                           (p1.first - p0.first)};
+  if (std::abs(y - p.second) <= tolerance) return;
+  refine(curve, t0, t, p0, p, tolerance, depth + 1);
+  x_.push_back(p.first);
+  y_.push_back(p.second);
+  refine(curve, t, t1, p, p1, tolerance, depth + 1);
+}
+
+double InterpolationTable::operator()(double x) const {
+  if (x_.size() < 2) return y_.empty() ? 0. : y_.front();
+  // index of the first knot of the segment containing x
+  // first or last segment if x is outside the knots
+  std::size_t i = std::upper_bound(x_.begin(), x_.end(), x) - x_.begin();
+  i = std::min(std::max(i, std::size_t(1)), x_.size() - 1) - 1;
+  return y_[i] + (x - x_[i]) * (y_[i + 1] - y_[i]) / (x_[i + 1] - x_[i]);
+}
+
+}  // namespace hcal
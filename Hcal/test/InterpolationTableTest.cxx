@@ -0,0 +1,38 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+using Catch::Approx;
+
+#include "Hcal/InterpolationTable.h"
+
+/**
+ * Test for the adaptive sampling and evaluation of the table
+ *
+ * Checks:
+ * - a straight line only needs the seed knots
+ * - a curved function is followed within the tolerance
+ * - curves decreasing in x are sorted
+ * - the end segments are extrapolated linearly
+ */
+TEST_CASE("InterpolationTable", "[Hcal][functionality]") {
+  using hcal::InterpolationTable;
+
+  InterpolationTable line(
+      [](double t) { return std::make_pair(t, 2 * t + 1); }, 0., 10., 1e-6,
+      4);
+  CHECK(line.size() == 5);
+  CHECK(line(2.5) == Approx(6.));
+  CHECK(line(-1.) == Approx(-1.));
+  CHECK(line(12.) == Approx(25.));
+
+  InterpolationTable root(
+      [](double t) { return std::make_pair(t * t, t); }, 3., 0.1, 1e-4);
+  CHECK(root.minX() == Approx(0.01));
+  CHECK(root.yAtMinX() == Approx(0.1));
+  for (double x{0.01}; x < 9.; x += 0.037)
+    CHECK(root(x) == Approx(std::sqrt(x)).margin(2e-4));
+
+  InterpolationTable empty;
+  CHECK(empty(1.) == 0.);
+}
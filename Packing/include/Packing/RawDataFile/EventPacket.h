@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <map>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -55,6 +56,47 @@ class EventPacket {
   uint32_t crc_;
 };  // EventPacket
 
+/**
+ * View of an EventPacket in a block of words
+ *
+ * Only the headers of the subsystem packets are decoded, their data
+ * is handed out as views into the words the event was read from.
+ * The view can be reused for the next event, keeping its memory.
+ */
+class EventPacketView {
+ public:
+  /**
+   * read the event packet at the start of the input words
+   *
+   * @throws Exception if the words end before the packet does
+   * @param[in] words block of words starting with an event packet
+   * @return number of words in the packet
+   */
+  std::size_t read(std::span<const uint32_t> words);
+
+  /**
+   * number of words in the event packet at the start of the input words
+   *
+   * Only the headers are looked at, so this is what is used to
+   * skip over events.
+   *
+   * @throws Exception if the words end before the packet does
+   * @param[in] words block of words starting with an event packet
+   */
+  static std::size_t length(std::span<const uint32_t> words);
+
+  const uint32_t& id() const { return id_; }
+  bool crcOk() const { return crc_ok_; }
+  const uint32_t& crc() const { return crc_; }
+  const std::vector<SubsystemPacketView>& data() const { return subsys_data_; }
+
+ private:
+  uint32_t id_;
+  std::vector<SubsystemPacketView> subsys_data_;
+  bool crc_ok_;
+  uint32_t crc_;
+};  // EventPacketView
+
 }  // namespace rawdatafile
 }  // namespace packing
 
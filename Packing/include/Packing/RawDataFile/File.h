@@ -1,11 +1,14 @@
 #ifndef PACKING_RAWDATAFILE_FILE_H_
 #define PACKING_RAWDATAFILE_FILE_H_
 
+#include <future>
+#include <span>
+
 #include "Framework/Configure/Parameters.h"
 #include "Framework/Event.h"
 #include "Framework/RunHeader.h"
 #include "Packing/RawDataFile/EventPacket.h"
-#include "Packing/Utility/Reader.h"
+#include "Packing/Utility/MappedFile.h"
 #include "Packing/Utility/Writer.h"
 
 namespace packing {
@@ -13,6 +16,13 @@ namespace rawdatafile {
 
 /**
  * The raw data file object
+ *
+ * Input files are mapped into memory and the event packets are read
+ * in place, only the data of each subsystem is copied onto the event bus.
+ * The checksum of the entire input file can be verified up front or,
+ * with the 'verify_in_background' parameter, on another thread while the
+ * events are being processed. In the second case, a failure is only raised
+ * once the end of the file is reached or the file is closed.
  */
 class File {
  public:
@@ -34,6 +44,21 @@ class File {
    */
   bool nextEvent();
 
+  /**
+   * Move to an event in an input file
+   *
+   * The positions of the events are found by skipping from header to
+   * header the first time an event past the ones already read is asked
+   * for, so jumping around the file only looks at the headers.
+   *
+   * @param[in] i_entry index of the event to read next
+   * @return false if this is an output file or the index is past the end
+   */
+  bool seek(uint32_t i_entry);
+
+  /// number of entries in the file
+  uint32_t entries() const { return entries_; }
+
   /**
    * Write the run header
    */
@@ -42,6 +67,10 @@ class File {
   /// close this file
   void close();
 
+ private:
+  /// wait for the background checksum verification and raise if it failed
+  void checkCRC();
+
  private:
   /// are we reading or writing?
   bool is_output_;
@@ -67,8 +96,20 @@ class File {
   framework::Event* event_{nullptr};
   /// run number corresponding to this file of raw data
   uint32_t run_;
-  /// utility class for reading binary data files
-  utility::Reader reader_;
+  /// input file mapped into memory
+  utility::MappedFile mapped_;
+  /// the words of the input file between the header and the footer
+  std::span<const uint32_t> events_;
+  /// position of the next event to read in events_
+  std::size_t i_word_{0};
+  /// positions of the events in events_ that have been found so far
+  std::vector<std::size_t> offsets_;
+  /// event packet read in place from the input file
+  EventPacketView read_event_;
+  /// buffer to put the subsystem data onto the event bus
+  std::vector<uint32_t> buffer_;
+  /// result of the checksum verification running in the background
+  std::future<bool> crc_check_;
   /// utility class for writing binary data files
   utility::Writer writer_;
   /// crc calculator for output mode
@@ -1,6 +1,7 @@
 #ifndef PACKING_RAWDATAFILE_SUBSYSTEMPACKET_H_
 #define PACKING_RAWDATAFILE_SUBSYSTEMPACKET_H_
 
+#include <span>
 #include <vector>
 
 #include "Packing/Utility/CRC.h"
@@ -59,6 +60,42 @@ class SubsystemPacket {
   unsigned int crc_;
 };  // SubsystemPacket
 
+/**
+ * View of a SubsystemPacket in a block of words
+ *
+ * Nothing is copied, the view points into the words it was read from
+ * (for example a utility::MappedFile) and is only valid as long as they are.
+ */
+class SubsystemPacketView {
+ public:
+  /// default constructor for reading
+  SubsystemPacketView() = default;
+
+  /**
+   * read the subsystem packet at the start of the input words
+   *
+   * @throws Exception if the words end before the packet does
+   * @param[in] words block of words starting with a subsystem packet
+   * @return number of words in the packet
+   */
+  std::size_t read(std::span<const uint32_t> words);
+
+  const uint16_t& id() const { return id_; }
+  const uint32_t& event() const { return event_; }
+  bool crcOk() const { return crc_ok_; }
+  const uint32_t& crc() const { return crc_; }
+
+  /// Get view of the data
+  std::span<const uint32_t> data() const { return data_; }
+
+ private:
+  uint32_t event_;
+  uint16_t id_;
+  std::span<const uint32_t> data_;
+  bool crc_ok_;
+  uint32_t crc_;
+};  // SubsystemPacketView
+
 }  // namespace rawdatafile
 }  // namespace packing
 
@@ -63,6 +63,13 @@ class BufferReader {
     return *this;
   }
 
+  /**
+   * Tell us where the reader is
+   *
+   * @return number of bytes read from the beginning of the buffer
+   */
+  std::size_t tell() const { return i_word_; }
+
  private:
   /**
    * Go to next word in buffer.
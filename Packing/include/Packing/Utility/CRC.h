@@ -1,17 +1,53 @@
 #ifndef PACKING_UTILITY_CRC_H_
 #define PACKING_UTILITY_CRC_H_
 
-#include <boost/crc.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 namespace packing {
 namespace utility {
 
+namespace crc32 {
+
+/// reversed CRC-32 polynomial
+inline constexpr uint32_t POLYNOMIAL{0xEDB88320};
+
+/**
+ * The lookup tables for slicing-by-8
+ *
+ * tables[0] is the usual byte-wise table and tables[k] advances the
+ * checksum of a byte by k more zero bytes.
+ */
+inline constexpr auto TABLES = [] {
+  std::array<std::array<uint32_t, 256>, 8> tables{};
+  for (uint32_t i{0}; i < 256; i++) {
+    uint32_t c{i};
+    for (int bit{0}; bit < 8; bit++) {
+      c = (c & 1) ? (c >> 1) ^ POLYNOMIAL : c >> 1;
+    }
+    tables[0][i] = c;
+  }
+  for (uint32_t i{0}; i < 256; i++) {
+    for (std::size_t k{1}; k < 8; k++) {
+      uint32_t prev{tables[k - 1][i]};
+      tables[k][i] = (prev >> 8) ^ tables[0][prev & 0xFF];
+    }
+  }
+  return tables;
+}();
+
+}  // namespace crc32
+
 /**
  * @class CRC
  *
  * The HGC ROC and FPGA use a CRC checksum to double check that the
- * data transfer has been done correctly. Boost has a CRC checksum
- * library that we can use to do this checking here as well.
+ * data transfer has been done correctly. This calculator computes the
+ * same CRC-32 checksum as boost::crc_32_type (the one of zlib and
+ * ethernet) so that we can do this checking here as well.
  *
  * Idea for this helper struct was found on StackOverflow
  * https://stackoverflow.com/a/63237679
@@ -44,8 +80,23 @@ namespace utility {
  *  1. Integral types (e.g. bool, int, unsigned int, long, char, ...)
  *  2. Classes with the 'CRC& add(CRC&)' method defined
  *  3. A std::vector of objects in (1) or (2)
+ *  4. A std::span of objects in (1), processed as one block
  * This means you will get a compiler error if you attempt to stream an
  * object not fitting into one of these categories.
+ *
+ * ## Performance
+ *
+ * The checksum is computed eight bytes at a time with lookup tables
+ * (slicing-by-8) that are generated at compile time, so large blocks
+ * handed over with update are processed much faster than one word at a
+ * time. When a checksum covers sub-blocks that have their own checksums
+ * (like the FPGA and link checksums of the ECal and HCal DAQ), both
+ * checksums of a sub-block can be computed side by side in one pass.
+ *
+ *  CRC fpga, link;
+ *  fpga.update(header);
+ *  link.update(link_words, fpga);
+ *  fpga << link.get();
  */
 class CRC {
  public:
@@ -63,7 +114,7 @@ class CRC {
   template <typename WordType,
             std::enable_if_t<std::is_integral<WordType>::value, bool> = true>
   CRC& operator<<(const WordType& w) {
-    crc.process_bytes(&w, sizeof(WordType));
+    process(reinterpret_cast<const unsigned char*>(&w), sizeof(WordType));
     return *this;
   }
 
@@ -92,14 +143,67 @@ class CRC {
    *
    * When the compiler deduces that the input to the stream is a vector,
    * we simply call the stream operator on all members of the vector in
-   * sequence.
+   * sequence. Vectors of integral types are processed as one block.
    *
    * @param[in] vec vector of objects to insert into calculator
    * @return CRC modified calculator
    */
   template <typename ContentType>
   CRC& operator<<(const std::vector<ContentType>& vec) {
-    for (auto const& w : vec) *this << w;
+    if constexpr (std::is_integral<ContentType>::value and
+                  not std::is_same<ContentType, bool>::value) {
+      return update(std::span<const ContentType>(vec));
+    } else {
+      for (auto const& w : vec) *this << w;
+      return *this;
+    }
+  }
+
+  /**
+   * Stream a block of words into the calculator
+   *
+   * @see update
+   * @param[in] words view of the words to insert into calculator
+   * @return CRC modified calculator
+   */
+  template <typename WordType,
+            std::enable_if_t<std::is_integral<WordType>::value, bool> = true>
+  CRC& operator<<(std::span<const WordType> words) {
+    return update(words);
+  }
+
+  /**
+   * Insert a block of words into the calculator
+   *
+   * The words are processed in their order in memory, giving the
+   * same checksum as streaming them in one at a time.
+   *
+   * @param[in] words view of the words to insert into calculator
+   * @return CRC modified calculator
+   */
+  template <typename WordType,
+            std::enable_if_t<std::is_integral<WordType>::value, bool> = true>
+  CRC& update(std::span<const WordType> words) {
+    process(reinterpret_cast<const unsigned char*>(words.data()),
+            words.size_bytes());
+    return *this;
+  }
+
+  /**
+   * Insert a block of words into this and another calculator
+   *
+   * The two checksums are computed in the same pass over the words,
+   * which is faster than inserting the words into each of them.
+   *
+   * @param[in] words view of the words to insert into the calculators
+   * @param[in,out] other other calculator to insert the words into
+   * @return CRC modified calculator
+   */
+  template <typename WordType,
+            std::enable_if_t<std::is_integral<WordType>::value, bool> = true>
+  CRC& update(std::span<const WordType> words, CRC& other) {
+    process(reinterpret_cast<const unsigned char*>(words.data()),
+            words.size_bytes(), other);
     return *this;
   }
 
@@ -107,11 +211,92 @@ class CRC {
    * Get the calculate checksum from the calculator
    * @return uint32_t checksum
    */
-  uint32_t get() { return crc.checksum(); }
+  uint32_t get() const { return ~reg_; }
+
+ private:
+  /**
+   * Process bytes eight at a time, then four and then one at a time
+   *
+   * @param[in] p pointer to first byte
+   * @param[in] n number of bytes
+   */
+  void process(const unsigned char* p, std::size_t n) {
+    uint32_t c{reg_};
+    for (; n >= 8; n -= 8, p += 8) c = step8(c, p);
+    if (n >= 4) {
+      c = step4(c, p);
+      n -= 4;
+      p += 4;
+    }
+    for (; n > 0; n--, p++) c = step1(c, *p);
+    reg_ = c;
+  }
+
+  /**
+   * Process bytes into this and another calculator
+   *
+   * The two registers don't depend on each other, so their lookups
+   * are interleaved by the processor.
+   *
+   * @param[in] p pointer to first byte
+   * @param[in] n number of bytes
+   * @param[in,out] other other calculator
+   */
+  void process(const unsigned char* p, std::size_t n, CRC& other) {
+    uint32_t c{reg_}, d{other.reg_};
+    for (; n >= 8; n -= 8, p += 8) {
+      c = step8(c, p);
+      d = step8(d, p);
+    }
+    if (n >= 4) {
+      c = step4(c, p);
+      d = step4(d, p);
+      n -= 4;
+      p += 4;
+    }
+    for (; n > 0; n--, p++) {
+      c = step1(c, *p);
+      d = step1(d, *p);
+    }
+    reg_ = c;
+    other.reg_ = d;
+  }
+
+  /**
+   * Four bytes starting at p as a little-endian word
+   *
+   * This compiles down to a plain load on little-endian machines.
+   */
+  static uint32_t load(const unsigned char* p) {
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 |
+           uint32_t(p[3]) << 24;
+  }
+
+  /// advance register c by the eight bytes starting at p
+  static uint32_t step8(uint32_t c, const unsigned char* p) {
+    const auto& t{crc32::TABLES};
+    uint32_t lo{c ^ load(p)}, hi{load(p + 4)};
+    return t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^
+           t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^ t[3][hi & 0xFF] ^
+           t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+  }
+
+  /// advance register c by the four bytes starting at p
+  static uint32_t step4(uint32_t c, const unsigned char* p) {
+    const auto& t{crc32::TABLES};
+    c ^= load(p);
+    return t[3][c & 0xFF] ^ t[2][(c >> 8) & 0xFF] ^ t[1][(c >> 16) & 0xFF] ^
+           t[0][c >> 24];
+  }
+
+  /// advance register c by one byte
+  static uint32_t step1(uint32_t c, unsigned char b) {
+    return (c >> 8) ^ crc32::TABLES[0][(c ^ b) & 0xFF];
+  }
 
  private:
-  /// the object from Boost doing the summing
-  boost::crc_32_type crc;
+  /// the running checksum register, inverted
+  uint32_t reg_{0xFFFFFFFF};
 };  // CRC
 
 }  // namespace utility
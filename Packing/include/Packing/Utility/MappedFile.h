@@ -0,0 +1,117 @@
+#ifndef PACKING_UTILITY_MAPPEDFILE_H_
+#define PACKING_UTILITY_MAPPEDFILE_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace packing {
+namespace utility {
+
+/**
+ * @class MappedFile
+ * Reading a raw data file by mapping it into memory.
+ *
+ * The whole file is mapped read-only, so that the words of the file
+ * can be looked at in place through std::span views instead of being
+ * copied out word by word like the Reader does. The operating system
+ * pages the file in as it is looked at, so this works for files much
+ * larger than the available memory.
+ *
+ *    MappedFile f("my_data.raw");
+ *    if (f) {
+ *      std::span<const uint32_t> words{f.words<uint32_t>()};
+ *    }
+ *
+ * The views are only valid as long as the file stays open.
+ */
+class MappedFile {
+ public:
+  /// default constructor, no file is open
+  MappedFile() = default;
+
+  /**
+   * Constructor that also opens the input file
+   * @see open
+   * @param[in] file_name full path to the file we are going to open
+   */
+  MappedFile(const std::string& file_name) { this->open(file_name); }
+
+  /// the mapping can't be shared
+  MappedFile(const MappedFile&) = delete;
+  /// the mapping can't be shared
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// destructor, unmap the file
+  ~MappedFile() { close(); }
+
+  /**
+   * Open and map a file
+   *
+   * The pages are read ahead since the file is usually read
+   * from beginning to end.
+   *
+   * @param[in] file_name full path to the file we are going to open
+   * @return true if the file was mapped
+   */
+  bool open(const std::string& file_name) {
+    close();
+    int fd{::open(file_name.c_str(), O_RDONLY)};
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 and st.st_size > 0) {
+      void* addr{::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+      if (addr != MAP_FAILED) {
+        ::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+        data_ = static_cast<const unsigned char*>(addr);
+        size_ = st.st_size;
+      }
+    }
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    return data_ != nullptr;
+  }
+
+  /// unmap the file if one is open
+  void close() {
+    if (data_) ::munmap(const_cast<unsigned char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  /// size of the file in bytes
+  std::size_t size() const { return size_; }
+
+  /**
+   * View the file as a series of words
+   *
+   * Trailing bytes that don't fill a whole word are not included.
+   *
+   * @tparam[in] WordType integral-type to view the file as
+   * @return view of all of the words in the file
+   */
+  template <typename WordType>
+  std::span<const WordType> words() const {
+    return {reinterpret_cast<const WordType*>(data_),
+            size_ / sizeof(WordType)};
+  }
+
+  /// true if a file is mapped
+  operator bool() const { return data_ != nullptr; }
+
+ private:
+  /// start of the mapped file
+  const unsigned char* data_{nullptr};
+  /// size of the mapped file in bytes
+  std::size_t size_{0};
+};  // MappedFile
+
+}  // namespace utility
+}  // namespace packing
+
+#endif  // PACKING_UTILITY_MAPPEDFILE_H_
@@ -15,6 +15,8 @@ class RawDataFile() :
         self.triggerpad_object_name = "TriggerPadRaw"
         self.pass_name = ""
         self.skip_unavailable = True
+        self.verify_checksum = False
+        self.verify_in_background = False
 
 class RawIO(ldmxcfg.Producer) :
     """Producer which runs a single raw data file for input/output
@@ -1,6 +1,7 @@
 
 #include "Packing/RawDataFile/EventPacket.h"
 
+#include "Framework/Exception/Exception.h"
 #include "Packing/Utility/Mask.h"
 
 namespace packing {
@@ -62,5 +63,54 @@ utility::CRC& EventPacket::add(utility::CRC& c) const {
   return c;
 }
 
+std::size_t EventPacketView::read(std::span<const uint32_t> words) {
+  if (words.size() < 2) {
+    EXCEPTION_RAISE("RawFileTrunc", "Event packet header is truncated.");
+  }
+
+  id_ = words[0];
+
+  uint32_t word{words[1]};
+  uint16_t num_subsys = (word >> 16) & utility::mask<16>;
+  crc_ok_ = word & utility::mask<1>;
+
+  subsys_data_.resize(num_subsys);
+  std::size_t i_word{2};
+  for (auto& subsys : subsys_data_) {
+    i_word += subsys.read(words.subspan(i_word));
+  }
+
+  if (i_word >= words.size()) {
+    EXCEPTION_RAISE("RawFileTrunc",
+                    "Event packet " + std::to_string(id_) + " is truncated.");
+  }
+
+  crc_ = words[i_word];
+
+  return i_word + 1;
+}
+
+std::size_t EventPacketView::length(std::span<const uint32_t> words) {
+  if (words.size() < 2) {
+    EXCEPTION_RAISE("RawFileTrunc", "Event packet header is truncated.");
+  }
+
+  uint16_t num_subsys = (words[1] >> 16) & utility::mask<16>;
+
+  // hop from subsystem header to subsystem header
+  std::size_t i_word{2};
+  for (uint16_t i_subsys{0}; i_subsys < num_subsys; i_subsys++) {
+    if (i_word >= words.size()) break;
+    i_word += ((words[i_word] >> 1) & utility::mask<15>) + 3;
+  }
+
+  if (i_word >= words.size()) {
+    EXCEPTION_RAISE("RawFileTrunc", "Event packet " + std::to_string(words[0]) +
+                                        " is truncated.");
+  }
+
+  return i_word + 1;
+}
+
 }  // namespace rawdatafile
 }  // namespace packing
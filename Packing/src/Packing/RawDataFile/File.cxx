@@ -28,11 +28,18 @@ File::File(const framework::config::Parameters &ps) {
     entries_ = 0;
     i_entry_ = 0;
   } else {
-    reader_.open(fn);
+    if (not mapped_.open(fn)) {
+      EXCEPTION_RAISE("RawFileOpen", "Unable to open raw file " + fn);
+    }
+    auto words{mapped_.words<uint32_t>()};
+    // header word and the footer of entry count and checksum
+    if (words.size() < 3) {
+      EXCEPTION_RAISE("RawFileTrunc", "Raw file " + fn + " is truncated.");
+    }
+
     // get entry count from file
     // get run id number from file
-    uint32_t word;
-    reader_ >> word;
+    uint32_t word{words.front()};
 
     uint8_t version = word & utility::mask<4>;
     if (version != 0) {
@@ -42,28 +49,25 @@ File::File(const framework::config::Parameters &ps) {
 
     run_ = ((word >> 4) & utility::mask<28>);
 
-    reader_.seek<uint32_t>(-2, std::ios::end);
-    // save EOF in number of 32-bit-width words
-    auto eof{reader_.tell<uint32_t>()};
-    uint32_t crc_read_in;
-    reader_ >> entries_ >> crc_read_in;
+    entries_ = words[words.size() - 2];
+    uint32_t crc_read_in{words.back()};
     i_entry_ = 0;
 
-    reader_.seek<uint32_t>(1, std::ios::beg);
-
-    if (ps.getParameter<bool>("verify_checksum")) {
-      utility::CRC crc;
-      for (auto ifile{reader_.tell<uint32_t>()}; ifile < eof; ifile++) {
-        reader_ >> word;
-        crc << word;
-      }
-
-      if (crc.get() != crc_read_in) {
+    events_ = words.subspan(1, words.size() - 3);
+    i_word_ = 0;
+
+    if (ps.getParameter<bool>("verify_checksum", false)) {
+      auto verify = [events = events_, crc_read_in]() {
+        utility::CRC crc;
+        crc << events;
+        return crc.get() == crc_read_in;
+      };
+      if (ps.getParameter<bool>("verify_in_background", false)) {
+        crc_check_ = std::async(std::launch::async, verify);
+      } else if (not verify()) {
         EXCEPTION_RAISE("CRCNotOk",
                         "Failure to verify CRC checksum of entire input file.");
       }
-
-      reader_.seek<uint32_t>(1, std::ios::beg);
     }  // verify checksum of input file
   }    // input or output file
 }
@@ -98,21 +102,22 @@ bool File::nextEvent() {
     i_entry_++;
   } else {
     // check for EoF
-    if (i_entry_ + 1 > entries_) return false;
+    if (i_entry_ + 1 > entries_) {
+      checkCRC();
+      return false;
+    }
+
+    // remember where the events are as we go
+    if (offsets_.size() == i_entry_) offsets_.push_back(i_word_);
 
     i_entry_++;
 
-    // read buffers from event packet and add to event bus
-    static EventPacket read_event;
-    reader_ >> read_event;
-    if (!reader_) {
-      // ERROR
-      return false;
-    }
+    // read event packet in place and copy its buffers to the event bus
+    i_word_ += read_event_.read(events_.subspan(i_word_));
 
-    event_->getEventHeader().setEventNumber(read_event.id());
+    event_->getEventHeader().setEventNumber(read_event_.id());
 
-    for (auto &subsys : read_event.data()) {
+    for (auto const &subsys : read_event_.data()) {
       // construct name if not provided by default EID mappings
       if (eid_to_name.find(subsys.id()) == eid_to_name.end()) {
         std::cerr << subsys.id() << " unrecognized electronics ID."
@@ -120,12 +125,30 @@ bool File::nextEvent() {
         eid_to_name[subsys.id()] = "EID" + std::to_string(subsys.id());
       }
 
-      event_->add(eid_to_name.at(subsys.id()), subsys.data());
+      buffer_.assign(subsys.data().begin(), subsys.data().end());
+      event_->add(eid_to_name.at(subsys.id()), buffer_);
     }  // loop over subsystems
   }    // input or output
   return true;
 }
 
+bool File::seek(uint32_t i_entry) {
+  if (is_output_ or i_entry >= entries_) return false;
+
+  while (offsets_.size() <= i_entry) {
+    std::size_t i_word{0};
+    if (not offsets_.empty()) {
+      i_word = offsets_.back() +
+               EventPacketView::length(events_.subspan(offsets_.back()));
+    }
+    offsets_.push_back(i_word);
+  }
+
+  i_word_ = offsets_[i_entry];
+  i_entry_ = i_entry;
+  return true;
+}
+
 void File::writeRunHeader(ldmx::RunHeader &header) {
   if (is_output_) {
     // use passed run number
@@ -147,6 +170,15 @@ void File::close() {
     writer_ << entries_;
     crc_ << entries_;
     writer_ << crc_.get();
+  } else {
+    checkCRC();
+  }
+}
+
+void File::checkCRC() {
+  if (crc_check_.valid() and not crc_check_.get()) {
+    EXCEPTION_RAISE("CRCNotOk",
+                    "Failure to verify CRC checksum of entire input file.");
   }
 }
 
@@ -1,6 +1,7 @@
 
 #include "Packing/RawDataFile/SubsystemPacket.h"
 
+#include "Framework/Exception/Exception.h"
 #include "Packing/Utility/Mask.h"
 
 namespace packing {
@@ -54,5 +55,29 @@ utility::CRC& SubsystemPacket::add(utility::CRC& c) const {
   return c;
 }
 
+std::size_t SubsystemPacketView::read(std::span<const uint32_t> words) {
+  if (words.size() < 3) {
+    EXCEPTION_RAISE("RawFileTrunc", "Subsystem packet header is truncated.");
+  }
+
+  uint32_t word{words[0]};
+  id_ = (word >> 16) & utility::mask<16>;
+  uint32_t len = (word >> 1) & utility::mask<15>;
+  crc_ok_ = word & utility::mask<1>;
+
+  event_ = words[1];
+
+  if (words.size() < len + 3) {
+    EXCEPTION_RAISE("RawFileTrunc", "Subsystem packet " + std::to_string(id_) +
+                                        " of event " + std::to_string(event_) +
+                                        " is truncated.");
+  }
+
+  data_ = words.subspan(2, len);
+  crc_ = words[2 + len];
+
+  return len + 3;
+}
+
 }  // namespace rawdatafile
 }  // namespace packing
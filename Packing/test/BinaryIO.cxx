@@ -7,6 +7,7 @@
 #include "Packing/RawDataFile/EventPacket.h"
 #include "Packing/RawDataFile/File.h"
 #include "Packing/RawDataFile/SubsystemPacket.h"
+#include "Packing/Utility/MappedFile.h"
 #include "Packing/Utility/Reader.h"
 #include "Packing/Utility/Writer.h"
 #include "TTree.h"
@@ -103,6 +104,30 @@ TEST_CASE("BinaryIO", "[Packing][functionality]") {
         CHECK(unwrapped_data.at(subsys.id()) == subsys.data());
       }
     }
+
+    SECTION("View") {
+      packing::utility::MappedFile f(test_file);
+      REQUIRE(f);
+      auto words{f.words<uint32_t>()};
+
+      packing::rawdatafile::EventPacketView ep;
+      CHECK(ep.read(words) == words.size());
+      CHECK(packing::rawdatafile::EventPacketView::length(words) ==
+            words.size());
+      CHECK(ep.id() == event);
+      REQUIRE(ep.data().size() == unwrapped_data.size());
+      for (auto& subsys : ep.data()) {
+        REQUIRE(unwrapped_data.find(subsys.id()) != unwrapped_data.end());
+        const auto& expected{unwrapped_data.at(subsys.id())};
+        CHECK(std::equal(expected.begin(), expected.end(),
+                         subsys.data().begin(), subsys.data().end()));
+        // views point into the mapped file
+        CHECK(subsys.data().data() > words.data());
+        CHECK(subsys.data().data() < words.data() + words.size());
+      }
+
+      CHECK_THROWS(ep.read(words.first(words.size() - 1)));
+    }
   }
 
   SECTION("Entire File") {
@@ -183,5 +208,29 @@ TEST_CASE("BinaryIO", "[Packing][functionality]") {
 
       f.close();
     }
+
+    SECTION("Seek") {
+      ps.addParameter("is_output", false);
+      packing::rawdatafile::File f(ps);
+      REQUIRE(f.entries() == n_events);
+
+      framework::Event event("testseek");
+      f.connect(event);
+
+      for (int i{n_events - 1}; i >= 0; i--) {
+        REQUIRE(f.seek(i));
+        REQUIRE(f.nextEvent());
+
+        CHECK(event.getEventNumber() == i_event + i);
+        CHECK(data == event.getCollection<uint32_t>(hcal_object_name));
+
+        event.Clear();
+        event.onEndOfEvent();
+      }
+
+      CHECK_FALSE(f.seek(n_events));
+
+      f.close();
+    }
   }
 }
@@ -0,0 +1,152 @@
+#include "Packing/Utility/CRC.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace packing {
+namespace test {
+
+/// random 32-bit words
+static std::vector<uint32_t> randomWords(std::size_t n) {
+  std::mt19937 gen{42};
+  std::vector<uint32_t> words(n);
+  for (auto& w : words) w = gen();
+  return words;
+}
+
+/**
+ * Time a calculation over the input words and print its throughput
+ *
+ * The first word is changed before each repetition so that the
+ * calculation can't be done only once.
+ *
+ * @param[in] name name of the calculation to print
+ * @param[in] words words to run the calculation over
+ * @param[in] calculation callable computing a checksum of the words
+ * @return the checksum so the calculation isn't optimized away
+ */
+template <typename Calculation>
+static uint32_t throughput(const std::string& name,
+                           std::vector<uint32_t>& words,
+                           Calculation calculation) {
+  const int n_repeat{20};
+  uint32_t sum{0};
+  auto start{std::chrono::steady_clock::now()};
+  for (int i{0}; i < n_repeat; i++) {
+    words[0] = i;
+    sum += calculation(words);
+  }
+  std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                        start};
+  double gb{1e-9 * n_repeat * words.size() * sizeof(uint32_t)};
+  std::cout << name << " : " << gb / elapsed.count() << " GB/s" << std::endl;
+  return sum;
+}
+
+}  // namespace test
+}  // namespace packing
+
+/**
+ * Does our checksum match the CRC-32 standard and is it the
+ * same however the data is handed to it?
+ */
+TEST_CASE("CRC", "[Packing][functionality]") {
+  using packing::utility::CRC;
+
+  SECTION("Standard Check Value") {
+    std::string check{"123456789"};
+    CRC c;
+    c.update(std::span<const char>(check));
+    CHECK(c.get() == 0xCBF43926);
+    CHECK(CRC().get() == 0);
+  }
+
+  auto words{packing::test::randomWords(1001)};
+
+  CRC one_at_a_time;
+  for (uint32_t w : words) one_at_a_time << w;
+
+  SECTION("Block") {
+    CRC block;
+    block.update(std::span<const uint32_t>(words));
+    CHECK(block.get() == one_at_a_time.get());
+    CRC vec;
+    vec << words;
+    CHECK(vec.get() == one_at_a_time.get());
+  }
+
+  SECTION("Side by Side") {
+    std::span<const uint32_t> all(words);
+    CRC fpga, link, link_alone;
+    fpga.update(all.first(3));
+    link.update(all.subspan(3), fpga);
+    link_alone.update(all.subspan(3));
+    CHECK(fpga.get() == one_at_a_time.get());
+    CHECK(link.get() == link_alone.get());
+  }
+}
+
+/**
+ * Throughput of the checksums of a DAQ-like buffer
+ *
+ * The FPGA checksum covers all of the words of the links, each of which
+ * has its own checksum. Run explicitly with
+ *
+ *  run_test "[benchmark]"
+ */
+TEST_CASE("CRC Throughput", "[.][benchmark]") {
+  using packing::utility::CRC;
+  // 64 MB of links of 40 words
+  const std::size_t link_len{40};
+  auto words{packing::test::randomWords(400000 * link_len)};
+
+  uint32_t per_word = packing::test::throughput(
+      "per word, FPGA and link", words, [](const std::vector<uint32_t>& b) {
+        CRC fpga;
+        for (std::size_t i{0}; i < b.size(); i += link_len) {
+          CRC link;
+          for (std::size_t j{i}; j < i + link_len; j++) {
+            fpga << b[j];
+            link << b[j];
+          }
+          fpga << link.get();
+        }
+        return fpga.get();
+      });
+
+  uint32_t side_by_side = packing::test::throughput(
+      "block, FPGA and link side by side", words,
+      [](const std::vector<uint32_t>& b) {
+        std::span<const uint32_t> all(b);
+        CRC fpga;
+        for (std::size_t i{0}; i < b.size(); i += link_len) {
+          CRC link;
+          link.update(all.subspan(i, link_len), fpga);
+          fpga << link.get();
+        }
+        return fpga.get();
+      });
+
+  CHECK(per_word == side_by_side);
+
+  uint32_t per_word_block = packing::test::throughput(
+      "per word", words, [](const std::vector<uint32_t>& b) {
+        CRC c;
+        for (uint32_t w : b) c << w;
+        return c.get();
+      });
+
+  uint32_t block = packing::test::throughput(
+      "block", words, [](const std::vector<uint32_t>& b) {
+        CRC c;
+        c << b;
+        return c.get();
+      });
+
+  CHECK(per_word_block == block);
+}
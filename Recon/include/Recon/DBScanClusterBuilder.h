@@ -7,6 +7,10 @@
 #ifndef DBSCANCLUSTERBUILDER_H
 #define DBSCANCLUSTERBUILDER_H
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "Framework/EventProcessor.h"
 #include "Recon/Event/CaloCluster.h"
 #include "Recon/Event/CalorimeterHit.h"
@@ -17,6 +21,13 @@ namespace recon {
 /**
  * @class DBScanClusterBuilder
  * @brief
+ *
+ * The neighbours of a hit are found with a spatial index: the hits are
+ * sorted by the cell of a grid with a pitch of clusterHitDist (in x, y
+ * and z divided by the z bias) that they fall into, so only the hits in
+ * the 27 cells around a hit need to be checked. The index and the flags
+ * used while clustering are kept between calls, so a producer holding
+ * on to one builder does not reallocate them for every event.
  */
 class DBScanClusterBuilder {
  public:
@@ -26,6 +37,15 @@ class DBScanClusterBuilder {
                        float clusterZBias,
                        float minClusterHitMult);  // overloaded constructor
 
+  /**
+   * Group the input hits into clusters
+   *
+   * @param[in] hits hits to cluster
+   * @param[in] debug unused, the debug printout is controlled by the
+   * logging level of the builder
+   * @return list of clusters, each a list of the hits in it starting with
+   * the hit the cluster was seeded from
+   */
   std::vector<std::vector<const ldmx::CalorimeterHit *> > runDBSCAN(
       const std::vector<const ldmx::CalorimeterHit *> &hits, bool debug);
 
@@ -50,10 +70,28 @@ class DBScanClusterBuilder {
   int setMinHitMultiplicity() const { return minClusterHitMult_; }
 
  private:
-  bool isIn(unsigned int i, std::vector<unsigned int> l) {
-    return std::find(l.begin(), l.end(), i) != l.end();
-  }
-  float dist(const ldmx::CalorimeterHit *a, const ldmx::CalorimeterHit *b) {
+  /// Sort the hits into the cells of the spatial index
+  void buildIndex(const std::vector<const ldmx::CalorimeterHit *> &hits);
+
+  /**
+   * Find all hits closer than clusterHitDist to a hit, including itself
+   *
+   * @param[in] hits hits the index was built from
+   * @param[in] i index of the hit to find the neighbours of
+   * @param[out] neighbors indices of neighbouring hits, in no particular order
+   */
+  void findNeighbors(const std::vector<const ldmx::CalorimeterHit *> &hits,
+                     unsigned int i,
+                     std::vector<unsigned int> &neighbors) const;
+
+  /// @return coordinate of the grid cell a hit falls into along an axis
+  int cell(float position) const;
+
+  /// @return key of a grid cell, ordered by x then y then z
+  static uint64_t cellKey(int ix, int iy, int iz);
+
+  float dist(const ldmx::CalorimeterHit *a,
+             const ldmx::CalorimeterHit *b) const {
     return sqrt(pow(a->getXPos() - b->getXPos(), 2)  // distance
                 + pow(a->getYPos() - b->getYPos(), 2) +
                 pow((a->getZPos() - b->getZPos()) / clusterZBias_,
@@ -64,6 +102,16 @@ class DBScanClusterBuilder {
   float clusterHitDist_{100.};
   float clusterZBias_{1.};  // private parameter for z bias
   int minClusterHitMult_{2};
+
+  /// hit indices sorted by the key of their grid cell
+  std::vector<std::pair<uint64_t, unsigned int> > cells_;
+  /// hits that had their neighbours searched
+  std::vector<bool> tried_;
+  /// hits that were put into a cluster
+  std::vector<bool> used_;
+  /// hits that were already found while growing the current cluster
+  std::vector<bool> found_;
+
   /// Enable logging
   enableLogging("DBScanClusterBuilder")
 };
@@ -441,7 +441,7 @@ class HgcrocDigiCollection {
       : public std::iterator<std::input_iterator_tag, HgcrocDigi, long> {
    public:
     /// Connect the parent collection with an index to this iterator
-    explicit iterator(HgcrocDigiCollection& c, long index = 0)
+    explicit iterator(const HgcrocDigiCollection& c, long index = 0)
         : digi_index_{index}, coll_{c} {}
     /// Increment the digi index and return the iterator afterwards
     iterator& operator++() {
@@ -470,7 +470,7 @@ class HgcrocDigiCollection {
     /// the index of the digi this iterator represents
     long digi_index_{0};
     /// the parent collection this iterator is looping over
-    HgcrocDigiCollection& coll_;
+    const HgcrocDigiCollection& coll_;
   };  // iterator
 
  public:
@@ -479,7 +479,7 @@ class HgcrocDigiCollection {
    *
    * We just point the user to the zero'th entry.
    */
-  iterator begin() { return iterator(*this, 0); }
+  iterator begin() const { return iterator(*this, 0); }
 
   /**
    * The end of this collection
@@ -487,7 +487,7 @@ class HgcrocDigiCollection {
    * The end of the collection is the number
    * of digis stored in it.
    */
-  iterator end() { return iterator(*this, getNumDigis()); }
+  iterator end() const { return iterator(*this, getNumDigis()); }
 
  private:
   /** Mask for lowest order bit in an int */
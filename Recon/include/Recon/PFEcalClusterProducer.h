@@ -17,6 +17,7 @@
 #include "Framework/Configure/Parameters.h"  // Needed to import parameters from configuration file
 #include "Framework/Event.h"
 #include "Framework/EventProcessor.h"  //Needed to declare processor
+#include "Recon/DBScanClusterBuilder.h"
 #include "TFitResult.h"
 #include "TGraph.h"
 
@@ -44,6 +45,9 @@ class PFEcalClusterProducer : public framework::Producer {
   float clusterZBias_{1.};  // private parameter for z bias
   int minClusterHitMult_{2};
 
+  /// clustering algorithm, kept between events to reuse its spatial index
+  DBScanClusterBuilder cb_;
+
   // name of collection for hits to be passed as input
   std::string hitCollName_;
   // name of collection for pfCluster to be output
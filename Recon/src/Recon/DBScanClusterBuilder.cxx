@@ -2,8 +2,11 @@
 // #include "Recon/Event/HgcrocDigiCollection.h"
 #include "Recon/DBScanClusterBuilder.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iostream>
-#include <set>
+#include <queue>
 
 namespace recon {
 
@@ -24,53 +27,71 @@ DBScanClusterBuilder::DBScanClusterBuilder(float minHitEnergy,
   minClusterHitMult_ = minClusterHitMult;
 }
 
+/// Number of bits used for each axis in a cell key
+static const int CELL_BITS{21};
+/// Largest cell coordinate along an axis
+static const int MAX_CELL{(1 << CELL_BITS) - 1};
+
 std::vector<std::vector<const ldmx::CalorimeterHit *> >
 DBScanClusterBuilder::runDBSCAN(
     const std::vector<const ldmx::CalorimeterHit *> &hits, bool debug = false) {
   const int n = hits.size();
   std::vector<std::vector<const ldmx::CalorimeterHit *> > idx_clusters;
-  std::vector<unsigned int> tried;
-  tried.reserve(n);
-  std::vector<unsigned int> used;
-  used.reserve(n);
+  buildIndex(hits);
+  tried_.assign(n, false);
+  used_.assign(n, false);
+  found_.assign(n, false);
+  std::vector<unsigned int> neighbors, neighbors2, found;
   for (unsigned int i = 0; i < n; i++) {
-    if (isIn(i, tried)) continue;
-    tried.push_back(i);
+    if (tried_[i]) continue;
+    tried_[i] = true;
     ldmx_log(debug) << "trying " << i;
     if (hits[i]->getEnergy() < minHitEnergy_) continue;
-    std::set<unsigned int> neighbors;
     unsigned int nNearby = 1;
     // find neighbors
-    for (unsigned int j = 0; j < n; j++) {
-      if (i != j &&
-          dist(hits[i], hits[j]) < clusterHitDist_) {  // pair-wise distance
-        neighbors.insert(j);
-        if (hits[j]->getEnergy() >= minHitEnergy_) nNearby++;
-      }
+    findNeighbors(hits, i, neighbors);
+    for (unsigned int j : neighbors) {
+      if (j != i && hits[j]->getEnergy() >= minHitEnergy_) nNearby++;
     }
     if (nNearby >= minClusterHitMult_) {
       std::vector<const ldmx::CalorimeterHit *> idx_cluster{
           hits[i]};  // start a cluster
-      used.push_back(i);
+      used_[i] = true;
       ldmx_log(debug) << "- starting a cluster from " << i;
+      // the neighbors are visited in increasing index, a neighbor of a
+      // neighbor is only visited if its index is larger than the index
+      // of the neighbor it was found from
+      std::priority_queue<unsigned int, std::vector<unsigned int>,
+                          std::greater<unsigned int> >
+          to_visit;
+      found.clear();
       for (unsigned int j : neighbors) {
-        if (!isIn(j, tried)) {
-          tried.push_back(j);
+        if (j == i) continue;
+        found_[j] = true;
+        found.push_back(j);
+        to_visit.push(j);
+      }
+      while (!to_visit.empty()) {
+        unsigned int j = to_visit.top();
+        to_visit.pop();
+        if (!tried_[j]) {
+          tried_[j] = true;
           ldmx_log(debug) << "== tried " << j;
-          std::vector<unsigned int> neighbors2;
-          for (unsigned int k = 0; k < n; k++) {
-            if (dist(hits[k], hits[j]) < clusterHitDist_) {
-              neighbors2.push_back(k);
-            }
+          findNeighbors(hits, j, neighbors2);
+          for (unsigned int k : neighbors2) {
+            if (found_[k]) continue;
+            found_[k] = true;
+            found.push_back(k);
+            if (k > j) to_visit.push(k);
           }
-          for (unsigned int k : neighbors2) neighbors.insert(k);
         }
-        if (!isIn(j, used)) {
+        if (!used_[j]) {
           ldmx_log(debug) << "== used " << j;
-          used.push_back(j);
+          used_[j] = true;
           idx_cluster.push_back(hits[j]);
         }
       }
+      for (unsigned int j : found) found_[j] = false;
       idx_clusters.push_back(idx_cluster);
     }
   }
@@ -79,6 +100,60 @@ DBScanClusterBuilder::runDBSCAN(
   return idx_clusters;
 }
 
+void DBScanClusterBuilder::buildIndex(
+    const std::vector<const ldmx::CalorimeterHit *> &hits) {
+  cells_.clear();
+  if (clusterHitDist_ <= 0) return;  // no pair of hits is close enough
+  cells_.reserve(hits.size());
+  for (unsigned int i = 0; i < hits.size(); i++) {
+    cells_.emplace_back(cellKey(cell(hits[i]->getXPos()),
+                                cell(hits[i]->getYPos()),
+                                cell(hits[i]->getZPos() / clusterZBias_)),
+                        i);
+  }
+  std::sort(cells_.begin(), cells_.end());
+}
+
+void DBScanClusterBuilder::findNeighbors(
+    const std::vector<const ldmx::CalorimeterHit *> &hits, unsigned int i,
+    std::vector<unsigned int> &neighbors) const {
+  neighbors.clear();
+  if (cells_.empty()) return;
+  const ldmx::CalorimeterHit *hit = hits[i];
+  int ix = cell(hit->getXPos()), iy = cell(hit->getYPos()),
+      iz = cell(hit->getZPos() / clusterZBias_);
+  // cells with the same x and y are next to each other in the index,
+  // so the three cells along z are searched for in one range
+  for (int jx = std::max(ix - 1, 0); jx <= std::min(ix + 1, MAX_CELL); jx++) {
+    for (int jy = std::max(iy - 1, 0); jy <= std::min(iy + 1, MAX_CELL);
+         jy++) {
+      auto begin = std::lower_bound(
+          cells_.begin(), cells_.end(),
+          std::make_pair(cellKey(jx, jy, std::max(iz - 1, 0)), 0u));
+      auto end = std::lower_bound(
+          begin, cells_.end(),
+          std::make_pair(cellKey(jx, jy, std::min(iz + 1, MAX_CELL)) + 1, 0u));
+      for (auto it = begin; it != end; ++it) {
+        if (dist(hits[it->second], hit) < clusterHitDist_) {
+          neighbors.push_back(it->second);
+        }
+      }
+    }
+  }
+}
+
+int DBScanClusterBuilder::cell(float position) const {
+  // shift so that the cells around zero are in the middle of the key range,
+  // hits outside of the key range share the cells at its edges
+  double c = std::floor(position / clusterHitDist_) + (1 << (CELL_BITS - 1));
+  return std::min(std::max(c, 0.), double(MAX_CELL));
+}
+
+uint64_t DBScanClusterBuilder::cellKey(int ix, int iy, int iz) {
+  return (uint64_t(ix) << (2 * CELL_BITS)) | (uint64_t(iy) << CELL_BITS) |
+         uint64_t(iz);
+}
+
 void DBScanClusterBuilder::fillClusterInfoFromHits(
     ldmx::CaloCluster *cl, std::vector<const ldmx::CalorimeterHit *> hits,
     bool logEnergyWeight) {
@@ -17,27 +17,31 @@ void PFEcalClusterProducer::configure(framework::config::Parameters& ps) {
   clusterHitDist_ = ps.getParameter<double>("clusterHitDist");
   clusterZBias_ = ps.getParameter<double>("clusterZBias", 1);
   minHitEnergy_ = ps.getParameter<double>("minHitEnergy");
+
+  cb_.setMinHitEnergy(minHitEnergy_);
+  cb_.setMinHitDistance(clusterHitDist_);
+  cb_.setZBias(clusterZBias_);
+  cb_.setMinHitMultiplicity(minClusterHitMult_);
 }
 
 void PFEcalClusterProducer::produce(framework::Event& event) {
   if (!event.exists(hitCollName_)) return;
-  const auto ecalRecHits = event.getCollection<ldmx::EcalHit>(hitCollName_);
+  const auto& ecalRecHits = event.getCollection<ldmx::EcalHit>(hitCollName_);
 
   float eTotal = 0;
   for (const auto& h : ecalRecHits) eTotal += h.getEnergy();
 
   std::vector<ldmx::CaloCluster> pfClusters;
   if (!singleCluster_) {
-    DBScanClusterBuilder cb(minHitEnergy_, clusterHitDist_, clusterZBias_,
-                            minClusterHitMult_);
     std::vector<const ldmx::CalorimeterHit*> ptrs;
+    ptrs.reserve(ecalRecHits.size());
     for (const auto& h : ecalRecHits) ptrs.push_back(&h);
     std::vector<std::vector<const ldmx::CalorimeterHit*> > all_hit_ptrs =
-        cb.runDBSCAN(ptrs, false);
+        cb_.runDBSCAN(ptrs, false);
 
     for (const auto& hit_ptrs : all_hit_ptrs) {
       ldmx::CaloCluster cl;
-      cb.fillClusterInfoFromHits(&cl, hit_ptrs, logEnergyWeight_);
+      cb_.fillClusterInfoFromHits(&cl, hit_ptrs, logEnergyWeight_);
       pfClusters.push_back(cl);
     }
   } else {  // create a single, large cluster
@@ -21,27 +21,30 @@ void PFHcalClusterProducer::configure(framework::config::Parameters& ps) {
   clusterHitDist_ = ps.getParameter<double>("clusterHitDist");
   clusterZBias_ = ps.getParameter<double>("clusterZBias", 1);
   minHitEnergy_ = ps.getParameter<double>("minHitEnergy");
+
+  cb_.setMinHitEnergy(minHitEnergy_);
+  cb_.setMinHitDistance(clusterHitDist_);
+  cb_.setZBias(clusterZBias_);
+  cb_.setMinHitMultiplicity(minClusterHitMult_);
 }
 
 void PFHcalClusterProducer::produce(framework::Event& event) {
   if (!event.exists(hitCollName_)) return;
-  const auto hcalRecHits = event.getCollection<ldmx::HcalHit>(hitCollName_);
+  const auto& hcalRecHits = event.getCollection<ldmx::HcalHit>(hitCollName_);
   float eTotal = 0;
   for (const auto& h : hcalRecHits) eTotal += h.getEnergy();
 
   std::vector<ldmx::CaloCluster> pfClusters;
   if (!singleCluster_) {
-    // construct DBScan
-    DBScanClusterBuilder cb(minHitEnergy_, clusterHitDist_, clusterZBias_,
-                            minClusterHitMult_);
     std::vector<const ldmx::CalorimeterHit*> ptrs;
+    ptrs.reserve(hcalRecHits.size());
     for (const auto& h : hcalRecHits) ptrs.push_back(&h);
     std::vector<std::vector<const ldmx::CalorimeterHit*> > all_hit_ptrs =
-        cb.runDBSCAN(ptrs, false);
+        cb_.runDBSCAN(ptrs, false);
 
     for (const auto& hit_ptrs : all_hit_ptrs) {
       ldmx::CaloCluster cl;
-      cb.fillClusterInfoFromHits(&cl, hit_ptrs, logEnergyWeight_);
+      cb_.fillClusterInfoFromHits(&cl, hit_ptrs, logEnergyWeight_);
       pfClusters.push_back(cl);
     }
 
@@ -38,6 +38,20 @@ class ConditionsInterface {
     return processor_->getCondition<T>(condition_name);
   }
 
+  /**
+   * Interval of validity of a conditions object retrieved with getCondition
+   *
+   * @param[in] condition_name name of the conditions object
+   * @return interval over which the object is valid
+   */
+  framework::ConditionsIOV getConditionIOV(const std::string& condition_name) {
+    if (processor_ == 0) {
+      EXCEPTION_RAISE("ConditionUnavailableException",
+                      "No conditions system object available in SimCore");
+    }
+    return processor_->getConditionIOV(condition_name);
+  }
+
  private:
   /**
    * Pointer to the owner processor object
@@ -55,6 +55,11 @@ class DetectorConstruction : public G4VUserDetectorConstruction {
   G4VPhysicalVolume *Construct();
 
   /**
+   * Construct the sensitive detectors and the fields
+   *
+   * This is called on the master and on each worker thread,
+   * each thread has its own sensitive detectors, field managers
+   * and biasing operators.
    */
   void ConstructSDandField();
 
@@ -62,7 +67,7 @@ class DetectorConstruction : public G4VUserDetectorConstruction {
    * @return The name of this detector. This is extracted from the
    *	description file used to build this detector.
    */
-  std::string getDetectorName() { return parser_->getDetectorName(); }
+  std::string getDetectorName() const { return parser_->getDetectorName(); }
 
  private:
   /// The parser used to load the detector into memory.
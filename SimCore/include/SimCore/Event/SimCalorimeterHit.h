@@ -77,6 +77,18 @@ class SimCalorimeterHit {
    */
   virtual ~SimCalorimeterHit() = default;
 
+  /**
+   * Copy and move the hit
+   *
+   * The virtual destructor would otherwise keep the compiler from
+   * moving hits, so the contribution vectors would be copied each
+   * time a vector of hits is moved around.
+   */
+  SimCalorimeterHit(const SimCalorimeterHit &) = default;
+  SimCalorimeterHit(SimCalorimeterHit &&) = default;
+  SimCalorimeterHit &operator=(const SimCalorimeterHit &) = default;
+  SimCalorimeterHit &operator=(SimCalorimeterHit &&) = default;
+
   /**
    * Clear the data in the object.
    */
@@ -117,6 +129,14 @@ class SimCalorimeterHit {
    */
   std::vector<float> getPosition() const { return {x_, y_, z_}; }
 
+  /**
+   * Get the components of the position of the hit [mm],
+   * without allocating a vector.
+   */
+  float getX() const { return x_; }
+  float getY() const { return y_; }
+  float getZ() const { return z_; }
+
   /**
    * Get the XYZ pre-step position of the hit in the coordinate frame of the
    * sensitive volume [mm].
@@ -112,6 +112,16 @@ class SimParticle {
    */
   std::vector<double> getVertex() const { return {x_, y_, z_}; }
 
+  /**
+   * Get the components of the vertex of this particle [mm].
+   *
+   * Unlike getVertex, these don't allocate a vector
+   * and so are the ones to use in loops.
+   */
+  double getVertexX() const { return x_; }
+  double getVertexY() const { return y_; }
+  double getVertexZ() const { return z_; }
+
   /**
    * Get the volume name in which this particle was created in.
    *
@@ -129,6 +139,14 @@ class SimParticle {
    */
   std::vector<double> getEndPoint() const { return {endX_, endY_, endZ_}; }
 
+  /**
+   * Get the components of the endpoint of this particle [mm],
+   * without allocating a vector.
+   */
+  double getEndPointX() const { return endX_; }
+  double getEndPointY() const { return endY_; }
+  double getEndPointZ() const { return endZ_; }
+
   /**
    * Get a vector containing the momentum of this particle [MeV].
    *
@@ -138,6 +156,14 @@ class SimParticle {
    */
   std::vector<double> getMomentum() const { return {px_, py_, pz_}; }
 
+  /**
+   * Get the components of the momentum of this particle [MeV],
+   * without allocating a vector.
+   */
+  double getPx() const { return px_; }
+  double getPy() const { return py_; }
+  double getPz() const { return pz_; }
+
   /**
    * Get the mass of this particle [GeV].
    *
@@ -158,14 +184,14 @@ class SimParticle {
    * @return A vector containing the track IDs of all daughter
    *      particles.
    */
-  std::vector<int> getDaughters() const { return daughters_; }
+  const std::vector<int>& getDaughters() const { return daughters_; }
 
   /**
    * Get a vector containing the track IDs of the parent particles.
    *
    * @return A vector containing the track IDs the parent particles.
    */
-  std::vector<int> getParents() const { return parents_; }
+  const std::vector<int>& getParents() const { return parents_; }
 
   /**
    * Set the energy of this particle [MeV].
@@ -14,6 +14,7 @@
 
 // STL
 #include <iostream>
+#include <vector>
 
 namespace ldmx {
 
@@ -68,6 +69,14 @@ class SimTrackerHit {
    */
   std::vector<float> getPosition() const { return {x_, y_, z_}; };
 
+  /**
+   * Get the components of the position of the hit [mm],
+   * without allocating a vector.
+   */
+  float getX() const { return x_; };
+  float getY() const { return y_; };
+  float getZ() const { return z_; };
+
   /**
    * Get the energy deposited on the hit [MeV].
    * @return The energy deposited on the hit.
@@ -100,6 +109,14 @@ class SimTrackerHit {
    */
   std::vector<double> getMomentum() const { return {px_, py_, pz_}; };
 
+  /**
+   * Get the components of the momentum of the particle at the position
+   * of the hit [MeV], without allocating a vector.
+   */
+  float getPx() const { return px_; };
+  float getPy() const { return py_; };
+  float getPz() const { return pz_; };
+
   /**
    * Get the Sim particle track ID of the hit.
    * @return The Sim particle track ID of the hit.
@@ -273,6 +290,56 @@ class SimTrackerHit {
   ClassDef(SimTrackerHit, 3);
 
 };  // SimTrackerHit
+
+/**
+ * @class SimTrackerHitColumns
+ * @brief Columns of a collection of SimTrackerHits
+ *
+ * The hits are stored one after the other in the event, so looping over
+ * one of their members jumps through memory. This copies the members
+ * used by the analysis kernels into one contiguous array each, in the
+ * order of the hits, so those loops can be vectorized.
+ *
+ * The arrays are kept between calls to fill, so a processor holding
+ * one of these doesn't allocate once the largest event has been seen.
+ * This is not an event object and is never persisted.
+ */
+class SimTrackerHitColumns {
+ public:
+  /**
+   * Copy the members of the input hits into the columns
+   *
+   * @param[in] hits collection of hits, replacing the previous ones
+   */
+  void fill(const std::vector<SimTrackerHit> &hits);
+
+  /// Number of hits in the columns
+  std::size_t size() const { return id_.size(); }
+
+  /// Raw detector IDs
+  const std::vector<int> &id() const { return id_; }
+  /// Track IDs of the SimParticles
+  const std::vector<int> &trackID() const { return trackID_; }
+  /// PDG IDs of the SimParticles
+  const std::vector<int> &pdgID() const { return pdgID_; }
+  /// Positions [mm]
+  const std::vector<float> &x() const { return x_; }
+  const std::vector<float> &y() const { return y_; }
+  const std::vector<float> &z() const { return z_; }
+  /// Momenta [MeV]
+  const std::vector<float> &px() const { return px_; }
+  const std::vector<float> &py() const { return py_; }
+  const std::vector<float> &pz() const { return pz_; }
+  /// Energy deposited [MeV]
+  const std::vector<float> &edep() const { return edep_; }
+  /// Global time [ns]
+  const std::vector<float> &time() const { return time_; }
+
+ private:
+  std::vector<int> id_, trackID_, pdgID_;
+  std::vector<float> x_, y_, z_, px_, py_, pz_, edep_, time_;
+};  // SimTrackerHitColumns
+
 }  // namespace ldmx
 
 #endif  // EVENT_SIMTRACKERHIT_H_
@@ -0,0 +1,149 @@
+#ifndef SIMCORE_EVENTSTREAM_H
+#define SIMCORE_EVENTSTREAM_H
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Event.h"
+#include "SimCore/UserAction.h"
+
+class G4Event;
+class G4Run;
+
+namespace simcore {
+
+/**
+ * @class EventStream
+ * @brief Hand the events completed by the Geant4 worker threads
+ * back to the framework in order
+ *
+ * When Geant4 runs with several worker threads, the events are completed
+ * on the workers in whatever order the workers finish them. At the end of
+ * each event, the worker copies the hits and tracks out of its thread-local
+ * sensitive detectors and track map into a framework::Event of its own
+ * (staging). The staged events are kept here by their Geant4 event ID
+ * until the Simulator asks for them, one after the other, so the output
+ * file has the same sequence of events no matter how the work was shared
+ * between the workers.
+ */
+class EventStream {
+ public:
+  /**
+   * Copy the products of the Geant4 event that just finished on the
+   * calling thread into a framework event
+   */
+  using Stager = std::function<void(const G4Event*, framework::Event&)>;
+
+  /// An event completed by one of the workers
+  struct Staged {
+    /// products of the event
+    std::unique_ptr<framework::Event> event_;
+    /// was the event aborted by Geant4?
+    bool aborted_{false};
+    /// state of the random engine before the event was generated
+    std::string seed_;
+  };
+
+  /**
+   * Per-thread end of event action staging the Geant4 events
+   *
+   * One is registered as the last run and event action of each worker.
+   */
+  class Action : public UserAction {
+   public:
+    /**
+     * Create the action
+     *
+     * @param[in] stream the stream to put the events into
+     */
+    Action(EventStream& stream);
+
+    /**
+     * Look up the conditions of the sensitive detectors of this worker
+     *
+     * Each batch of events is a Geant4 run, the master is waiting for
+     * the batch in Simulator::produce so the conditions are those of the
+     * framework event being produced.
+     */
+    void BeginOfRunAction(const G4Run*) override;
+
+    /**
+     * Stage the event that just finished
+     *
+     * This also resets the dark brem process on this worker,
+     * which the sequential RunManager does when terminating the event.
+     *
+     * @param[in] event Geant4 event that just finished
+     */
+    void EndOfEventAction(const G4Event* event) override;
+
+    /// A run and event action
+    std::vector<TYPE> getTypes() override { return {TYPE::RUN, TYPE::EVENT}; }
+
+   private:
+    /// stream to put the events into
+    EventStream& stream_;
+  };
+
+  /**
+   * Create the stream
+   *
+   * @param[in] pass_name pass name of the framework events the
+   * products are added to
+   */
+  EventStream(const std::string& pass_name) : pass_name_{pass_name} {}
+
+  /**
+   * Set how the products are copied out of a finished event
+   *
+   * The stager is called on the worker threads, it must only touch
+   * the thread-local Geant4 objects.
+   *
+   * @param[in] stager function staging the products
+   */
+  void setStager(Stager stager) { stager_ = stager; }
+
+  /**
+   * Stage the event that just finished on the calling thread
+   *
+   * Aborted events are staged without any products.
+   *
+   * @param[in] event finished Geant4 event
+   */
+  void push(const G4Event* event);
+
+  /**
+   * Take a staged event out of the stream
+   *
+   * @param[in] event_id Geant4 ID of the event
+   * @param[out] staged staged event
+   * @return false if that event has not been staged
+   */
+  bool pop(int event_id, Staged& staged);
+
+  /// Number of events waiting in the stream
+  std::size_t size() const;
+
+ private:
+  /// pass name of the staged events
+  std::string pass_name_;
+  /// copies the products of a finished event
+  Stager stager_;
+  /// staged events by Geant4 event ID
+  std::map<int, Staged> staged_;
+  /// protect the staged events from the workers
+  mutable std::mutex mutex_;
+};
+
+}  // namespace simcore
+
+#endif  // SIMCORE_EVENTSTREAM_H
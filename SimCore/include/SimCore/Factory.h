@@ -6,8 +6,10 @@
 #include <memory>                   // for the unique_ptr default
 #include <string>                   // for the keys in the library map
 #include <unordered_map>            // for the library of prototypes
+#include <vector>                   // for the warehouse of objects
 
 #include "Framework/Exception/Exception.h"
+#include "G4Threading.hh"  // to tell the Geant4 worker threads apart
 
 namespace simcore {
 
@@ -191,6 +193,16 @@ namespace simcore {
  * $ fave-things library::DoesNotExist
  * ERROR: An object named library::DoesNotExist has not been declared.
  * ```
+ *
+ * ## Threads
+ *
+ * The library of makers is shared by all threads. When Geant4 runs with
+ * several worker threads, each worker has its own warehouse of created
+ * objects, so it makes its own sensitive detectors, user actions,
+ * generators and biasing operators and `apply` on a worker only visits
+ * the objects made by that worker. All other threads (the Geant4 master
+ * and the threads of the framework) share one warehouse, so the objects
+ * made there are seen by all of them, as without Geant4 workers.
  */
 template <typename Prototype, typename PrototypePtr,
           typename... PrototypeConstructorArgs>
@@ -269,19 +281,22 @@ class Factory {
       EXCEPTION_RAISE("SimFactory", "An object named " + full_name +
                                         " has not been declared.");
     }
-    warehouse_.emplace_back(lib_it->second(maker_args...));
-    return warehouse_.back();
+    auto& warehouse{inventory()};
+    warehouse.emplace_back(lib_it->second(maker_args...));
+    return warehouse.back();
   }
 
   /**
    * Apply the input UnaryFunction to each entry in the inventory
+   * of the calling thread
    *
    * UnaryFunction is simply passed dirctly to std::for_each so
    * look there for requirements upon it.
    */
   template <class UnaryFunction>
   void apply(UnaryFunction f) const {
-    std::for_each(warehouse_.begin(), warehouse_.end(), f);
+    const auto& warehouse{inventory()};
+    std::for_each(warehouse.begin(), warehouse.end(), f);
   }
 
   /// delete the copy constructor
@@ -316,15 +331,37 @@ class Factory {
         new DerivedType(std::forward<PrototypeConstructorArgs>(args)...));
   }
 
+  /**
+   * Get the warehouse of objects made on the calling thread
+   *
+   * @return the warehouse of this Geant4 worker thread or the shared one
+   */
+  std::vector<PrototypePtr>& inventory() {
+    return G4Threading::IsWorkerThread() ? worker_warehouse_ : warehouse_;
+  }
+
+  /// @return the warehouse of objects made on the calling thread
+  const std::vector<PrototypePtr>& inventory() const {
+    return G4Threading::IsWorkerThread() ? worker_warehouse_ : warehouse_;
+  }
+
   /// private constructor to prevent creation
   Factory() = default;
 
   /// library of possible objects to create
   std::unordered_map<std::string, PrototypeMaker> library_;
 
-  /// warehouse of objects that have already been created
+  /// warehouse of objects created on threads that aren't Geant4 workers
   std::vector<PrototypePtr> warehouse_;
+
+  /// warehouse of objects created by this Geant4 worker thread
+  static thread_local std::vector<PrototypePtr> worker_warehouse_;
 };  // Factory
 
+template <typename Prototype, typename PrototypePtr,
+          typename... PrototypeConstructorArgs>
+thread_local std::vector<PrototypePtr> Factory<
+    Prototype, PrototypePtr, PrototypeConstructorArgs...>::worker_warehouse_;
+
 }  // namespace simcore
 #endif  // SIMCORE_FACTORY_H
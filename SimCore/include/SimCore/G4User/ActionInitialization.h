@@ -0,0 +1,71 @@
+#ifndef SIMCORE_G4USER_ACTIONINITIALIZATION_H
+#define SIMCORE_G4USER_ACTIONINITIALIZATION_H
+
+/*~~~~~~~~~~~~*/
+/*   Geant4   */
+/*~~~~~~~~~~~~*/
+#include "G4VUserActionInitialization.hh"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Configure/Parameters.h"
+
+namespace simcore {
+
+class EventStream;
+
+namespace g4user {
+
+/**
+ * @class ActionInitialization
+ * @brief Create the G4User actions and the configured UserActions
+ *
+ * Geant4 calls Build once for the sequential run manager or once on
+ * each worker thread of the multi-threaded run manager, so each thread
+ * has its own actions, track map and filters. The configured UserActions
+ * are made through the UserAction::Factory and attached to the G4User
+ * actions by their type.
+ */
+class ActionInitialization : public G4VUserActionInitialization {
+ public:
+  /**
+   * Constructor
+   *
+   * @param[in] parameters configuration of the simulation
+   * @param[in] stream stream the workers put their finished events into,
+   * only given when running with several threads
+   */
+  ActionInitialization(const framework::config::Parameters& parameters,
+                       EventStream* stream = nullptr)
+      : parameters_{parameters}, stream_{stream} {}
+
+  /// Destructor
+  virtual ~ActionInitialization() = default;
+
+  /**
+   * Create the actions for the master thread
+   *
+   * The master only needs a run action, but we also make the
+   * generators on the master so that their configuration can be
+   * recorded into the run header. This is where we check that
+   * the generators can be copied onto the workers.
+   *
+   * @throws Exception if one of the generators is not thread safe
+   */
+  void BuildForMaster() const override;
+
+  /// Create the actions for the calling (worker) thread
+  void Build() const override;
+
+ private:
+  /// configuration of the simulation
+  framework::config::Parameters parameters_;
+  /// stream to put finished events into, null when sequential
+  EventStream* stream_;
+};  // ActionInitialization
+
+}  // namespace g4user
+}  // namespace simcore
+
+#endif  // SIMCORE_G4USER_ACTIONINITIALIZATION_H
@@ -111,6 +111,10 @@ class TrackingAction : public G4UserTrackingAction {
 
   /**
    * Get a pointer to the current UserTrackingAction from the G4RunManager.
+   *
+   * The run manager is the one of the calling thread, so each Geant4
+   * worker thread gets its own tracking action and track map.
+   *
    * @return A pointer to the current UserTrackingAction.
    */
   static TrackingAction* get() {
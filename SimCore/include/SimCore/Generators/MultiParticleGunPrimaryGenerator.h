@@ -78,6 +78,13 @@ class MultiParticleGunPrimaryGenerator : public simcore::PrimaryGenerator {
 
   void RecordConfig(const std::string& id, ldmx::RunHeader& rh) override;
 
+  /**
+   * The copies of the gun on different threads would draw the same
+   * sequence of multiplicities from their own random number generators,
+   * so the gun is only thread safe without the Poisson multiplicity.
+   */
+  bool isThreadSafe() const override { return not mpgEnablePoisson_; }
+
  private:
   /** Random number generator. */
   TRandom* random_;
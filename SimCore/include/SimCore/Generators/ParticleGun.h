@@ -57,6 +57,9 @@ class ParticleGun : public simcore::PrimaryGenerator {
 
   void RecordConfig(const std::string& id, ldmx::RunHeader& rh) override;
 
+  /// Each copy of the gun holds its own settings
+  bool isThreadSafe() const override { return true; }
+
  private:
   /**
    * The actual Geant4 implementation of the ParticleGun
@@ -0,0 +1,78 @@
+#ifndef SIMCORE_MTRUNMANAGER_H
+#define SIMCORE_MTRUNMANAGER_H
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <string>
+
+//------------//
+//   Geant4   //
+//------------//
+#include "G4MTRunManager.hh"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Configure/Parameters.h"
+#include "SimCore/EventStream.h"
+
+namespace simcore {
+
+class ConditionsInterface;
+
+/**
+ * @class MTRunManager
+ * @brief Geant4 run manager processing events on several worker threads
+ *
+ * The geometry and the physics tables are built once by the master
+ * and shared by the workers. Each worker has its own sensitive detectors,
+ * actions (and so track map and filters), generators, biasing operators
+ * and field managers, all made through the same factories as with the
+ * sequential RunManager.
+ *
+ * The master simulates the events in batches with BeamOn, the workers
+ * put the finished events into the EventStream where the Simulator
+ * collects them in order.
+ */
+class MTRunManager : public G4MTRunManager {
+ public:
+  /**
+   * Class constructor.
+   *
+   * @param[in] parameters configuration of the simulation
+   * @param[in] pass_name pass name of the framework events the
+   * products are put into
+   * @param[in] n_threads number of worker threads
+   */
+  MTRunManager(framework::config::Parameters& parameters,
+               ConditionsInterface&, const std::string& pass_name,
+               int n_threads);
+
+  /**
+   * Class destructor.
+   */
+  virtual ~MTRunManager() = default;
+
+  /**
+   * Perform application initialization.
+   *
+   * The physics list and action initialization are given to G4 and
+   * the master is initialized. The workers are started with the
+   * first BeamOn.
+   */
+  void Initialize() override;
+
+  /// Stream the workers put their finished events into
+  EventStream& getEventStream() { return stream_; }
+
+ private:
+  /// The set of parameters used to configure the MTRunManager
+  framework::config::Parameters parameters_;
+
+  /// finished events waiting to be collected
+  EventStream stream_;
+};  // MTRunManager
+}  // namespace simcore
+
+#endif  // SIMCORE_MTRUNMANAGER_H
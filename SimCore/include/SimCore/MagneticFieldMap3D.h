@@ -12,9 +12,13 @@
 #include "G4MagneticField.hh"
 
 // STL
+#include <memory>
 #include <vector>
 using std::vector;
 
+// LDMX
+#include "DetDescr/FieldMapFile.h"
+
 namespace simcore {
 
 /**
@@ -55,6 +59,11 @@ namespace simcore {
  *
  * x y z B_x B_y B_z
  *
+ * If a binary copy of the map made by convert-field-map is given instead
+ * (or is found next to the text file), it is mapped into memory and its
+ * values are used directly.
+ * @see ldmx::FieldMapFile
+ *
  * Original PurgMagTabulatedField3D code developed by: S.Larsson and J.
  * Generowicz.
  */
@@ -78,12 +87,40 @@ class MagneticFieldMap3D : public G4MagneticField {
   void GetFieldValue(const double point[4], double* bfield) const;
 
  private:
+  /**
+   * Read the table from a text field map
+   * @param[in] filename The name of the text file.
+   */
+  void readText(const char* filename);
+
+  /**
+   * Use the table in a binary field map
+   * @param[in] filename The name of the binary file.
+   */
+  void mapBinary(const std::string& filename);
+
+ private:
+  /*
+   * Storage space for the table when read from a text file,
+   * (Bx, By, Bz) for each point with z changing fastest.
+   */
+  vector<double> table_;
+
+  /*
+   * Binary field map providing the table if one is used.
+   */
+  std::unique_ptr<ldmx::FieldMapFile> binary_;
+
+  /*
+   * The field values in the same layout as table_
+   * (pointing into table_ or the binary field map).
+   */
+  const double* field_{nullptr};
+
   /*
-   * Storage space for the table.
+   * Factor converting the values in the table to Geant4 units.
    */
-  vector<vector<vector<double>>> xField_;
-  vector<vector<vector<double>>> yField_;
-  vector<vector<vector<double>>> zField_;
+  double fieldScale_{1.};
 
   /*
    * The dimensions of the table.
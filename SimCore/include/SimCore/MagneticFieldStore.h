@@ -7,14 +7,29 @@
 #ifndef SIMCORE_MAGNETICFIELDSTORE_H_
 #define SIMCORE_MAGNETICFIELDSTORE_H_
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 // Geant4
+#include "G4FieldManager.hh"
+#include "G4LogicalVolume.hh"
 #include "G4MagneticField.hh"
+#include "G4TransportationManager.hh"
+
+#include "Framework/Exception/Exception.h"
 
 namespace simcore {
 
 /**
  * @class MagneticFieldStore
  * @brief Global store to access magnetic field objects
+ *
+ * The fields themselves are only read while tracking so they are shared
+ * by all threads, but Geant4 keeps the field managers of each thread
+ * separately. The store remembers which field was given to which volume
+ * so that the worker threads can make their own field managers.
  */
 class MagneticFieldStore {
  public:
@@ -61,11 +76,68 @@ class MagneticFieldStore {
     magFields_[name] = magField;
   }
 
+  /**
+   * Use a magnetic field as the global field on the calling thread
+   *
+   * @throws Exception if a global field was already assigned
+   * @param name The name of the magnetic field.
+   */
+  void setGlobalField(const std::string& name) {
+    G4MagneticField* magField = getMagneticField(name);
+    G4FieldManager* fieldMgr =
+        G4TransportationManager::GetTransportationManager()->GetFieldManager();
+    if (fieldMgr->GetDetectorField() != nullptr) {
+      EXCEPTION_RAISE("MisAssign", "Global mag field was already assigned.");
+    }
+    fieldMgr->SetDetectorField(magField);
+    fieldMgr->CreateChordFinder(magField);
+    globalField_ = name;
+  }
+
+  /**
+   * Give a magnetic field to a volume (and its daughters)
+   * on the calling thread
+   *
+   * @param lv The logical volume.
+   * @param name The name of the magnetic field.
+   */
+  void assignMagneticField(G4LogicalVolume* lv, const std::string& name) {
+    lv->SetFieldManager(
+        new G4FieldManager(getMagneticField(name)),
+        true /* FIXME: hard-coded to force field manager to daughters */);
+    assignments_.emplace_back(lv, name);
+  }
+
+  /**
+   * Make the field managers of the calling thread
+   *
+   * Geant4 worker threads start without any field managers,
+   * this gives them the same fields as the master.
+   */
+  void constructFieldManagers() {
+    if (not globalField_.empty()) {
+      G4FieldManager* fieldMgr = G4TransportationManager::
+          GetTransportationManager()->GetFieldManager();
+      G4MagneticField* magField = getMagneticField(globalField_);
+      fieldMgr->SetDetectorField(magField);
+      fieldMgr->CreateChordFinder(magField);
+    }
+    for (const auto& [lv, name] : assignments_) {
+      lv->SetFieldManager(new G4FieldManager(getMagneticField(name)), true);
+    }
+  }
+
  private:
   /**
    * Map of names to magnetic fields.
    */
   MagFieldMap magFields_;
+
+  /// Name of the global magnetic field, empty if there is none
+  std::string globalField_;
+
+  /// Volumes given a magnetic field and the name of their field
+  std::vector<std::pair<G4LogicalVolume*, std::string>> assignments_;
 };
 
 }  // namespace simcore
@@ -69,6 +69,18 @@ class PrimaryGenerator : public G4VPrimaryGenerator {
    */
   virtual void RecordConfig(const std::string& id, ldmx::RunHeader& rh) = 0;
 
+  /**
+   * Can this generator be used when Geant4 runs with several threads?
+   *
+   * When the simulation runs with several worker threads, each worker
+   * makes its own copy of the generator. A generator should only declare
+   * itself thread safe if its copies don't share any state, e.g. they
+   * are not all reading the same input file.
+   *
+   * @return false by default
+   */
+  virtual bool isThreadSafe() const { return false; }
+
  protected:
   /// Name of the PrimaryGenerator
   std::string name_{""};
@@ -17,8 +17,8 @@
 //------------//
 //   Geant4   //
 //------------//
-#include "G4PhysListFactory.hh"
 #include "G4RunManager.hh"
+#include "G4VModularPhysicsList.hh"
 
 /*~~~~~~~~~~~~~~~*/
 /*   Framework   */
@@ -50,11 +50,6 @@ class RunManager : public G4RunManager {
    */
   virtual ~RunManager() = default;
 
-  /**
-   * Initialize physics.
-   */
-  void setupPhysics();
-
   /**
    * Perform application initialization.
    */
@@ -85,23 +80,41 @@ class RunManager : public G4RunManager {
    */
   bool useRootSeed() { return useRootSeed_; }
 
- private:
-  /// The set of parameters used to configure the RunManager
-  framework::config::Parameters parameters_;
+  /**
+   * Build the physics list
+   *
+   * This is shared with the multi-threaded run manager.
+   * The biasing operators are created on the calling thread.
+   *
+   * @param[in] parameters configuration of the simulation
+   * @return physics list, owned by the run manager it is given to
+   */
+  static G4VModularPhysicsList* makePhysicsList(
+      framework::config::Parameters& parameters);
 
   /**
-   * Factory class for instantiating the physics list.
+   * Register the parallel world of the scoring planes if one was given
+   *
+   * The parallel world needs to be registered before the mass world is
+   * constructed i.e. before G4RunManager::Initialize() is called.
+   *
+   * @param[in] parameters configuration of the simulation
+   * @param[in] detector detector construction to register the world with
    */
-  G4PhysListFactory physicsListFactory_;
+  static void registerParallelWorld(framework::config::Parameters& parameters,
+                                    DetectorConstruction* detector);
 
   /**
-   * Flag indicating whether a parallel world should be
-   * registered
+   * Reactivate the dark brem process on the calling thread
+   *
+   * Filters may deactivate the dark brem process during an event,
+   * so it needs to be reactivated before the next event.
    */
-  bool isPWEnabled_{false};
+  static void resetDarkBrem();
 
-  /** Path to GDML description of parallel world. */
-  std::string parallelWorldPath_{""};
+ private:
+  /// The set of parameters used to configure the RunManager
+  framework::config::Parameters parameters_;
 
   /**
    * Should we use random seed from root file?
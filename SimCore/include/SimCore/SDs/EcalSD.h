@@ -9,9 +9,11 @@
 #define SIMCORE_ECALSD_H_
 
 // LDMX
+#include "DetDescr/EcalGeometry.h"
 #include "DetDescr/EcalID.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
 #include "SimCore/G4User/TrackingAction.h"
+#include "SimCore/SDs/HashIndex.h"
 #include "SimCore/SensitiveDetector.h"
 #include "SimCore/TrackMap.h"
 
@@ -59,6 +61,11 @@ class EcalSD : public SensitiveDetector {
     return false;
   }
 
+  /**
+   * Get the geometry for the coming events
+   */
+  void onNewRun() override;
+
   /**
    * Process steps to create hits.
    * @param aStep The step information.
@@ -68,21 +75,89 @@ class EcalSD : public SensitiveDetector {
 
   /**
    * Add our hits to the event bus.
+   *
+   * The hits are made from the accumulated cells and contributions,
+   * ordered by cell ID with the contributions of each cell in the order
+   * they were first seen.
    */
   virtual void saveHits(framework::Event& event) override;
 
   /**
-   * Clear the map of hits we have accumulated
+   * Clear the cells and contributions we have accumulated
    */
-  virtual void OnFinishedEvent() override { hits_.clear(); }
+  virtual void OnFinishedEvent() override;
 
  private:
-  /// map of hits to add to the event (will be squashed)
-  std::map<ldmx::EcalID, ldmx::SimCalorimeterHit> hits_;
+  /// a cell with energy deposited in it during this event
+  struct Cell {
+    /// ID of the cell
+    ldmx::EcalID id_;
+    /// center of the cell
+    float x_, y_, z_;
+    /// energy deposited in the cell
+    float edep_{0};
+    /// time of the earliest contribution to the cell
+    float time_{0};
+    /// first and last contribution to the cell, negative if none
+    int first_{-1}, last_{-1};
+  };
+
+  /// energy deposited in a cell by one track
+  struct Contrib {
+    /// ID of the track incident on the calorimeter region
+    int incident_;
+    /// ID of the track
+    int track_;
+    /// PDG ID of the track
+    int pdg_;
+    /// energy deposited
+    float edep_;
+    /// time of the earliest step
+    float time_;
+    /// next contribution to the same cell, negative if none
+    int next_{-1};
+  };
+
+  /// key of a contribution in the table
+  struct ContribKey {
+    int cell_, track_, pdg_;
+    bool operator==(const ContribKey& o) const {
+      return cell_ == o.cell_ and track_ == o.track_ and pdg_ == o.pdg_;
+    }
+  };
+
+  /// hash of a cell ID
+  struct CellHash {
+    std::uint64_t operator()(std::uint32_t id) const { return mixBits(id); }
+  };
+
+  /// hash of a contribution key
+  struct ContribHash {
+    std::uint64_t operator()(const ContribKey& k) const {
+      return mixBits((std::uint64_t(std::uint32_t(k.cell_)) << 32 |
+                      std::uint32_t(k.track_)) ^
+                     mixBits(std::uint32_t(k.pdg_)));
+    }
+  };
+
+  /// cells hit during this event
+  std::vector<Cell> cells_;
+  /// index of the cells by their raw ID
+  HashIndex<std::uint32_t, CellHash> cellIndex_;
+  /// contributions made during this event
+  std::vector<Contrib> contribs_;
+  /// index of the contributions by cell, track and PDG ID
+  HashIndex<ContribKey, ContribHash> contribIndex_;
+  /// hits added to the event, kept to reuse their memory
+  std::vector<ldmx::SimCalorimeterHit> hits_;
+  /// order of cells by ID, kept to reuse its memory
+  std::vector<int> order_;
   /// enable hit contribs
   bool enableHitContribs_;
   /// compress hit contribs
   bool compressHitContribs_;
+  /// geometry of the ecal, bound in onNewRun
+  const ldmx::EcalGeometry* geometry_{nullptr};
 };
 
 }  // namespace simcore
@@ -0,0 +1,122 @@
+#ifndef SIMCORE_SDS_HASHINDEX_H
+#define SIMCORE_SDS_HASHINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+namespace simcore {
+
+/**
+ * @class HashIndex
+ * @brief Open-addressing hash table from keys to indices into an arena
+ *
+ * Sensitive detectors accumulate a lot of steps into a few cells, so they
+ * look up the same keys over and over. This table only stores the key and
+ * the index of the entry in a separate vector (the arena) owned by the
+ * detector, using linear probing in a single flat vector of slots.
+ *
+ * Clearing the table between events only resets the slots that were used,
+ * and the memory of the slots is kept, so after the first few events no
+ * allocations are done while stepping.
+ *
+ * @tparam Key type of key, must be comparable with ==
+ * @tparam Hash function object returning a std::uint64_t hash of a key
+ */
+template <typename Key, typename Hash>
+class HashIndex {
+ public:
+  /**
+   * Create an empty table
+   *
+   * @param[in] capacity initial number of slots, rounded up to a power of two
+   */
+  HashIndex(std::size_t capacity = 1024) {
+    std::size_t n{16};
+    while (n < capacity) n <<= 1;
+    slots_.resize(n);
+  }
+
+  /**
+   * Find the index stored for a key, inserting it if it isn't there
+   *
+   * @param[in] key key to look for
+   * @param[in] index index to store if the key is new
+   * @return the index stored for the key, equal to the input index
+   * if the key was inserted
+   */
+  int insert(const Key& key, int index) {
+    if (2 * (used_.size() + 1) > slots_.size()) grow();
+    Slot& slot{find(key)};
+    if (slot.index_ < 0) {
+      slot.key_ = key;
+      slot.index_ = index;
+      used_.push_back(&slot - slots_.data());
+    }
+    return slot.index_;
+  }
+
+  /// Number of keys in the table
+  std::size_t size() const { return used_.size(); }
+
+  /// Remove all of the keys, keeping the memory
+  void clear() {
+    for (std::size_t i : used_) slots_[i].index_ = -1;
+    used_.clear();
+  }
+
+ private:
+  /// one position in the table
+  struct Slot {
+    /// key stored here
+    Key key_;
+    /// index of the key in the arena, negative if the slot is empty
+    int index_{-1};
+  };
+
+  /// slot holding the key or the empty slot where it goes
+  Slot& find(const Key& key) {
+    std::size_t mask{slots_.size() - 1};
+    std::size_t i{static_cast<std::size_t>(Hash()(key)) & mask};
+    while (slots_[i].index_ >= 0 and not(slots_[i].key_ == key))
+      i = (i + 1) & mask;
+    return slots_[i];
+  }
+
+  /// double the number of slots and put the keys back in
+  void grow() {
+    std::vector<Slot> old(slots_.size() * 2);
+    old.swap(slots_);
+    std::vector<std::size_t> old_used;
+    old_used.swap(used_);
+    used_.reserve(old_used.size());
+    for (std::size_t i : old_used) {
+      Slot& slot{find(old[i].key_)};
+      slot = old[i];
+      used_.push_back(&slot - slots_.data());
+    }
+  }
+
+  /// the slots, the number of slots is always a power of two
+  std::vector<Slot> slots_;
+  /// positions of the slots in use, in order of insertion
+  std::vector<std::size_t> used_;
+};
+
+/**
+ * Mix the bits of a 64-bit integer
+ *
+ * The finalizer of MurmurHash3, so that keys differing in only
+ * a few bits end up in different slots.
+ */
+inline std::uint64_t mixBits(std::uint64_t k) {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+}  // namespace simcore
+
+#endif  // SIMCORE_SDS_HASHINDEX_H
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "DetDescr/HcalGeometry.h"
 #include "DetDescr/HcalID.h"
 #include "DetDescr/PackedIndex.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
@@ -59,6 +60,11 @@ class HcalSD : public SensitiveDetector {
     return false;
   }
 
+  /**
+   * Get the geometry for the coming events
+   */
+  void onNewRun() override;
+
   /**
    * Decode copy number of scintillator bar.
    *
@@ -87,7 +93,11 @@ class HcalSD : public SensitiveDetector {
     event.add(COLLECTION_NAME, hits_);
   }
 
-  virtual void OnFinishedEvent() override { hits_.clear(); }
+  /**
+   * Clear the hits, keeping them aside to reuse the memory of their
+   * contributions in the next event
+   */
+  virtual void OnFinishedEvent() override;
 
  private:
   // A list of identifiers used to find out whether or not a given logical
@@ -105,6 +115,13 @@ class HcalSD : public SensitiveDetector {
   // collection of hits to write to event bus
   std::vector<ldmx::SimCalorimeterHit> hits_;
 
+  // hits of previous events, a hit is made for each step so these are
+  // reused instead of allocating the contributions of each new hit
+  std::vector<ldmx::SimCalorimeterHit> spare_;
+
+  // geometry of the hcal, bound in onNewRun
+  const ldmx::HcalGeometry* geometry_{nullptr};
+
 };  // HcalSD
 
 }  // namespace simcore
@@ -1,7 +1,10 @@
 #ifndef SIMCORE_SENSITIVEDETECTOR_H_
 #define SIMCORE_SENSITIVEDETECTOR_H_
 
+#include <vector>
+
 #include "Framework/Configure/Parameters.h"
+#include "Framework/EventHeader.h"
 #include "Framework/RunHeader.h"
 #include "SimCore/ConditionsInterface.h"
 #include "SimCore/Factory.h"
@@ -98,6 +101,38 @@ class SensitiveDetector : public G4VSensitiveDetector {
    */
   virtual void OnFinishedEvent() = 0;
 
+  /**
+   * Look up the conditions needed while stepping
+   *
+   * Called through bindConditions before the first event of each run and
+   * again whenever one of the conditions looked up here is no longer valid.
+   * Detectors get their conditions (e.g. the geometry) here with
+   * getCondition and keep a pointer to them, so that no lookups are done
+   * in ProcessHits.
+   */
+  virtual void onNewRun() {}
+
+  /**
+   * Call onNewRun, recording the interval of validity of each of the
+   * conditions it looks up
+   */
+  void bindConditions();
+
+  /**
+   * Forget the bound conditions so that they are looked up again
+   * before the next event
+   */
+  void unbindConditions() { bound_ = false; }
+
+  /**
+   * Check that the bound conditions can be used for an event
+   *
+   * @param[in] header header of the event
+   * @returns true if onNewRun was called and all of the conditions
+   * it looked up are valid for the event
+   */
+  bool conditionsValidFor(const ldmx::EventHeader& header) const;
+
   /**
    * Record the configuration of this detector into the run header.
    *
@@ -110,6 +145,8 @@ class SensitiveDetector : public G4VSensitiveDetector {
    * Get a condition object from the conditions interface
    *
    * Used in the same way that EventProcessors can retrieve conditions.
+   * Calling this while stepping is slow, get the conditions in onNewRun
+   * instead.
    *
    * @tparam[in,out] T type of condition to get
    * @param[in] name name of condition to get
@@ -117,7 +154,12 @@ class SensitiveDetector : public G4VSensitiveDetector {
    */
   template <class T>
   const T& getCondition(const std::string& condition_name) {
-    return conditions_interface_.getCondition<T>(condition_name);
+    const T& condition{conditions_interface_.getCondition<T>(condition_name)};
+    if (binding_) {
+      bound_iovs_.push_back(
+          conditions_interface_.getConditionIOV(condition_name));
+    }
+    return condition;
   }
 
   /**
@@ -143,6 +185,15 @@ class SensitiveDetector : public G4VSensitiveDetector {
   /// Handle to our interface to conditions objects
   simcore::ConditionsInterface& conditions_interface_;
 
+  /// intervals of validity of the conditions looked up in onNewRun
+  std::vector<framework::ConditionsIOV> bound_iovs_;
+
+  /// are we in onNewRun?
+  bool binding_{false};
+
+  /// has onNewRun been called since the conditions were unbound?
+  bool bound_{false};
+
 };  // SensitiveDetector
 }  // namespace simcore
 
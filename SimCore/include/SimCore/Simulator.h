@@ -42,6 +42,12 @@ namespace simcore {
  * Most (if not all) of the heavy lifting is done in the classes in the
  * Sim* modules.  This producer is mainly focused on calling appropriate
  * functions at the right time in the processing chain.
+ *
+ * With numThreads larger than one, Geant4 simulates batches of events
+ * on its own worker threads and the finished events are handed back
+ * one at a time in the order Geant4 started them.
+ *
+ * @see MTRunManager
  */
 class Simulator : public SimulatorBase {
  public:
@@ -108,6 +114,19 @@ class Simulator : public SimulatorBase {
    */
   void setSeeds(std::vector<int> seeds);
 
+  /**
+   * Collect the next event simulated by the worker threads
+   *
+   * When all of the events of the last batch have been collected,
+   * the workers simulate the next batch of events. The last batch is
+   * made smaller so that only the events left before reaching the
+   * event limit of the process are simulated. The events are collected
+   * in the order Geant4 numbered them.
+   *
+   * @param event The event to add the products to.
+   */
+  void produceFromStream(framework::Event& event);
+
  private:
   /// Number of events started
   int numEventsBegan_{0};
@@ -117,6 +136,15 @@ class Simulator : public SimulatorBase {
 
   /// the run number (for accessing the run header in onFileClose
   int run_{-1};
+
+  /// Number of events the workers simulate at once
+  int eventsPerBatch_{1000};
+
+  /// Number of events in the current batch
+  int batchSize_{0};
+
+  /// Geant4 ID of the next event to collect from the current batch
+  int nextEventID_{0};
 };
 }  // namespace simcore
 
@@ -15,6 +15,7 @@
 #include "SimCore/G4Session.h"
 #include "SimCore/G4User/TrackingAction.h"
 #include "SimCore/Geo/ParserFactory.h"
+#include "SimCore/MTRunManager.h"
 #include "SimCore/RunManager.h"
 #include "SimCore/SensitiveDetector.h"
 #include "SimCore/UserEventInformation.h"
@@ -43,8 +44,13 @@ class SimulatorBase : public framework::Producer {
   /// User interface handle
   G4UImanager* uiManager_{nullptr};
 
-  /// Manager controlling G4 simulation run
-  std::unique_ptr<RunManager> runManager_;
+  /**
+   * Manager controlling G4 simulation run
+   *
+   * This is a RunManager when simulating on the calling thread
+   * and an MTRunManager when simulating on several worker threads.
+   */
+  std::unique_ptr<G4RunManager> runManager_;
 
   /// Handle to the G4Session -> how to deal with G4cout and G4cerr
   std::unique_ptr<G4UIsession> sessionHandle_;
@@ -59,6 +65,8 @@ class SimulatorBase : public framework::Producer {
 
   /// Vebosity for the simulation
   int verbosity_{1};
+  /// Number of Geant4 worker threads, 1 to simulate on the calling thread
+  int numThreads_{1};
   /// The parameters used to configure the simulation
   framework::config::Parameters parameters_;
 
@@ -74,6 +82,13 @@ class SimulatorBase : public framework::Producer {
    */
   virtual void updateEventHeader(ldmx::EventHeader& eventHeader) const;
 
+  /*
+   * Update the event header properties from a specific Geant4 event,
+   * used on the worker threads when simulating with several threads
+   */
+  void updateEventHeader(ldmx::EventHeader& eventHeader,
+                         const G4Event* g4event) const;
+
   /*
    * Save all tracks from the event that are marked for saving
    */
@@ -84,6 +99,12 @@ class SimulatorBase : public framework::Producer {
    */
   virtual void saveSDHits(framework::Event& event);
 
+  /**
+   * Make sure the conditions bound into the sensitive detectors are valid
+   * for the coming event, binding them again if they aren't
+   */
+  void bindConditions(const ldmx::EventHeader& eventHeader);
+
   virtual void produce(framework::Event& event) override = 0;
 
  private:
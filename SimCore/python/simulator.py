@@ -74,6 +74,12 @@ class simulator(Producer):
         Prefix to prepend any Geant4 logging files
     rootPrimaryGenUseSeed : bool, optional
         Use the seed stored in the EventHeader for random generation
+    numThreads : int, optional
+        Number of Geant4 worker threads, 1 simulates on the processing thread.
+        With more threads, the generators must be thread safe.
+    eventsPerBatch : int, optional
+        Number of events the worker threads simulate at once when numThreads > 1,
+        the last batch only has the events left before reaching maxEvents
     verbosity : int, optional
         Verbosity level to print
     """
@@ -99,6 +105,8 @@ class simulator(Producer):
         self.biasing_operators = [ ]
         self.logging_prefix = ''
         self.rootPrimaryGenUseSeed = False
+        self.numThreads = 1
+        self.eventsPerBatch = 1000
         self.validate_detector = False
         self.verbosity = 0
 
@@ -194,6 +202,7 @@ class simulator(Producer):
         """
         resimulator = self
         resimulator.className = 'simcore::ReSimulator'
+        resimulator.numThreads = 1
         if which_events is None:
             resimulator.resimulate_all_events = True
             resimulator.care_about_run = False
@@ -1,6 +1,8 @@
 #include "SimCore/DetectorConstruction.h"
 
 #include "Framework/Exception/Exception.h"
+#include "G4Threading.hh"
+#include "SimCore/MagneticFieldStore.h"
 #include "SimCore/SensitiveDetector.h"
 #include "SimCore/XsecBiasingOperator.h"
 
@@ -145,7 +147,20 @@ void DetectorConstruction::ConstructSDandField() {
     }
   }
 
-  // Biasing operators were created in RunManager::setupPhysics
+  if (G4Threading::IsWorkerThread()) {
+    // worker threads start without field managers or biasing operators,
+    // the master made its own while the geometry and physics were set up
+    MagneticFieldStore::getInstance()->constructFieldManagers();
+    for (auto& bop :
+         parameters_.getParameter<std::vector<framework::config::Parameters>>(
+             "biasing_operators", {})) {
+      simcore::XsecBiasingOperator::Factory::get().make(
+          bop.getParameter<std::string>("class_name"),
+          bop.getParameter<std::string>("instance_name"), bop);
+    }
+  }
+
+  // Biasing operators were created in RunManager::makePhysicsList
   //  which is called before G4RunManager::Initialize
   //  which is where this method ends up being called.
   simcore::XsecBiasingOperator::Factory::get().apply([&](auto bop) {
@@ -48,4 +48,25 @@ void SimTrackerHit::setMomentum(const float px, const float py,
   this->py_ = py;
   this->pz_ = pz;
 }
+void SimTrackerHitColumns::fill(const std::vector<SimTrackerHit> &hits) {
+  const std::size_t n{hits.size()};
+  for (auto *column : {&id_, &trackID_, &pdgID_}) column->resize(n);
+  for (auto *column : {&x_, &y_, &z_, &px_, &py_, &pz_, &edep_, &time_})
+    column->resize(n);
+  for (std::size_t i{0}; i < n; ++i) {
+    const SimTrackerHit &hit{hits[i]};
+    id_[i] = hit.getID();
+    trackID_[i] = hit.getTrackID();
+    pdgID_[i] = hit.getPdgID();
+    x_[i] = hit.getX();
+    y_[i] = hit.getY();
+    z_[i] = hit.getZ();
+    px_[i] = hit.getPx();
+    py_[i] = hit.getPy();
+    pz_[i] = hit.getPz();
+    edep_[i] = hit.getEdep();
+    time_[i] = hit.getTime();
+  }
+}
+
 }  // namespace ldmx
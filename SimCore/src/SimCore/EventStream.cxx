@@ -0,0 +1,62 @@
+#include "SimCore/EventStream.h"
+
+#include "SimCore/RunManager.h"
+#include "SimCore/SensitiveDetector.h"
+
+/*~~~~~~~~~~~~*/
+/*   Geant4   */
+/*~~~~~~~~~~~~*/
+#include "G4Event.hh"
+
+namespace simcore {
+
+namespace {
+/// the stream actions have no configuration
+framework::config::Parameters no_parameters;
+}  // namespace
+
+EventStream::Action::Action(EventStream& stream)
+    : UserAction("EventStream", no_parameters), stream_{stream} {}
+
+void EventStream::Action::BeginOfRunAction(const G4Run*) {
+  SensitiveDetector::Factory::get().apply(
+      [](auto sd) { sd->bindConditions(); });
+}
+
+void EventStream::Action::EndOfEventAction(const G4Event* event) {
+  stream_.push(event);
+  RunManager::resetDarkBrem();
+}
+
+void EventStream::push(const G4Event* event) {
+  Staged staged;
+  staged.aborted_ = event->IsAborted();
+  staged.seed_ = event->GetRandomNumberStatus();
+  if (staged.aborted_) {
+    // clean up the hits of the aborted event
+    SensitiveDetector::Factory::get().apply(
+        [](auto sd) { sd->OnFinishedEvent(); });
+  } else {
+    staged.event_ = std::make_unique<framework::Event>(pass_name_);
+    stager_(event, *staged.event_);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  staged_[event->GetEventID()] = std::move(staged);
+}
+
+bool EventStream::pop(int event_id, Staged& staged) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it{staged_.find(event_id)};
+  if (it == staged_.end()) return false;
+  staged = std::move(it->second);
+  staged_.erase(it);
+  return true;
+}
+
+std::size_t EventStream::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return staged_.size();
+}
+
+}  // namespace simcore
@@ -0,0 +1,103 @@
+#include "SimCore/G4User/ActionInitialization.h"
+
+#include <memory>
+
+#include "SimCore/EventStream.h"
+#include "SimCore/G4User/EventAction.h"
+#include "SimCore/G4User/PrimaryGeneratorAction.h"
+#include "SimCore/G4User/RunAction.h"
+#include "SimCore/G4User/StackingAction.h"
+#include "SimCore/G4User/SteppingAction.h"
+#include "SimCore/G4User/TrackingAction.h"
+#include "SimCore/PrimaryGenerator.h"
+#include "SimCore/UserAction.h"
+
+/*~~~~~~~~~~~~*/
+/*   Geant4   */
+/*~~~~~~~~~~~~*/
+#include "G4RunManager.hh"
+
+namespace simcore::g4user {
+
+namespace {
+/// the stream action of each worker, owned here since G4 doesn't
+thread_local std::unique_ptr<EventStream::Action> stream_action;
+}  // namespace
+
+void ActionInitialization::BuildForMaster() const {
+  SetUserAction(new RunAction);
+
+  auto generators{
+      parameters_.getParameter<std::vector<framework::config::Parameters>>(
+          "generators", {})};
+  if (generators.empty()) {
+    EXCEPTION_RAISE("MissingGenerator",
+                    "Need to define some generator of primaries.");
+  }
+
+  for (auto& generator : generators) {
+    auto gen{PrimaryGenerator::Factory::get().make(
+        generator.getParameter<std::string>("class_name"),
+        generator.getParameter<std::string>("instance_name"), generator)};
+    if (not gen->isThreadSafe()) {
+      EXCEPTION_RAISE("NotThreadSafe",
+                      "The generator '" +
+                          generator.getParameter<std::string>("instance_name") +
+                          "' can't be used with several threads.");
+    }
+  }
+}
+
+void ActionInitialization::Build() const {
+  // create our G4User actions
+  auto primary_action{new PrimaryGeneratorAction(parameters_)};
+  auto run_action{new RunAction};
+  auto event_action{new EventAction};
+  auto tracking_action{new TrackingAction};
+  auto stepping_action{new SteppingAction};
+  auto stacking_action{new StackingAction};
+  // ...and register them with G4
+  SetUserAction(primary_action);
+  SetUserAction(run_action);
+  SetUserAction(event_action);
+  SetUserAction(tracking_action);
+  SetUserAction(stepping_action);
+  SetUserAction(stacking_action);
+
+  // Create all user actions and attch them to the corresponding G4 actions
+  auto user_actions{
+      parameters_.getParameter<std::vector<framework::config::Parameters>>(
+          "actions", {})};
+  for (auto& user_action : user_actions) {
+    auto ua = UserAction::Factory::get().make(
+        user_action.getParameter<std::string>("class_name"),
+        user_action.getParameter<std::string>("instance_name"), user_action);
+    for (auto& type : ua->getTypes()) {
+      if (type == simcore::TYPE::RUN) {
+        run_action->registerAction(ua.get());
+      } else if (type == simcore::TYPE::EVENT) {
+        event_action->registerAction(ua.get());
+      } else if (type == simcore::TYPE::TRACKING) {
+        tracking_action->registerAction(ua.get());
+      } else if (type == simcore::TYPE::STEPPING) {
+        stepping_action->registerAction(ua.get());
+      } else if (type == simcore::TYPE::STACKING) {
+        stacking_action->registerAction(ua.get());
+      } else {
+        EXCEPTION_RAISE("ActionType", "Action type does not exist.");
+      }
+    }
+  }
+
+  if (stream_) {
+    // stage the events after all of the other event actions (filters)
+    // have had their say, keeping the state of the engine to store
+    // the seed of each event
+    stream_action = std::make_unique<EventStream::Action>(*stream_);
+    run_action->registerAction(stream_action.get());
+    event_action->registerAction(stream_action.get());
+    G4RunManager::GetRunManager()->StoreRandomNumberStatusToG4Event(1);
+  }
+}
+
+}  // namespace simcore::g4user
@@ -76,10 +76,8 @@ void AuxInfoReader::assignAuxInfoToVolumes() {
         G4MagneticField* magField =
             MagneticFieldStore::getInstance()->getMagneticField(magFieldName);
         if (magField != nullptr) {
-          auto mgr = new G4FieldManager(magField);
-          lv->SetFieldManager(
-              mgr,
-              true /* FIXME: hard-coded to force field manager to daughters */);
+          MagneticFieldStore::getInstance()->assignMagneticField(lv,
+                                                                 magFieldName);
           // G4cout << "Assigned magnetic field " << magFieldName << " to
           // volume " << lv->GetName() << G4endl;
         } else {
@@ -138,6 +136,7 @@ void AuxInfoReader::createMagneticField(const G4String& magFieldName,
   }
 
   G4MagneticField* magField = nullptr;
+  bool isGlobalField{false};
 
   // Create a uniform mag field using the built-in Geant4 type.
   if (magFieldType == "G4UniformMagField") {
@@ -198,13 +197,7 @@ void AuxInfoReader::createMagneticField(const G4String& magFieldName,
         new MagneticFieldMap3D(fileName.c_str(), offsetX, offsetY, offsetZ);
 
     // Assign field map as global field.
-    G4FieldManager* fieldMgr =
-        G4TransportationManager::GetTransportationManager()->GetFieldManager();
-    if (fieldMgr->GetDetectorField() != nullptr) {
-      EXCEPTION_RAISE("MisAssign", "Global mag field was already assigned.");
-    }
-    fieldMgr->SetDetectorField(magField);
-    fieldMgr->CreateChordFinder(magField);
+    isGlobalField = true;
 
   } else {
     EXCEPTION_RAISE("UnknownType", "Unknown MagFieldType '" +
@@ -213,6 +206,9 @@ void AuxInfoReader::createMagneticField(const G4String& magFieldName,
   }
 
   MagneticFieldStore::getInstance()->addMagneticField(magFieldName, magField);
+  if (isGlobalField) {
+    MagneticFieldStore::getInstance()->setGlobalField(magFieldName);
+  }
 }
 
 void AuxInfoReader::createRegion(const G4String& name,
@@ -0,0 +1,30 @@
+#include "SimCore/MTRunManager.h"
+
+#include "SimCore/DetectorConstruction.h"
+#include "SimCore/G4User/ActionInitialization.h"
+#include "SimCore/RunManager.h"
+
+namespace simcore {
+
+MTRunManager::MTRunManager(framework::config::Parameters& parameters,
+                           ConditionsInterface&, const std::string& pass_name,
+                           int n_threads)
+    : parameters_{parameters}, stream_{pass_name} {
+  SetNumberOfThreads(n_threads);
+}
+
+void MTRunManager::Initialize() {
+  this->SetUserInitialization(RunManager::makePhysicsList(parameters_));
+
+  RunManager::registerParallelWorld(
+      parameters_, static_cast<DetectorConstruction*>(this->userDetector));
+
+  // actions of the master are built now,
+  // the actions of the workers when they start
+  this->SetUserInitialization(
+      new g4user::ActionInitialization(parameters_, &stream_));
+
+  G4MTRunManager::Initialize();
+}
+
+}  // namespace simcore
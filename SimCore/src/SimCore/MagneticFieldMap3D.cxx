@@ -26,6 +26,59 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
       invertX_(false),
       invertY_(false),
       invertZ_(false) {
+  G4cout << "-----------------------------------------------------------"
+         << G4endl;
+  G4cout << "    Magnetic Field Map 3D" << G4endl;
+  G4cout << "-----------------------------------------------------------"
+         << G4endl << G4endl;
+
+  std::string binary{ldmx::FieldMapFile::findBinary(filename)};
+  if (binary.empty()) {
+    readText(filename);
+  } else {
+    mapBinary(binary);
+  }
+
+  G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm "
+         << G4endl;
+  G4cout << "  Max values: " << maxx_ << " " << maxy_ << " " << maxz_ << " mm "
+         << G4endl;
+  G4cout << "  Field offsets: " << xOffset_ << " " << yOffset_ << " "
+         << zOffset_ << " mm " << G4endl << G4endl;
+
+  // Should really check that the limits are not the wrong way around.
+  if (maxx_ < minx_) {
+    swap(maxx_, minx_);
+    invertX_ = true;
+  }
+  if (maxy_ < miny_) {
+    swap(maxy_, miny_);
+    invertY_ = true;
+  }
+  if (maxz_ < minz_) {
+    swap(maxz_, minz_);
+    invertZ_ = true;
+  }
+
+  G4cout << "After reordering if necessary" << G4endl;
+  G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm "
+         << G4endl;
+  G4cout << "  Max values: " << maxx_ << " " << maxy_ << " " << maxz_ << " mm "
+         << G4endl;
+  ;
+
+  dx_ = maxx_ - minx_;
+  dy_ = maxy_ - miny_;
+  dz_ = maxz_ - minz_;
+
+  G4cout << "  Range of values: " << dx_ << " " << dy_ << " " << dz_ << " mm"
+         << G4endl << G4endl;
+  G4cout << "Done loading field map" << G4endl << G4endl;
+  G4cout << "-----------------------------------------------------------"
+         << G4endl << G4endl;
+}
+
+void MagneticFieldMap3D::readText(const char* filename) {
   ifstream file(filename);  // Open the file for reading.
 
   // Throw an error if file does not exist.
@@ -34,14 +87,8 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
                                    "' does not exist!");
   }
 
-  G4cout << "-----------------------------------------------------------"
-         << G4endl;
-  G4cout << "    Magnetic Field Map 3D" << G4endl;
-  G4cout << "-----------------------------------------------------------"
-         << G4endl << G4endl;
-
   G4cout << "Reading the field grid from " << filename << " ... " << endl;
-  G4cout << "  Offsets: " << xOffset << " " << yOffset << " " << zOffset
+  G4cout << "  Offsets: " << xOffset_ << " " << yOffset_ << " " << zOffset_
          << G4endl;
 
   // Ignore first blank line
@@ -54,20 +101,7 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
   G4cout << "  Number of values: " << nx_ << " " << ny_ << " " << nz_ << G4endl;
 
   // Set up storage space for table
-  xField_.resize(nx_);
-  yField_.resize(nx_);
-  zField_.resize(nx_);
-  int ix, iy, iz;
-  for (ix = 0; ix < nx_; ix++) {
-    xField_[ix].resize(ny_);
-    yField_[ix].resize(ny_);
-    zField_[ix].resize(ny_);
-    for (iy = 0; iy < ny_; iy++) {
-      xField_[ix][iy].resize(nz_);
-      yField_[ix][iy].resize(nz_);
-      zField_[ix][iy].resize(nz_);
-    }
-  }
+  table_.resize(3 * std::size_t(nx_) * ny_ * nz_);
 
   // Ignore other header information
   // The first line whose second character is '0' is considered to
@@ -78,18 +112,19 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
 
   // Read in the data
   double xval, yval, zval, bx, by, bz;
-  for (ix = 0; ix < nx_; ix++) {
-    for (iy = 0; iy < ny_; iy++) {
-      for (iz = 0; iz < nz_; iz++) {
+  std::size_t i_value{0};
+  for (int ix = 0; ix < nx_; ix++) {
+    for (int iy = 0; iy < ny_; iy++) {
+      for (int iz = 0; iz < nz_; iz++) {
         file >> xval >> yval >> zval >> bx >> by >> bz;
         if (ix == 0 && iy == 0 && iz == 0) {
           minx_ = xval;
           miny_ = yval;
           minz_ = zval;
         }
-        xField_[ix][iy][iz] = bx;
-        yField_[ix][iy][iz] = by;
-        zField_[ix][iy][iz] = bz;
+        table_[i_value++] = bx;
+        table_[i_value++] = by;
+        table_[i_value++] = bz;
       }
     }
   }
@@ -99,46 +134,40 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
   maxy_ = yval;
   maxz_ = zval;
 
+  field_ = table_.data();
+  fieldScale_ = 1.;
+
   G4cout << "  ... done reading " << G4endl << G4endl;
   G4cout << "Read values of field from file " << filename << G4endl;
   G4cout << "  Assumed the order: x, y, z, Bx, By, Bz" << G4endl;
-  G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm "
-         << G4endl;
-  G4cout << "  Max values: " << maxx_ << " " << maxy_ << " " << maxz_ << " mm "
-         << G4endl;
-  G4cout << "  Field offsets: " << xOffset_ << " " << yOffset_ << " "
-         << zOffset_ << " mm " << G4endl << G4endl;
+}
 
-  // Should really check that the limits are not the wrong way around.
-  if (maxx_ < minx_) {
-    swap(maxx_, minx_);
-    invertX_ = true;
-  }
-  if (maxy_ < miny_) {
-    swap(maxy_, miny_);
-    invertY_ = true;
-  }
-  if (maxz_ < minz_) {
-    swap(maxz_, minz_);
-    invertZ_ = true;
-  }
+void MagneticFieldMap3D::mapBinary(const std::string& filename) {
+  binary_ = std::make_unique<ldmx::FieldMapFile>(filename);
+  const auto& header{binary_->header()};
 
-  G4cout << "After reordering if necessary" << G4endl;
-  G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm "
-         << G4endl;
-  G4cout << "  Max values: " << maxx_ << " " << maxy_ << " " << maxz_ << " mm "
+  G4cout << "Using the binary field grid " << filename << G4endl;
+  G4cout << "  Offsets: " << xOffset_ << " " << yOffset_ << " " << zOffset_
          << G4endl;
-  ;
 
-  dx_ = maxx_ - minx_;
-  dy_ = maxy_ - miny_;
-  dz_ = maxz_ - minz_;
+  nx_ = binary_->n(0);
+  ny_ = binary_->n(1);
+  nz_ = binary_->n(2);
 
-  G4cout << "  Range of values: " << dx_ << " " << dy_ << " " << dz_ << " mm"
-         << G4endl << G4endl;
-  G4cout << "Done loading field map" << G4endl << G4endl;
-  G4cout << "-----------------------------------------------------------"
-         << G4endl << G4endl;
+  G4cout << "  Number of values: " << nx_ << " " << ny_ << " " << nz_ << G4endl;
+
+  // binary maps are always stored with increasing coordinates
+  double length_unit{header.length_unit_ * mm};
+  minx_ = header.min_[0] * length_unit;
+  miny_ = header.min_[1] * length_unit;
+  minz_ = header.min_[2] * length_unit;
+  maxx_ = header.max_[0] * length_unit;
+  maxy_ = header.max_[1] * length_unit;
+  maxz_ = header.max_[2] * length_unit;
+
+  field_ = binary_->values();
+  fieldScale_ = header.field_unit_ * tesla;
+  G4cout << G4endl;
 }
 
 void MagneticFieldMap3D::GetFieldValue(const double point[4],
@@ -201,54 +230,23 @@ void MagneticFieldMap3D::GetFieldValue(const double point[4],
 #endif
 
     // Full 3-dimensional version
-    bfield[0] =
-        xField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        xField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        xField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        xField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        xField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        xField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        xField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        xField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-    bfield[1] =
-        yField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        yField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        yField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        yField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        yField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        yField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        yField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        yField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-    bfield[2] =
-        zField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        zField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        zField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        zField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        zField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        zField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        zField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        zField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
+    const std::size_t stride_z{3}, stride_y{stride_z * nz_},
+        stride_x{stride_y * ny_};
+    const double* corner{field_ + xindex * stride_x + yindex * stride_y +
+                         zindex * stride_z};
+    for (int i = 0; i < 3; i++) {
+      const double* b{corner + i};
+      bfield[i] =
+          (b[0] * (1 - xlocal) * (1 - ylocal) * (1 - zlocal) +
+           b[stride_z] * (1 - xlocal) * (1 - ylocal) * zlocal +
+           b[stride_y] * (1 - xlocal) * ylocal * (1 - zlocal) +
+           b[stride_y + stride_z] * (1 - xlocal) * ylocal * zlocal +
+           b[stride_x] * xlocal * (1 - ylocal) * (1 - zlocal) +
+           b[stride_x + stride_z] * xlocal * (1 - ylocal) * zlocal +
+           b[stride_x + stride_y] * xlocal * ylocal * (1 - zlocal) +
+           b[stride_x + stride_y + stride_z] * xlocal * ylocal * zlocal) *
+          fieldScale_;
+    }
 
   } else {
     bfield[0] = 0.0;
@@ -3,6 +3,11 @@
 namespace simcore {
 
 void ReSimulator::configure(framework::config::Parameters& parameters) {
+  if (parameters.getParameter<int>("numThreads", 1) > 1) {
+    EXCEPTION_RAISE("InvalidParam",
+                    "Events are resimulated one at a time from their seeds, "
+                    "the resimulator can't use several threads.");
+  }
   SimulatorBase::configure(parameters);
   resimulate_all_events_ =
       parameters.getParameter<bool>("resimulate_all_events");
@@ -44,6 +49,7 @@ void ReSimulator::produce(framework::Event& event) {
 
   std::istringstream iss(eventHeader.getStringParameter("eventSeed"));
   G4Random::restoreFullState(iss);
+  bindConditions(eventHeader);
   runManager_->ProcessOneEvent(eventNumber);
   if (verbosity_ > 1) {
     std::cout << "Finished with event number " << eventNumber << std::endl;
@@ -1,5 +1,8 @@
 #include "SimCore/SDs/EcalSD.h"
 
+#include <algorithm>
+#include <numeric>
+
 // Geant4
 #include "G4Polyhedron.hh"
 #include "G4Step.hh"
@@ -23,10 +26,14 @@ EcalSD::EcalSD(const std::string& name, simcore::ConditionsInterface& ci,
   compressHitContribs_ = p.getParameter<bool>("compressHitContribs");
 }
 
+void EcalSD::onNewRun() {
+  geometry_ = &getCondition<ldmx::EcalGeometry>(
+      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
+}
+
 G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   static const int layer_depth = 2;  // index depends on GDML implementation
-  const auto& geometry = getCondition<ldmx::EcalGeometry>(
-      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
+  const auto& geometry{*geometry_};
 
   // Get the edep from the step.
   G4double edep = aStep->GetTotalEnergyDeposit();
@@ -92,10 +99,11 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   //    is inside of the configured SD volumes from Geant4's point of view
   // ldmx::EcalID id = geometry.getID(position[0], position[1], position[2]);
 
-  if (hits_.find(id) == hits_.end()) {
+  int cell_i = cellIndex_.insert(id.raw(), cells_.size());
+  if (cell_i == int(cells_.size())) {
     // hit in empty cell
-    auto& hit = hits_[id];
-    hit.setID(id.raw());
+    Cell& cell = cells_.emplace_back();
+    cell.id_ = id;
     /**
      * convert position to center of cell position
      *
@@ -106,10 +114,12 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
      * than the cell center; however, that is up for more discussion.
      */
     auto [x, y, z] = geometry.getPosition(id);
-    hit.setPosition(x, y, z);
+    cell.x_ = x;
+    cell.y_ = y;
+    cell.z_ = z;
   }
 
-  auto& hit = hits_[id];
+  Cell& cell = cells_[cell_i];
 
   // hit variables
   auto track = aStep->GetTrack();
@@ -118,18 +128,36 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   auto pdg = track->GetParticleDefinition()->GetPDGEncoding();
 
   if (enableHitContribs_) {
-    int contrib_i = hit.findContribIndex(track_id, pdg);
-    if (compressHitContribs_ and contrib_i != -1) {
-      hit.updateContrib(contrib_i, edep, time);
+    // the contribs are stored with single precision
+    float contrib_edep = edep, contrib_time = time;
+    int contrib_i = contribs_.size();
+    if (compressHitContribs_) {
+      contrib_i =
+          contribIndex_.insert(ContribKey{cell_i, track_id, pdg}, contrib_i);
+    }
+    if (contrib_i < int(contribs_.size())) {
+      Contrib& contrib = contribs_[contrib_i];
+      contrib.edep_ += contrib_edep;
+      if (contrib_time < contrib.time_) contrib.time_ = contrib_time;
+      cell.edep_ += contrib_edep;
     } else {
-      hit.addContrib(getTrackMap().findIncident(track_id), track_id, pdg, edep,
-                     time);
+      contribs_.push_back(Contrib{getTrackMap().findIncident(track_id),
+                                  track_id, pdg, contrib_edep, contrib_time});
+      if (cell.last_ < 0)
+        cell.first_ = contrib_i;
+      else
+        contribs_[cell.last_].next_ = contrib_i;
+      cell.last_ = contrib_i;
+      cell.edep_ += contrib_edep;
+      if (contrib_time < cell.time_ or cell.time_ == 0) {
+        cell.time_ = contrib_time;
+      }
     }
   } else {
     // no hit contribs and hit already exists
-    hit.setEdep(hit.getEdep() + edep);
-    if (time < hit.getTime() or hit.getTime() == 0) {
-      hit.setTime(time);
+    cell.edep_ = cell.edep_ + edep;
+    if (time < cell.time_ or cell.time_ == 0) {
+      cell.time_ = time;
     }
   }
 
@@ -137,11 +165,36 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
 }
 
 void EcalSD::saveHits(framework::Event& event) {
-  // squash hits into list
-  std::vector<ldmx::SimCalorimeterHit> hits;
-  hits.reserve(hits_.size());
-  for (const auto& [id, hit] : hits_) hits.push_back(hit);
-  event.add(COLLECTION_NAME, hits);
+  // squash cells into list of hits ordered by ID
+  order_.resize(cells_.size());
+  std::iota(order_.begin(), order_.end(), 0);
+  std::sort(order_.begin(), order_.end(), [this](int lhs, int rhs) {
+    return cells_[lhs].id_ < cells_[rhs].id_;
+  });
+  hits_.resize(cells_.size());
+  for (std::size_t i{0}; i < order_.size(); i++) {
+    const Cell& cell{cells_[order_[i]]};
+    auto& hit{hits_[i]};
+    hit.Clear();
+    hit.setID(cell.id_.raw());
+    hit.setPosition(cell.x_, cell.y_, cell.z_);
+    for (int c{cell.first_}; c >= 0; c = contribs_[c].next_) {
+      const Contrib& contrib{contribs_[c]};
+      hit.addContrib(contrib.incident_, contrib.track_, contrib.pdg_,
+                     contrib.edep_, contrib.time_);
+    }
+    // the totals were accumulated step by step
+    hit.setEdep(cell.edep_);
+    hit.setTime(cell.time_);
+  }
+  event.add(COLLECTION_NAME, hits_);
+}
+
+void EcalSD::OnFinishedEvent() {
+  cells_.clear();
+  cellIndex_.clear();
+  contribs_.clear();
+  contribIndex_.clear();
 }
 
 }  // namespace simcore
@@ -8,6 +8,7 @@
 
 // STL
 #include <iostream>
+#include <iterator>
 
 // Geant4
 #include "G4Box.hh"
@@ -26,6 +27,11 @@ HcalSD::HcalSD(const std::string& name, simcore::ConditionsInterface& ci,
       p.getParameter<std::vector<std::string>>("gdml_identifiers")};
 }
 
+void HcalSD::onNewRun() {
+  geometry_ = &getCondition<ldmx::HcalGeometry>(
+      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
+}
+
 ldmx::HcalID HcalSD::decodeCopyNumber(const std::uint32_t copyNumber,
                                       const G4ThreeVector& localPosition,
                                       const G4Box* scint) {
@@ -35,8 +41,7 @@ ldmx::HcalID HcalSD::decodeCopyNumber(const std::uint32_t copyNumber,
     return ldmx::HcalID{Index(copyNumber).field2(), Index(copyNumber).field1(),
                         Index(copyNumber).field0()};
   }
-  const auto& geometry = getCondition<ldmx::HcalGeometry>(
-      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
+  const auto& geometry{*geometry_};
   unsigned int stripID = 0;
   const unsigned int section = copyNumber / 1000;
   const unsigned int layer = copyNumber % 1000;
@@ -113,8 +118,16 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
   // update edep to include birksFactor
   edep *= birksFactor;
 
-  // Create a new cal hit.
-  ldmx::SimCalorimeterHit& hit{hits_.emplace_back()};
+  // Create a new cal hit, reusing one from a previous event if we can.
+  // All of the members not reset by Clear are set below.
+  if (spare_.empty()) {
+    hits_.emplace_back();
+  } else {
+    hits_.push_back(std::move(spare_.back()));
+    spare_.pop_back();
+    hits_.back().Clear();
+  }
+  ldmx::SimCalorimeterHit& hit{hits_.back()};
 
   // Get the scintillator solid box
   G4Box* scint = nullptr;
@@ -183,8 +196,7 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
   // Convert back to mm
   hit.setPathLength(stepLength * CLHEP::cm / CLHEP::mm);
   hit.setVelocity(track->GetVelocity());
-  const auto& geometry = getCondition<ldmx::HcalGeometry>(
-      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
+  const auto& geometry{*geometry_};
   // Convert pre/post step position from global coordinates to coordinates
   // within the scintillator bar
   const auto localPreStepPoint{
@@ -215,6 +227,12 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
   return true;
 }
 
+void HcalSD::OnFinishedEvent() {
+  spare_.insert(spare_.end(), std::make_move_iterator(hits_.begin()),
+                std::make_move_iterator(hits_.end()));
+  hits_.clear();
+}
+
 }  // namespace simcore
 
 DECLARE_SENSITIVEDETECTOR(simcore::HcalSD)
@@ -1,5 +1,7 @@
 #include "SimCore/SensitiveDetector.h"
 
+#include <algorithm>
+
 #include "Framework/Exception/Exception.h"
 #include "G4ChargedGeantino.hh"
 #include "G4Geantino.hh"
@@ -22,4 +24,25 @@ bool SensitiveDetector::isGeantino(const G4Step* step) const {
           particle_def == G4ChargedGeantino::Definition());
 }
 
+void SensitiveDetector::bindConditions() {
+  bound_iovs_.clear();
+  binding_ = true;
+  try {
+    onNewRun();
+  } catch (...) {
+    binding_ = false;
+    throw;
+  }
+  binding_ = false;
+  bound_ = true;
+}
+
+bool SensitiveDetector::conditionsValidFor(
+    const ldmx::EventHeader& header) const {
+  return bound_ and std::all_of(bound_iovs_.begin(), bound_iovs_.end(),
+                                [&header](const auto& iov) {
+                                  return iov.validForEvent(header);
+                                });
+}
+
 }  // namespace simcore
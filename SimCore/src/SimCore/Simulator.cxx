@@ -20,9 +20,11 @@
 /*~~~~~~~~~~~~~*/
 #include "SimCore/APrimePhysics.h"
 #include "SimCore/DetectorConstruction.h"
+#include "SimCore/EventStream.h"
 #include "SimCore/G4Session.h"
 #include "SimCore/G4User/TrackingAction.h"
 #include "SimCore/Geo/ParserFactory.h"
+#include "SimCore/MTRunManager.h"
 #include "SimCore/PrimaryGenerator.h"
 #include "SimCore/SensitiveDetector.h"
 #include "SimCore/UserEventInformation.h"
@@ -47,13 +49,32 @@ Simulator::Simulator(const std::string& name, framework::Process& process)
 
 void Simulator::configure(framework::config::Parameters& parameters) {
   SimulatorBase::configure(parameters);
+  if (numThreads_ > 1) {
+    eventsPerBatch_ = parameters.getParameter<int>("eventsPerBatch", 1000);
+    if (eventsPerBatch_ < 1) {
+      EXCEPTION_RAISE("InvalidParam",
+                      "Need at least one event per batch, not " +
+                          std::to_string(eventsPerBatch_) + ".");
+    }
+    // start with a new batch
+    batchSize_ = 0;
+    nextEventID_ = 0;
+    // the products of each event are copied out on the worker which
+    // finished it, only touching that worker's detectors and track map
+    static_cast<MTRunManager*>(runManager_.get())
+        ->getEventStream()
+        .setStager([this](const G4Event* g4event, framework::Event& staged) {
+          updateEventHeader(staged.getEventHeader(), g4event);
+          saveTracks(staged);
+          saveSDHits(staged);
+        });
+  }
 }
 
 void Simulator::beforeNewRun(ldmx::RunHeader& header) {
   // Get the detector header from the user detector construction
-  DetectorConstruction* detector =
-      dynamic_cast<RunManager*>(RunManager::GetRunManager())
-          ->getDetectorConstruction();
+  auto detector = static_cast<const DetectorConstruction*>(
+      runManager_->GetUserDetectorConstruction());
 
   header.setDetectorName(detector->getDetectorName());
   header.setDescription(parameters_.getParameter<std::string>("description"));
@@ -126,15 +147,26 @@ void Simulator::onNewRun(const ldmx::RunHeader& runHeader) {
   setSeeds(seeds);
 
   run_ = runHeader.getRunNumber();
+
+  // look the conditions of the sensitive detectors up again before the
+  // first event of the run, the workers do so at the start of each batch
+  SensitiveDetector::Factory::get().apply(
+      [](auto sd) { sd->unbindConditions(); });
 }
 
 void Simulator::produce(framework::Event& event) {
+  if (numThreads_ > 1) {
+    produceFromStream(event);
+    return;
+  }
+
   // Generate and process a Geant4 event.
   numEventsBegan_++;
   // Save the state of the random engine to an output stream. A string
   // is then extracted and saved to the event header.
   std::ostringstream stream;
   G4Random::saveFullState(stream);
+  bindConditions(event.getEventHeader());
   runManager_->ProcessOneEvent(event.getEventHeader().getEventNumber());
 
   // If a Geant4 event has been aborted, skip the rest of the processing
@@ -166,6 +198,51 @@ void Simulator::produce(framework::Event& event) {
   return;
 }
 
+void Simulator::produceFromStream(framework::Event& event) {
+  if (nextEventID_ == batchSize_) {
+    // all of the events of the last batch have been collected,
+    // have the workers simulate the next batch
+    //  the last batch only has the events that are left, unless
+    //  events are retried past the limit (aborted events, totalEvents)
+    batchSize_ = eventsPerBatch_;
+    int left{getEventLimit() - numEventsBegan_};
+    if (left > 0 and left < batchSize_) batchSize_ = left;
+    runManager_->BeamOn(batchSize_);
+    nextEventID_ = 0;
+  }
+
+  EventStream::Staged staged;
+  if (not static_cast<MTRunManager*>(runManager_.get())
+              ->getEventStream()
+              .pop(nextEventID_, staged)) {
+    EXCEPTION_RAISE("MissingEvent", "Geant4 event " +
+                                        std::to_string(nextEventID_) +
+                                        " was not finished by any worker.");
+  }
+  nextEventID_++;
+  numEventsBegan_++;
+
+  // If a Geant4 event has been aborted, skip the rest of the processing
+  // sequence. The workers have already cleaned up after it.
+  if (staged.aborted_) this->abortEvent();
+
+  numEventsCompleted_++;
+
+  // store event-wide information in EventHeader
+  auto& event_header = event.getEventHeader();
+  const auto& staged_header = staged.event_->getEventHeader();
+  event_header.setWeight(staged_header.getWeight());
+  for (const char* name : {"total_photonuclear_energy",
+                           "total_electronuclear_energy", "db_material_z"}) {
+    event_header.setFloatParameter(name,
+                                   staged_header.getFloatParameter(name));
+  }
+
+  event_header.setStringParameter("eventSeed", staged.seed_);
+
+  event.copyProducts(*staged.event_);
+}
+
 void Simulator::onProcessEnd() {
   SimulatorBase::onProcessEnd();
   std::cout << "[ Simulator ] : "
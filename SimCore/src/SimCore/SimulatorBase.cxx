@@ -1,5 +1,8 @@
 #include "SimCore/SimulatorBase.h"
 
+#include "Framework/Process.h"
+#include "G4Event.hh"
+
 namespace simcore {
 
 const std::vector<std::string> SimulatorBase::invalidCommands_ = {
@@ -16,8 +19,12 @@ SimulatorBase::SimulatorBase(const std::string& name,
   uiManager_ = G4UImanager::GetUIpointer();
 }
 void SimulatorBase::updateEventHeader(ldmx::EventHeader& eventHeader) const {
-  auto event_info = static_cast<UserEventInformation*>(
-      runManager_->GetCurrentEvent()->GetUserInformation());
+  updateEventHeader(eventHeader, runManager_->GetCurrentEvent());
+}
+void SimulatorBase::updateEventHeader(ldmx::EventHeader& eventHeader,
+                                      const G4Event* g4event) const {
+  auto event_info =
+      static_cast<UserEventInformation*>(g4event->GetUserInformation());
 
   eventHeader.setWeight(event_info->getWeight());
   eventHeader.setFloatParameter("total_photonuclear_energy",
@@ -28,8 +35,11 @@ void SimulatorBase::updateEventHeader(ldmx::EventHeader& eventHeader) const {
                                 event_info->getDarkBremMaterialZ());
 }
 void SimulatorBase::onProcessEnd() {
-  runManager_->TerminateEventLoop();
-  runManager_->RunTermination();
+  if (numThreads_ == 1) {
+    // the multi-threaded manager finishes its run at the end of each BeamOn
+    runManager_->TerminateEventLoop();
+    runManager_->RunTermination();
+  }
   // Delete Run Manager
   // From Geant4 Basic Example B01:
   //      Job termination
@@ -62,6 +72,9 @@ void SimulatorBase::onProcessStart() {
     }
   }
 
+  // The multi-threaded manager starts a run for each batch of events
+  if (numThreads_ > 1) return;
+
   // Instantiate the scoring worlds including any parallel worlds.
   runManager_->ConstructScoringWorlds();
 
@@ -110,6 +123,12 @@ void SimulatorBase::configure(framework::config::Parameters& parameters) {
   parameters_ = parameters;
   // Set the verbosity level.  The default level  is 0.
   verbosity_ = parameters_.getParameter<int>("verbosity");
+  numThreads_ = parameters_.getParameter<int>("numThreads", 1);
+  if (numThreads_ < 1) {
+    EXCEPTION_RAISE("InvalidParam",
+                    "The simulation needs at least one thread, not " +
+                        std::to_string(numThreads_) + ".");
+  }
 
   preInitCommands_ =
       parameters_.getParameter<std::vector<std::string>>("preInitCommands", {});
@@ -130,7 +149,17 @@ void SimulatorBase::configure(framework::config::Parameters& parameters) {
   // Set up logging before creating the run manager so that output from the
   // creation of the runManager goes to the appropriate place.
   createLogging();
-  runManager_ = std::make_unique<RunManager>(parameters_, conditionsIntf_);
+  if (numThreads_ > 1) {
+#ifndef G4MULTITHREADED
+    EXCEPTION_RAISE("InvalidParam",
+                    "Geant4 was built without multi-threading, the "
+                    "simulation can only use one thread.");
+#endif
+    runManager_ = std::make_unique<MTRunManager>(
+        parameters_, conditionsIntf_, getPassName(), numThreads_);
+  } else {
+    runManager_ = std::make_unique<RunManager>(parameters_, conditionsIntf_);
+  }
   // Instantiate the class so cascade parameters can be set.
   // TODO: Are we actually using this?
   G4CascadeParameters::Instance();
@@ -175,6 +204,12 @@ void SimulatorBase::saveSDHits(framework::Event& event) {
   });
 }
 
+void SimulatorBase::bindConditions(const ldmx::EventHeader& eventHeader) {
+  SensitiveDetector::Factory::get().apply([&eventHeader](auto sd) {
+    if (not sd->conditionsValidFor(eventHeader)) sd->bindConditions();
+  });
+}
+
 void SimulatorBase::buildGeometry() {
   // Instantiate the GDML parser and corresponding messenger owned and
   // managed by DetectorConstruction
@@ -0,0 +1,62 @@
+/**
+ * @file EventStreamTest.cxx
+ * @brief Test the ordering of the events staged by the Geant4 workers
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+#include "G4Event.hh"
+#include "SimCore/EventStream.h"
+
+/**
+ * Test for the EventStream
+ *
+ * - events staged by several threads in any order are handed out
+ *   by their Geant4 event ID
+ * - aborted events are handed out without products
+ * - an event that hasn't been staged can't be taken out
+ */
+TEST_CASE("EventStream", "[SimCore][functionality]") {
+  const int n_events{40}, n_workers{4};
+
+  simcore::EventStream stream("test");
+  stream.setStager([](const G4Event* g4event, framework::Event& staged) {
+    staged.getEventHeader().setEventNumber(g4event->GetEventID());
+  });
+
+  // each worker stages every n_workers'th event from the back,
+  // so the events don't reach the stream in ID order
+  std::vector<std::thread> workers;
+  for (int i_worker{0}; i_worker < n_workers; i_worker++) {
+    workers.emplace_back([&, i_worker]() {
+      for (int id{n_events - 1 - i_worker}; id >= 0; id -= n_workers) {
+        G4Event g4event(id);
+        G4String seed{"seed" + std::to_string(id)};
+        g4event.SetRandomNumberStatus(seed);
+        if (id % 7 == 3) g4event.SetEventAborted();
+        stream.push(&g4event);
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
+
+  CHECK(stream.size() == n_events);
+
+  simcore::EventStream::Staged staged;
+  CHECK_FALSE(stream.pop(n_events, staged));
+  for (int id{0}; id < n_events; id++) {
+    REQUIRE(stream.pop(id, staged));
+    CHECK(staged.seed_ == "seed" + std::to_string(id));
+    if (id % 7 == 3) {
+      CHECK(staged.aborted_);
+      CHECK_FALSE(staged.event_);
+    } else {
+      CHECK_FALSE(staged.aborted_);
+      REQUIRE(staged.event_);
+      CHECK(staged.event_->getEventHeader().getEventNumber() == id);
+    }
+  }
+  CHECK(stream.size() == 0);
+  CHECK_FALSE(stream.pop(0, staged));
+}
@@ -0,0 +1,54 @@
+/**
+ * @file SimTrackerHitColumnsTest.cxx
+ * @brief Test the column view of a collection of SimTrackerHits
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "SimCore/Event/SimTrackerHit.h"
+
+/**
+ * Test for the SimTrackerHitColumns
+ *
+ * - the columns hold the members of the hits in the order of the hits
+ * - filling again replaces the hits without reallocating the columns
+ *   when there are no more hits than before
+ */
+TEST_CASE("SimTrackerHitColumns", "[SimCore][functionality]") {
+  std::vector<ldmx::SimTrackerHit> hits(3);
+  for (int i{0}; i < 3; i++) {
+    hits[i].setID(100 + i);
+    hits[i].setTrackID(i + 1);
+    hits[i].setPdgID(i % 2 ? 22 : 11);
+    hits[i].setPosition(i, 2. * i, 3. * i);
+    hits[i].setMomentum(-i, -2. * i, 10. * i);
+    hits[i].setEdep(0.5 * i);
+    hits[i].setTime(4. * i);
+  }
+
+  ldmx::SimTrackerHitColumns columns;
+  CHECK(columns.size() == 0);
+  columns.fill(hits);
+  REQUIRE(columns.size() == 3);
+  for (std::size_t i{0}; i < 3; i++) {
+    CHECK(columns.id()[i] == hits[i].getID());
+    CHECK(columns.trackID()[i] == hits[i].getTrackID());
+    CHECK(columns.pdgID()[i] == hits[i].getPdgID());
+    CHECK(columns.x()[i] == hits[i].getX());
+    CHECK(columns.y()[i] == hits[i].getY());
+    CHECK(columns.z()[i] == hits[i].getZ());
+    CHECK(columns.px()[i] == hits[i].getPx());
+    CHECK(columns.py()[i] == hits[i].getPy());
+    CHECK(columns.pz()[i] == hits[i].getPz());
+    CHECK(columns.edep()[i] == hits[i].getEdep());
+    CHECK(columns.time()[i] == hits[i].getTime());
+  }
+
+  const float *pz{columns.pz().data()};
+  hits.erase(hits.begin());
+  columns.fill(hits);
+  REQUIRE(columns.size() == 2);
+  CHECK(columns.pz().data() == pz);
+  CHECK(columns.trackID()[0] == 2);
+  CHECK(columns.pz()[1] == 20.f);
+}
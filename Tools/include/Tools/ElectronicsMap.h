@@ -9,7 +9,7 @@
 #ifndef TOOLS_ELECTRONICSMAP_H_
 #define TOOLS_ELECTRONICSMAP_H_
 
-#include <map>
+#include <cstdint>
 #include <sstream>
 #include <vector>
 
@@ -21,25 +21,36 @@ namespace ldmx {
  * A class for efficient mapping between electronics IDs (using packed index
  * techniques) and detector IDs which are arbitrarily formatted.
  *
+ * Both directions are constant time. The electronics IDs index a flat
+ * array of detector IDs and the detector IDs are looked up in a flat
+ * open-addressing hash table holding the electronics index of each one.
+ * The map is built once when the conditions are loaded, the raw encoders and
+ * decoders then look up every channel of every event in it.
+ *
  * @tparam[in] ElectronicsID class of electronics ID
  * @tparam[in] DetID class of detector IDs
  */
 template <class ElectronicsID, class DetID>
 class ElectronicsMap {
  public:
-  ElectronicsMap(bool want_d2e = false)
-      : eid2did_{ElectronicsID::MAX_INDEX, 0}, makeD2E_(want_d2e) {}
+  ElectronicsMap()
+      : eid2did_(ElectronicsID::MAX_INDEX, 0), did2eid_(MIN_SLOTS) {}
 
   /**
    * Remove all entries from the map
    */
   void clear() {
-    eid2did_ = std::vector<DetectorID::RawValue>(ElectronicsID::MAX_INDEX, 0);
-    did2eid_.clear();
+    eid2did_.assign(ElectronicsID::MAX_INDEX, 0);
+    did2eid_.assign(MIN_SLOTS, Slot());
+    shift_ = 64 - MIN_SLOTS_BITS;
+    n_did_ = 0;
   }
 
   /**
    * Add an entry to the map
+   *
+   * If the detector ID is already in the map, the reverse
+   * mapping keeps the electronics ID it was added with first.
    */
   void addEntry(ElectronicsID eid, DetID did) {
     unsigned int index = eid.index();
@@ -50,7 +61,7 @@ class ElectronicsMap {
                           " which is larger than allowed in this map");
     }
     eid2did_[index] = did.raw();
-    if (makeD2E_) did2eid_.insert(std::make_pair(did.raw(), eid));
+    insert(did.raw(), index);
   }
 
   /**
@@ -62,19 +73,8 @@ class ElectronicsMap {
 
   /**
    * Tests if a given detector id is in the map
-   * This method is slow O(N) if the map is not configured for detector id to
-   * electronics id.
    */
-  bool exists(DetID did) const {
-    if (makeD2E_) {
-      return did2eid_.find(did.raw()) == did2eid_.end();
-    } else {
-      for (auto i : eid2did_) {
-        if (i == did.raw()) return true;
-      }
-      return false;
-    }
-  }
+  bool exists(DetID did) const { return find(did.raw()).did_ != 0; }
 
   /**
    * Get the detector ID for this electronics ID
@@ -88,43 +88,88 @@ class ElectronicsMap {
 
   /**
    * Get the electronics ID for this detector ID
-   * This method is slow O(N) if the map is not configured for detector id to
-   * electronics id. Throws an exception on failure as there is no
+   * Throws an exception on failure as there is no
    * globally-defined invalid electronics
    */
   ElectronicsID get(DetID did) const {
-    if (makeD2E_) {
-      auto itr = did2eid_.find(did.raw());
-      if (itr == did2eid_.end()) {
-        std::stringstream ss;
-        ss << "Unable to find mapping for det id " << did;
-        EXCEPTION_RAISE("ElectronicsMapNotFound", ss.str());
-      }
-      return itr->second;
-    } else {
-      for (unsigned int i = 0; i < eid2did_.size(); i++) {
-        if (eid2did_[i] == did.raw()) return ElectronicsID::idFromIndex(i);
-      }
+    const Slot& slot{find(did.raw())};
+    if (slot.did_ == 0) {
       std::stringstream ss;
       ss << "Unable to find mapping for det id " << did;
       EXCEPTION_RAISE("ElectronicsMapNotFound", ss.str());
     }
+    return ElectronicsID::idFromIndex(slot.index_);
   }
 
  private:
+  /// one position in the detector ID hash table
+  struct Slot {
+    /// raw detector ID stored here, zero if the slot is empty
+    DetectorID::RawValue did_{0};
+    /// electronics index of the detector ID
+    unsigned int index_{0};
+  };
+
+  /// number of bits in the index of the smallest table
+  static const int MIN_SLOTS_BITS{4};
+  /// number of slots in the smallest table
+  static const std::size_t MIN_SLOTS{std::size_t(1) << MIN_SLOTS_BITS};
+
   /**
-   * Linear-time map for electronics (packed index) to raw detector id
+   * Position of the slot holding a raw detector ID or of the empty
+   * slot where it goes
+   *
+   * The slot is found by linear probing from a Fibonacci hash of the
+   * raw ID, which spreads the fields of the detector IDs over the table.
    */
-  std::vector<DetectorID::RawValue> eid2did_;
+  std::size_t position(DetectorID::RawValue did) const {
+    std::size_t mask{did2eid_.size() - 1};
+    std::size_t i = (did * 0x9E3779B97F4A7C15ULL) >> shift_;
+    while (did2eid_[i].did_ != 0 and did2eid_[i].did_ != did)
+      i = (i + 1) & mask;
+    return i;
+  }
+
+  /// slot holding a raw detector ID, empty if it isn't in the map
+  const Slot& find(DetectorID::RawValue did) const {
+    return did2eid_[position(did)];
+  }
+
+  /// insert a raw detector ID if it isn't there, keeping the table half empty
+  void insert(DetectorID::RawValue did, unsigned int index) {
+    if (did == 0) return;
+    if (2 * (n_did_ + 1) > did2eid_.size()) {
+      std::vector<Slot> old(2 * did2eid_.size());
+      old.swap(did2eid_);
+      shift_--;
+      for (const Slot& slot : old) {
+        if (slot.did_ != 0) did2eid_[position(slot.did_)] = slot;
+      }
+    }
+    Slot& slot{did2eid_[position(did)]};
+    if (slot.did_ == 0) {
+      slot.did_ = did;
+      slot.index_ = index;
+      n_did_++;
+    }
+  }
+
   /**
-   * Flag to determine if did2eid should be filled (resource optimization)
+   * Linear-time map for electronics (packed index) to raw detector id
    */
-  bool makeD2E_;
+  std::vector<DetectorID::RawValue> eid2did_;
 
   /**
-   * Log(N) map for raw detector id to electronics id
+   * Hash table from raw detector id to electronics (packed index),
+   * the number of slots is always a power of two
    */
-  std::map<DetectorID::RawValue, ElectronicsID> did2eid_;
+  std::vector<Slot> did2eid_;
+
+  /// shift of the 64-bit hash leaving the bits indexing the table
+  int shift_{64 - MIN_SLOTS_BITS};
+
+  /// number of detector IDs in the hash table
+  std::size_t n_did_{0};
 };
 
 }  // namespace ldmx
@@ -2,6 +2,10 @@
 #ifndef TOOLS_HGCROCEMULATOR_H
 #define TOOLS_HGCROCEMULATOR_H
 
+#include <cmath>
+#include <memory>
+#include <vector>
+
 #include "Conditions/SimpleTableCondition.h"
 #include "Framework/Configure/Parameters.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
@@ -11,7 +15,6 @@
 //----------//
 //   ROOT   //
 //----------//
-#include "TF1.h"
 #include "TRandom3.h"
 
 namespace ldmx {
@@ -153,6 +156,28 @@ class HgcrocEmulator {
       std::vector<std::pair<double, double>>& arriving_pulses,
       std::vector<ldmx::HgcrocDigiCollection::Sample>& digiToAdd) const;
 
+  /**
+   * Digitize the signals from the simulated hits of several channels
+   *
+   * The channels are emulated one after the other in the input order
+   * with the same procedure as the single channel digitize, so the
+   * random numbers used for noise are drawn in the same order as if
+   * digitize was called for each channel. The composite pulse and
+   * the buffers used to sample it are shared by all channels so no
+   * memory is allocated per channel once they have grown large enough.
+   *
+   * @param[in] channels pairs of (raw channel ID, pulses arriving at the
+   * chip), the pulses are sorted by amplitude in place
+   * @param[out] digis pairs of (raw channel ID, digi samples) for the
+   * channels that are read out, in the order they were input
+   */
+  void digitize(
+      std::vector<std::pair<int, std::vector<std::pair<double, double>>>>&
+          channels,
+      std::vector<
+          std::pair<int, std::vector<ldmx::HgcrocDigiCollection::Sample>>>&
+          digis) const;
+
   /**
    * Generate a digi of pure noise
    *
@@ -226,12 +251,97 @@ class HgcrocEmulator {
   }
 
  private:
+  /**
+   * PulseShape
+   *
+   * The shape of a single pulse with unit amplitude peaking at zero.
+   *
+   * The shape is tabulated on a uniform grid in time together with its
+   * derivative so it can be evaluated with a cubic Hermite interpolation
+   * between the two neighbouring grid points. This avoids computing
+   * two exponentials each time the pulse is sampled. Outside of the
+   * tabulated window the closed form is evaluated instead.
+   */
+  class PulseShape {
+   public:
+    /// Empty table, everything is evaluated with the closed form
+    PulseShape() = default;
+
+    /**
+     * Tabulate the pulse shape
+     *
+     * @param[in] rateUp rate of up slope [1/ns]
+     * @param[in] timeUp time of up slope relative to shape fit [ns]
+     * @param[in] rateDn rate of down slope [1/ns]
+     * @param[in] timeDn time of down slope relative to shape fit [ns]
+     * @param[in] timePeak time of peak relative to shape fit [ns]
+     * @param[in] begin start of the tabulated window [ns]
+     * @param[in] end end of the tabulated window [ns]
+     * @param[in] step spacing of the grid [ns], nothing is tabulated if
+     * it is not positive
+     */
+    PulseShape(double rateUp, double timeUp, double rateDn, double timeDn,
+               double timePeak, double begin, double end, double step);
+
+    /**
+     * Evaluate the closed form of the pulse shape
+     *
+     * @param[in] time time relative to the peak [ns]
+     * @return height of the pulse relative to its peak
+     */
+    double exact(double time) const {
+      return norm_ / ((1.0 + std::exp(rateUp_ * (time - offsetUp_))) *
+                      (1.0 + std::exp(rateDn_ * (time - offsetDn_))));
+    }
+
+    /**
+     * Evaluate the pulse shape
+     *
+     * @param[in] time time relative to the peak [ns]
+     * @return height of the pulse relative to its peak
+     */
+    double operator()(double time) const {
+      double u = (time - begin_) * invStep_;
+      // negated comparison so that NaN goes to the closed form as well
+      if (!(u >= 0.) || u >= numSteps_) return exact(time);
+      int i = static_cast<int>(u);
+      double s = u - i, r = 1. - s;
+      return r * r * ((1. + 2. * s) * value_[i] + s * slope_[i]) +
+             s * s * ((3. - 2. * s) * value_[i + 1] - r * slope_[i + 1]);
+    }
+
+   private:
+    /// rate of up slope [1/ns]
+    double rateUp_{0.};
+    /// time at which the up slope is half way [ns]
+    double offsetUp_{0.};
+    /// rate of down slope [1/ns]
+    double rateDn_{0.};
+    /// time at which the down slope is half way [ns]
+    double offsetDn_{0.};
+    /// normalization so that the shape is one at zero
+    double norm_{1.};
+    /// start of the tabulated window [ns]
+    double begin_{0.};
+    /// inverse of the grid spacing [1/ns]
+    double invStep_{0.};
+    /// number of grid intervals
+    double numSteps_{0.};
+    /// pulse shape at the grid points
+    std::vector<double> value_;
+    /// derivative of the pulse shape at the grid points times the spacing
+    std::vector<double> slope_;
+  };  // PulseShape
+
   /**
    * CompositePulse
    *
    * An emulator for a pulse that the chip needs to read.
    * This handles merging two hits that are "close-enough"
    * to one another.
+   *
+   * The amplitudes and times of the hits are kept in separate
+   * contiguous arrays so that summing the pulses is a tight loop.
    */
   class CompositePulse {
    public:
@@ -239,11 +349,11 @@ class HgcrocEmulator {
      * Constructore
      *
      * Connect this pulse emulator with the pulse
-     * shape function already configured by the chip
+     * shape already configured by the chip
      * emulator.
      */
-    CompositePulse(TF1& func, const double& g, const double& p)
-        : pulseFunc_{func}, gain_{g}, pedestal_{p} {}
+    CompositePulse(const PulseShape& shape, const double& g, const double& p)
+        : shape_{shape}, gain_{g}, pedestal_{p} {}
 
     /**
      * Put another hit into this composite pulse.
@@ -256,16 +366,17 @@ class HgcrocEmulator {
      * @param[in] hit_merge_ns maximum time separation [ns] to merge two hits
      */
     void addOrMerge(const std::pair<double, double>& hit, double hit_merge_ns) {
-      auto imerge{hits_.begin()};
-      for (; imerge != hits_.end(); imerge++)
-        if (fabs(imerge->second - hit.second) < hit_merge_ns) break;
-      if (imerge == hits_.end()) {  // didn't find a match, add to the list
-        hits_.push_back(hit);
+      std::size_t imerge{0};
+      for (; imerge < times_.size(); imerge++)
+        if (fabs(times_[imerge] - hit.second) < hit_merge_ns) break;
+      if (imerge == times_.size()) {  // didn't find a match, add to the list
+        amplitudes_.push_back(hit.first);
+        times_.push_back(hit.second);
       } else {  // merge hits, shifting time to average
-        imerge->second =
-            (imerge->second * imerge->first + hit.first * hit.second);
-        imerge->first += hit.first;
-        imerge->second /= imerge->first;
+        times_[imerge] =
+            (times_[imerge] * amplitudes_[imerge] + hit.first * hit.second);
+        amplitudes_[imerge] += hit.first;
+        times_[imerge] /= amplitudes_[imerge];
       }
     }
 
@@ -299,10 +410,16 @@ class HgcrocEmulator {
       return pt;
     }
 
-    /// Configure the pulses for the current chip
+    /**
+     * Configure the pulses for the current chip
+     *
+     * This also removes the hits of the previous chip.
+     */
     void setGainPedestal(double gain, double pedestal) {
       gain_ = gain;
       pedestal_ = pedestal;
+      amplitudes_.clear();
+      times_.clear();
     }
 
     /**
@@ -324,24 +441,46 @@ class HgcrocEmulator {
      */
     double at(double time) const {
       double signal = gain_ * pedestal_;
-      for (auto hit : hits_)
-        signal += hit.first * pulseFunc_.Eval(time - hit.second);
+      for (std::size_t i{0}; i < times_.size(); i++)
+        signal += amplitudes_[i] * shape_(time - times_[i]);
       return signal;
     };
 
-    /// Get list of individual pulses that are entering the chip
-    const std::vector<std::pair<double, double>>& hits() const { return hits_; }
-
-   private:
     /**
-     * pulses entering the chip
+     * Measure the voltage at several times at once
      *
-     * The pair is {voltage amplitude [mV], time of peak [ns]}
+     * Each voltage is the same as the one at would return,
+     * the pulses are added in the same order. The loop over the
+     * times is the inner one so it runs over contiguous memory.
+     *
+     * @param[in] times times to measure [ns]
+     * @param[out] volts voltages at those times [mV]
      */
-    std::vector<std::pair<double, double>> hits_;
+    void at(const std::vector<double>& times,
+            std::vector<double>& volts) const {
+      volts.assign(times.size(), gain_ * pedestal_);
+      for (std::size_t i{0}; i < times_.size(); i++) {
+        const double amplitude{amplitudes_[i]}, offset{times_[i]};
+        for (std::size_t j{0}; j < times.size(); j++)
+          volts[j] += amplitude * shape_(times[j] - offset);
+      }
+    }
+
+    /// Number of pulses entering the chip after merging
+    std::size_t size() const { return times_.size(); }
+
+    /// Time of peak of the input pulse [ns]
+    double time(std::size_t i) const { return times_[i]; }
+
+   private:
+    /// voltage amplitudes of the pulses entering the chip [mV]
+    std::vector<double> amplitudes_;
 
-    /// reference to pulse shape function shared by all pulses
-    TF1& pulseFunc_;
+    /// times of peak of the pulses entering the chip [ns]
+    std::vector<double> times_;
+
+    /// reference to pulse shape shared by all pulses
+    const PulseShape& shape_;
 
     /// gain for current chip we are emulating
     double gain_;
@@ -351,6 +490,28 @@ class HgcrocEmulator {
 
   };  // CompositePulse
 
+  /**
+   * Digitize the pulses arriving at one channel
+   *
+   * @see digitize for the emulation procedure
+   *
+   * @param[in] channelID raw integer ID for this readout channel
+   * @param[in] arriving_pulses pairs of (voltage,time) of hits arriving at the
+   * chip
+   * @param[in,out] pulse composite pulse to fill, its hits are replaced
+   * @param[in,out] times buffer for the times at which the pulse is sampled
+   * @param[in,out] volts buffer for the voltages of the sampled pulse
+   * @param[out] digiToAdd digi that will be filled with the samples from the
+   * chip
+   * @return true if digis were constructed (false if hit was below readout)
+   */
+  bool digitize(const int& channelID,
+                std::vector<std::pair<double, double>>& arriving_pulses,
+                CompositePulse& pulse, std::vector<double>& times,
+                std::vector<double>& volts,
+                std::vector<ldmx::HgcrocDigiCollection::Sample>& digiToAdd)
+      const;
+
  private:
   /**************************************************************************************
    * Parameters Identical for all Chips
@@ -420,9 +581,9 @@ class HgcrocEmulator {
   std::unique_ptr<TRandom3> noiseInjector_;
 
   /**
-   * Functional shape of signal pulse in time
+   * Shape of signal pulse in time
    *
-   * Shape parameters are hardcoded into the function currently.
+   * The shape is tabulated on construction from the parameters below.
    *  Pulse Shape:
    *  [0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))
    *   p[0] = amplitude (height of peak in mV)
@@ -438,8 +599,11 @@ class HgcrocEmulator {
    *  p_0\frac{(1+\exp(p_1(-p_2+p_3)))(1+\exp(p_5*(-p_6+p_3)))}
    *          {(1+\exp(p_1(t-p_2+p_3-p_4)))(1+\exp(p_5*(t-p_6+p_3-p_4)))}
    * @f]
+   *
+   * p[0] = 1 since the amplitude is set by each hit and p[4] = 0
+   * since the time of each hit is subtracted before evaluating.
    */
-  mutable TF1 pulseFunc_;
+  PulseShape pulseShape_;
 
 };  // HgcrocEmulator
 
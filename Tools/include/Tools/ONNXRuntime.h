@@ -4,6 +4,7 @@
 
 #include <map>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,21 @@ typedef std::vector<std::vector<float>> FloatArrays;
 /**
  * @class ONNXRuntime
  * @brief A convenience wrapper of the ONNXRuntime C++ API.
+ *
+ * There are two ways to run the model. The first, run with the input
+ * arrays, creates the tensors and copies the outputs on every call.
+ *
+ * The second binds the input and output nodes once to buffers held
+ * by this wrapper, sized for a maximum batch size. The caller fills
+ * the inputs in place, runs, and reads the outputs in place, so
+ * nothing is allocated or copied per call.
+ * ```cpp
+ * rt.bind({"input"}, {"probabilities"});
+ * std::span<float> features{rt.getInput(0)};
+ * // fill features
+ * rt.run();
+ * float pred = rt.getOutput(0)[1];
+ * ```
  */
 class ONNXRuntime {
  public:
@@ -24,9 +40,12 @@ class ONNXRuntime {
    * @param model_path Path to the ONNX model file.
    * @param session_options Configuration options of the ONNXRuntime Session.
    * Leave empty to use the default.
+   * @param intra_op_threads Number of threads used within the operators
+   * when the default session options are used.
    */
   ONNXRuntime(const std::string& model_path,
-              const ::Ort::SessionOptions* session_options = nullptr);
+              const ::Ort::SessionOptions* session_options = nullptr,
+              int intra_op_threads = 1);
   ONNXRuntime(const ONNXRuntime&) = delete;
   ONNXRuntime& operator=(const ONNXRuntime&) = delete;
   ~ONNXRuntime();
@@ -49,6 +68,50 @@ class ONNXRuntime {
                   const std::vector<std::string>& output_names = {},
                   int64_t batch_size = 1) const;
 
+  /**
+   * Bind input and output nodes to buffers held by us.
+   *
+   * All of the inputs of the model must be bound. All dimensions of the
+   * bound nodes except the batch dimension must be fixed by the model.
+   *
+   * @param input_names Names of the input nodes, in the order used by
+   * getInput.
+   * @param output_names Names of the output nodes, in the order used by
+   * getOutput.
+   * @param max_batch_size Largest number of samples run at once.
+   */
+  void bind(const std::vector<std::string>& input_names,
+            const std::vector<std::string>& output_names,
+            int64_t max_batch_size = 1);
+
+  /**
+   * Run model inference on the bound buffers.
+   *
+   * The tensors over the buffers are only made again when the batch
+   * size changes.
+   *
+   * @param batch_size Number of samples in the batch, the first
+   * batch_size samples of the inputs are used.
+   */
+  void run(int64_t batch_size = 1);
+
+  /**
+   * Get the buffer of one sample of a bound input node to fill.
+   * @param i_input Index of the input node in the names given to bind.
+   * @param i_batch Index of the sample in the batch.
+   * @return View of the values of the sample.
+   */
+  std::span<float> getInput(std::size_t i_input, int64_t i_batch = 0);
+
+  /**
+   * Get the buffer of one sample of a bound output node after run.
+   * @param i_output Index of the output node in the names given to bind.
+   * @param i_batch Index of the sample in the batch.
+   * @return View of the values of the sample.
+   */
+  std::span<const float> getOutput(std::size_t i_output,
+                                   int64_t i_batch = 0) const;
+
   /**
    * Get the names of all the output nodes.
    * @return A list of names of all the output nodes.
@@ -75,6 +138,33 @@ class ONNXRuntime {
   std::vector<std::string> output_node_strings_;
   std::vector<const char*> output_node_names_;
   std::map<std::string, std::vector<int64_t>> output_node_dims_;
+
+  /// a node bound to a buffer held by us
+  struct BoundNode {
+    /// shape of the node with the current batch size
+    std::vector<int64_t> dims_;
+    /// number of values in one sample
+    int64_t sample_size_;
+    /// values of the node for the maximum batch size
+    std::vector<float> buffer_;
+  };
+
+  /// make a bound node for a node of the model
+  BoundNode makeBoundNode(const std::string& name,
+                          const std::vector<int64_t>& dims,
+                          int64_t max_batch_size) const;
+
+  /// largest batch size the buffers can hold, zero if nothing is bound
+  int64_t max_batch_size_{0};
+  /// batch size the tensors have been made for
+  int64_t bound_batch_size_{0};
+  std::vector<const char*> bound_input_names_;
+  std::vector<BoundNode> bound_inputs_;
+  std::vector<::Ort::Value> bound_input_tensors_;
+  std::vector<std::string> bound_output_strings_;
+  std::vector<const char*> bound_output_names_;
+  std::vector<BoundNode> bound_outputs_;
+  std::vector<::Ort::Value> bound_output_tensors_;
 };
 
 }  // namespace ldmx::Ort
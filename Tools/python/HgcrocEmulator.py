@@ -49,3 +49,8 @@ class HgcrocEmulator() :
         #   NOT DOCUMENTED - only meant for testing purposes
         self.noise = True
 
+        # spacing of the table of the pulse shape [ns],
+        #   zero to always evaluate the pulse shape directly
+        #   NOT DOCUMENTED - only meant for testing purposes
+        self.pulseTableStep = 0.05
+
@@ -16,6 +16,7 @@
 //   ldmx   //
 //----------//
 #include "Framework/Exception/Exception.h"
+#include "Framework/TruthIndex.h"
 #include "SimCore/Event/SimParticle.h"
 
 //----------//
@@ -27,18 +28,7 @@ namespace Analysis {
 
 std::tuple<int, const ldmx::SimParticle *> getRecoil(
     const std::map<int, ldmx::SimParticle> &particleMap) {
-  // The recoil electron is "produced" in the dark brem geneartion
-  for (const auto &[trackID, particle] : particleMap) {
-    if (particle.getPdgID() == 11 and
-        particle.getProcessType() ==
-            ldmx::SimParticle::ProcessType::eDarkBrem) {
-      return {trackID, &particle};
-    }
-  }
-  // only get here if recoil electron was not "produced" by dark brem
-  //   in this case (bkgd), we interpret the primary electron as also the recoil
-  //   electron
-  return {1, &(particleMap.at(1))};
+  return framework::TruthIndex::findRecoil(particleMap);
 }
 
 // Search the recoil electrons daughters for a photon
@@ -49,9 +39,9 @@ bool doesParticleHavePNDaughters(
     const ldmx::SimParticle &gamma,
     const std::map<int, ldmx::SimParticle> &particleMap) {
   for (auto daughterID : gamma.getDaughters()) {
-    if (particleMap.find(daughterID) != std::end(particleMap)) {
-      const auto daughter{particleMap.at(daughterID)};
-      const auto processType{daughter.getProcessType()};
+    auto it{particleMap.find(daughterID)};
+    if (it != std::end(particleMap)) {
+      const auto processType{it->second.getProcessType()};
       if (processType == ldmx::SimParticle::ProcessType::photonNuclear) {
         return true;
       }  // Was it PN?
@@ -64,18 +54,18 @@ bool doesParticleHavePNDaughters(
 const ldmx::SimParticle *getPNGamma(
     const std::map<int, ldmx::SimParticle> &particleMap,
     const ldmx::SimParticle *recoil, const float &energyThreshold) {
-  auto recoilDaughters{recoil->getDaughters()};
-  for (auto recoilDaughterID : recoilDaughters) {
+  for (auto recoilDaughterID : recoil->getDaughters()) {
     // Have we stored the recoil daughter?
-    if (particleMap.find(recoilDaughterID) != std::end(particleMap)) {
-      auto recoilDaughter{particleMap.at(recoilDaughterID)};
+    auto it{particleMap.find(recoilDaughterID)};
+    if (it != std::end(particleMap)) {
+      const auto &recoilDaughter{it->second};
       // Is it a gamma?
       if (recoilDaughter.getPdgID() == 22) {
         // Does it have enough energy?
         if (recoilDaughter.getEnergy() >= energyThreshold) {
           // Are its daughters PN products?
           if (doesParticleHavePNDaughters(recoilDaughter, particleMap)) {
-            return &particleMap.at(recoilDaughterID);
+            return &recoilDaughter;
           }
         }
       }
@@ -23,19 +23,45 @@ HgcrocEmulator::HgcrocEmulator(const framework::config::Parameters &ps) {
 
   hit_merge_ns_ = 0.05;  // combine at 50 ps level
 
-  // Configure the pulse shape function
-  pulseFunc_ =
-      TF1("pulseFunc",
-          "[0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/"
-          "((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))",
-          0.0, (double)nADCs_ * clockCycle_);
-  pulseFunc_.FixParameter(0, 1.0);  // amplitude is set externally
-  pulseFunc_.FixParameter(1, rateUpSlope_);
-  pulseFunc_.FixParameter(2, timeUpSlope_);
-  pulseFunc_.FixParameter(3, timePeak_);
-  pulseFunc_.FixParameter(4, 0);  // not using time offset in this way
-  pulseFunc_.FixParameter(5, rateDnSlope_);
-  pulseFunc_.FixParameter(6, timeDnSlope_);
+  // Tabulate the pulse shape
+  //  the window covers the time differences between the hits and the
+  //  samples of a digi, the closed form is used outside of it
+  //  a non-positive step turns off the table (only meant for testing)
+  double tableStep = ps.getParameter<double>("pulseTableStep", 0.05);
+  pulseShape_ = PulseShape(rateUpSlope_, timeUpSlope_, rateDnSlope_,
+                           timeDnSlope_, timePeak_, -nADCs_ * clockCycle_,
+                           nADCs_ * clockCycle_, tableStep);
+}
+
+HgcrocEmulator::PulseShape::PulseShape(double rateUp, double timeUp,
+                                       double rateDn, double timeDn,
+                                       double timePeak, double begin,
+                                       double end, double step)
+    : rateUp_{rateUp},
+      offsetUp_{timeUp - timePeak},
+      rateDn_{rateDn},
+      offsetDn_{timeDn - timePeak},
+      norm_{(1.0 + std::exp(rateUp * (-timeUp + timePeak))) *
+            (1.0 + std::exp(rateDn * (-timeDn + timePeak)))},
+      begin_{begin} {
+  if (step <= 0.) return;
+  int n = static_cast<int>(std::ceil((end - begin) / step));
+  if (n < 1) return;
+  invStep_ = 1. / step;
+  numSteps_ = n;
+  value_.reserve(n + 1);
+  slope_.reserve(n + 1);
+  for (int i{0}; i <= n; i++) {
+    double t = begin + i * step;
+    double eUp = std::exp(rateUp_ * (t - offsetUp_)),
+           eDn = std::exp(rateDn_ * (t - offsetDn_));
+    double v = norm_ / ((1.0 + eUp) * (1.0 + eDn));
+    value_.push_back(v);
+    // d/dt of norm/((1+eUp)(1+eDn)), scaled to the grid spacing
+    slope_.push_back(-v * step *
+                     (rateUp_ * eUp / (1.0 + eUp) +
+                      rateDn_ * eDn / (1.0 + eDn)));
+  }
 }
 
 void HgcrocEmulator::seedGenerator(uint64_t seed) {
@@ -46,6 +72,32 @@ bool HgcrocEmulator::digitize(
     const int &channelID,
     std::vector<std::pair<double, double>> &arriving_pulses,
     std::vector<ldmx::HgcrocDigiCollection::Sample> &digiToAdd) const {
+  CompositePulse pulse(pulseShape_, 0., 0.);
+  std::vector<double> times, volts;
+  return digitize(channelID, arriving_pulses, pulse, times, volts, digiToAdd);
+}
+
+void HgcrocEmulator::digitize(
+    std::vector<std::pair<int, std::vector<std::pair<double, double>>>>
+        &channels,
+    std::vector<std::pair<int, std::vector<ldmx::HgcrocDigiCollection::Sample>>>
+        &digis) const {
+  digis.clear();
+  CompositePulse pulse(pulseShape_, 0., 0.);
+  std::vector<double> times, volts;
+  std::vector<ldmx::HgcrocDigiCollection::Sample> digiToAdd;
+  for (auto &[channelID, arriving_pulses] : channels) {
+    if (digitize(channelID, arriving_pulses, pulse, times, volts, digiToAdd))
+      digis.emplace_back(channelID, digiToAdd);
+  }
+}
+
+bool HgcrocEmulator::digitize(
+    const int &channelID,
+    std::vector<std::pair<double, double>> &arriving_pulses,
+    CompositePulse &pulse, std::vector<double> &times,
+    std::vector<double> &volts,
+    std::vector<ldmx::HgcrocDigiCollection::Sample> &digiToAdd) const {
   // step 0: prepare ourselves for emulation
 
   digiToAdd.clear();  // make sure it is clean
@@ -64,6 +116,8 @@ bool HgcrocEmulator::digitize(
   double drainRate = getCondition(channelID, "DRAIN_RATE");
   double readoutThresholdFloat = this->readoutThreshold(channelID);
   int readoutThreshold = int(readoutThresholdFloat);
+  // same width as noise(channelID) without looking it up for each sample
+  double noiseRMS = noise_ ? getCondition(channelID, "NOISE") * gain : 0.;
 
   // sort by amplitude
   //  ==> makes sure that puleses are merged towards higher ones
@@ -74,13 +128,27 @@ bool HgcrocEmulator::digitize(
 
   // step 1: gather voltages into groups separated by (programmable) ns, single
   // pass
-  CompositePulse pulse(pulseFunc_, gain, pedestal);
+  pulse.setGainPedestal(gain, pedestal);
 
   for (auto hit : arriving_pulses) pulse.addOrMerge(hit, hit_merge_ns_);
 
   // TODO step 2: add timing jitter
   // if (noise_) pulse.jitter();
 
+  // measure the pulse at the sampling time, start and end of each BX
+  //  all at once so the loop over the pulses is done only once
+  times.resize(3 * nADCs_);
+  for (int iADC = 0; iADC < nADCs_; iADC++) {
+    double startBX = (iADC - iSOI_) * clockCycle_ - measTime;
+    times[iADC] = (iADC - iSOI_) * clockCycle_;
+    times[nADCs_ + iADC] = startBX;
+    times[2 * nADCs_ + iADC] = startBX + clockCycle_;
+  }
+  pulse.at(times, volts);
+  const double *voltsAtSample = volts.data(),
+               *voltsAtStartBX = volts.data() + nADCs_,
+               *voltsAtEndBX = volts.data() + 2 * nADCs_;
+
   /// the time here is nominal (zero gives peak if hit.second is zero)
 
   // step 3: go through each BX sample one by one
@@ -94,29 +162,30 @@ bool HgcrocEmulator::digitize(
     bool overTOA = false;
     double toverTOA = -1;
     double toverTOT = -1;
-    for (auto hit : pulse.hits()) {
-      int hitBX = int((hit.second + measTime) / clockCycle_ + iSOI_);
+    for (std::size_t iHit{0}; iHit < pulse.size(); iHit++) {
+      double hitTime = pulse.time(iHit);
+      int hitBX = int((hitTime + measTime) / clockCycle_ + iSOI_);
       if (hitBX != iADC)
         continue;  // if this hit wasn't in the current BX, continue...
 
-      double vpeak = pulse(hit.second);
+      double vpeak = pulse(hitTime);
 
       if (vpeak > totThreshold) {
         startTOT = true;
-        if (toverTOT < hit.second)
-          toverTOT = hit.second;  // use the latest time in the window
+        if (toverTOT < hitTime)
+          toverTOT = hitTime;  // use the latest time in the window
       }
 
       if (vpeak > toaThreshold) {
-        if (!overTOA || hit.second < toverTOA) toverTOA = hit.second;
+        if (!overTOA || hitTime < toverTOA) toverTOA = hitTime;
         overTOA = true;
       }
 
     }  // loop over sim hits
 
     // check for the case of a TOA even though the peak is in the next BX
-    if (!overTOA && pulse(startBX + clockCycle_) > toaThreshold) {
-      if (pulse(startBX) < toaThreshold) {
+    if (!overTOA && voltsAtEndBX[iADC] > toaThreshold) {
+      if (voltsAtStartBX[iADC] < toaThreshold) {
         // pulse crossed TOA threshold somewhere between the start of this
         // basket and the end
         overTOA = true;
@@ -182,9 +251,9 @@ bool HgcrocEmulator::digitize(
       return true;  // always readout
     } else {
       // determine the voltage at the sampling time
-      double bxvolts = pulse((iADC - iSOI_) * clockCycle_);
+      double bxvolts = voltsAtSample[iADC];
       // add noise if requested
-      if (noise_) bxvolts += noise(channelID);
+      if (noise_) bxvolts += noiseInjector_->Gaus(0, noiseRMS);
       // convert to integer and keep in range (handle low and high saturation)
       int adc = bxvolts / gain;
       if (adc < 0) adc = 0;
@@ -192,7 +261,7 @@ bool HgcrocEmulator::digitize(
 
       // check for TOA
       int toa(0);
-      if (pulse(startBX) < toaThreshold && overTOA) {
+      if (voltsAtStartBX[iADC] < toaThreshold && overTOA) {
         double timecross = pulse.findCrossing(startBX, toverTOA, toaThreshold);
         toa = int((timecross - startBX) * ns_);
         // keep inside valid limits
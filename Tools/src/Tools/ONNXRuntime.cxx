@@ -44,13 +44,14 @@ std::string get_output_name(std::unique_ptr<Session>& s, size_t i,
 Env ONNXRuntime::env_(ORT_LOGGING_LEVEL_WARNING, "");
 
 ONNXRuntime::ONNXRuntime(const std::string& model_path,
-                         const SessionOptions* session_options) {
+                         const SessionOptions* session_options,
+                         int intra_op_threads) {
   // create session
   if (session_options) {
     session_.reset(new Session(env_, model_path.c_str(), *session_options));
   } else {
     SessionOptions sess_opts;
-    sess_opts.SetIntraOpNumThreads(1);
+    sess_opts.SetIntraOpNumThreads(intra_op_threads);
     session_.reset(new Session(env_, model_path.c_str(), sess_opts));
   }
   AllocatorWithDefaultOptions allocator;
@@ -174,6 +175,115 @@ FloatArrays ONNXRuntime::run(const std::vector<std::string>& input_names,
   return outputs;
 }
 
+ONNXRuntime::BoundNode ONNXRuntime::makeBoundNode(
+    const std::string& name, const std::vector<int64_t>& dims,
+    int64_t max_batch_size) const {
+  BoundNode node;
+  node.dims_ = dims;
+  node.sample_size_ = 1;
+  for (std::size_t i = 1; i < dims.size(); i++) {
+    if (dims[i] < 0) {
+      throw std::runtime_error("Node " + name +
+                               " has a dynamic dimension other than the "
+                               "batch and can't be bound!");
+    }
+    node.sample_size_ *= dims[i];
+  }
+  node.buffer_.resize(max_batch_size * node.sample_size_, 0);
+  return node;
+}
+
+void ONNXRuntime::bind(const std::vector<std::string>& input_names,
+                       const std::vector<std::string>& output_names,
+                       int64_t max_batch_size) {
+  if (max_batch_size < 1) {
+    throw std::runtime_error("Maximum batch size must be positive!");
+  }
+  for (const auto& name : input_node_strings_) {
+    if (std::find(input_names.begin(), input_names.end(), name) ==
+        input_names.end()) {
+      throw std::runtime_error("Input " + name + " is not provided!");
+    }
+  }
+
+  bound_input_names_.clear();
+  bound_inputs_.clear();
+  for (const auto& name : input_names) {
+    auto iter = input_node_dims_.find(name);
+    if (iter == input_node_dims_.end()) {
+      throw std::runtime_error("Input name " + name + " is invalid!");
+    }
+    // point to our copy of the name, it lives as long as the session
+    auto i_node = std::find(input_node_strings_.begin(),
+                            input_node_strings_.end(), name) -
+                  input_node_strings_.begin();
+    bound_input_names_.push_back(input_node_names_[i_node]);
+    bound_inputs_.push_back(makeBoundNode(name, iter->second, max_batch_size));
+  }
+
+  bound_output_strings_ = output_names;
+  bound_output_names_.clear();
+  bound_outputs_.clear();
+  for (const auto& name : bound_output_strings_) {
+    bound_output_names_.push_back(name.c_str());
+    bound_outputs_.push_back(
+        makeBoundNode(name, getOutputShape(name), max_batch_size));
+  }
+
+  max_batch_size_ = max_batch_size;
+  bound_batch_size_ = 0;
+}
+
+void ONNXRuntime::run(int64_t batch_size) {
+  if (max_batch_size_ == 0) {
+    throw std::runtime_error("No nodes are bound to run on!");
+  }
+  if (batch_size < 1 or batch_size > max_batch_size_) {
+    throw std::runtime_error("Batch size " + std::to_string(batch_size) +
+                             " is outside of the bound range 1 to " +
+                             std::to_string(max_batch_size_));
+  }
+
+  // the tensors only look at our buffers, so they are made again
+  // only when their shape changes
+  if (batch_size != bound_batch_size_) {
+    auto memory_info =
+        MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    auto make_tensors = [&](std::vector<BoundNode>& nodes,
+                            std::vector<Value>& tensors) {
+      tensors.clear();
+      for (auto& node : nodes) {
+        node.dims_[0] = batch_size;
+        tensors.push_back(Value::CreateTensor<float>(
+            memory_info, node.buffer_.data(), batch_size * node.sample_size_,
+            node.dims_.data(), node.dims_.size()));
+      }
+    };
+    make_tensors(bound_inputs_, bound_input_tensors_);
+    make_tensors(bound_outputs_, bound_output_tensors_);
+    bound_batch_size_ = batch_size;
+  }
+
+  // outputs are written directly into our buffers
+  session_->Run(RunOptions{nullptr}, bound_input_names_.data(),
+                bound_input_tensors_.data(), bound_input_tensors_.size(),
+                bound_output_names_.data(), bound_output_tensors_.data(),
+                bound_output_tensors_.size());
+}
+
+std::span<float> ONNXRuntime::getInput(std::size_t i_input, int64_t i_batch) {
+  auto& node = bound_inputs_.at(i_input);
+  return std::span<float>(node.buffer_)
+      .subspan(i_batch * node.sample_size_, node.sample_size_);
+}
+
+std::span<const float> ONNXRuntime::getOutput(std::size_t i_output,
+                                              int64_t i_batch) const {
+  const auto& node = bound_outputs_.at(i_output);
+  return std::span<const float>(node.buffer_)
+      .subspan(i_batch * node.sample_size_, node.sample_size_);
+}
+
 const std::vector<std::string>& ONNXRuntime::getOutputNames() const {
   if (session_) {
     return output_node_strings_;
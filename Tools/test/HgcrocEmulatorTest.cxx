@@ -0,0 +1,92 @@
+/**
+ * @file HgcrocEmulatorTest.cxx
+ * @brief Test the digitization of the HGCROC emulator
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+#include "Tools/HgcrocEmulator.h"
+
+namespace tools {
+namespace test {
+
+/// configuration of the emulator like the Ecal digi producer
+static framework::config::Parameters emulatorParameters(double table_step) {
+  framework::config::Parameters parameters;
+  parameters.addParameter("clockCycle", 25.);
+  parameters.addParameter("timingJitter", 0.25);
+  parameters.addParameter("nADCs", 10);
+  parameters.addParameter("iSOI", 2);
+  parameters.addParameter("rateUpSlope", -0.345);
+  parameters.addParameter("timeUpSlope", 70.6547);
+  parameters.addParameter("rateDnSlope", 0.140068);
+  parameters.addParameter("timeDnSlope", 87.7649);
+  parameters.addParameter("timePeak", 77.732);
+  parameters.addParameter("noise", true);
+  parameters.addParameter("pulseTableStep", table_step);
+  return parameters;
+}
+
+}  // namespace test
+}  // namespace tools
+
+/**
+ * Does the tabulated pulse shape digitized in batches give the same
+ * digis as evaluating the pulse shape directly one channel at a time?
+ *
+ * The channels get one to four hits each with amplitudes spanning the
+ * ADC and TOT ranges and times spread around the sample of interest,
+ * so the TOA and TOT measurements are covered as well.
+ */
+TEST_CASE("HgcrocEmulator Tabulated Pulse", "[Tools][functionality]") {
+  using Digi = std::vector<ldmx::HgcrocDigiCollection::Sample>;
+  using Pulses = std::vector<std::pair<double, double>>;
+
+  // chip conditions like the hard-coded Ecal ones, same for all channels
+  double gain{320. / 20. / 1024};
+  conditions::DoubleTableCondition chip(
+      "HgcrocConditions", {"PEDESTAL", "MEAS_TIME", "PAD_CAPACITANCE",
+                           "TOT_MAX", "DRAIN_RATE", "GAIN",
+                           "READOUT_THRESHOLD", "TOA_THRESHOLD",
+                           "TOT_THRESHOLD", "NOISE"});
+  chip.setIdMask(0);
+  chip.add(0, {50., 12.5, 20., 200., 10240. / 200., gain, 53.,
+               50. * gain + 5 * 37 * 0.162 / 20.,
+               50. * gain + 50 * 37 * 0.162 / 20., 1.5});
+
+  ldmx::HgcrocEmulator tabulated(tools::test::emulatorParameters(0.05)),
+      direct(tools::test::emulatorParameters(0.));
+  tabulated.condition(chip);
+  direct.condition(chip);
+  tabulated.seedGenerator(1);
+  direct.seedGenerator(1);
+
+  std::mt19937 gen{5};
+  std::exponential_distribution<double> amplitude(1. / 5.);
+  std::normal_distribution<double> time(0., 10.);
+  std::vector<std::pair<int, Pulses>> channels;
+  for (int id{0}; id < 2000; id++) {
+    Pulses pulses;
+    for (int n{1 + static_cast<int>(gen() % 4)}; n > 0; n--)
+      pulses.emplace_back(amplitude(gen), time(gen));
+    channels.emplace_back(id, pulses);
+  }
+
+  std::vector<std::pair<int, Digi>> expected;
+  for (auto [id, pulses] : channels) {
+    Digi digi;
+    if (direct.digitize(id, pulses, digi)) expected.emplace_back(id, digi);
+  }
+
+  std::vector<std::pair<int, Digi>> digis;
+  tabulated.digitize(channels, digis);
+
+  REQUIRE(digis.size() == expected.size());
+  CHECK(digis.size() > 100);
+  for (std::size_t i{0}; i < digis.size(); i++) {
+    CHECK(digis[i].first == expected[i].first);
+    REQUIRE(digis[i].second.size() == expected[i].second.size());
+    for (std::size_t s{0}; s < digis[i].second.size(); s++)
+      CHECK(digis[i].second[s].raw() == expected[i].second[s].raw());
+  }
+}
@@ -12,6 +12,7 @@
 #include "Acts/Utilities/Grid.hpp"
 #include "Acts/Utilities/Interpolation.hpp"
 #include "Acts/Utilities/Result.hpp"
+#include "DetDescr/FieldMapFile.h"
 
 static const double DIPOLE_OFFSET = 400.;  // 400 mm
 
@@ -269,6 +270,58 @@ inline InterpolatedMagneticField3 makeMagneticFieldMapXyzFromText(
                              lengthUnit, BFieldUnit, firstOctant);
 }
 
+/**
+ * Build the field map from a binary field map file
+ *
+ * This is equivalent to rotateFieldMapXYZ (without the first octant
+ * symmetry) but the grid is taken from the header of the file and the
+ * values are copied directly into the ACTS grid, so nothing has to be
+ * parsed or sorted.
+ *
+ * @see ldmx::FieldMapFile for the format and convert-field-map
+ * for how to make a binary field map
+ */
+inline InterpolatedMagneticField3 makeMagneticFieldMapXyzFromBinary(
+    const ldmx::FieldMapFile& map, GenericTransformPos transformPosition,
+    GenericTransformBField transformMagneticField) {
+  const auto& header{map.header()};
+  double lengthUnit{header.length_unit_ * Acts::UnitConstants::mm};
+  double BFieldUnit{header.field_unit_ * Acts::UnitConstants::T};
+
+  // the bin value corresponds to the left boundary, so we add one more
+  // step to the last grid point to get the upper edge of the axis
+  auto makeAxis = [&](int i) {
+    double step = map.n(i) > 1 ? std::fabs(header.max_[i] - header.min_[i]) /
+                                     (map.n(i) - 1)
+                               : 1.;
+    return Acts::Axis<Acts::AxisType::Equidistant>(
+        header.min_[i] * lengthUnit, (header.max_[i] + step) * lengthUnit,
+        map.n(i));
+  };
+
+  using Grid_t =
+      Acts::Grid<Acts::Vector3, Acts::Axis<Acts::AxisType::Equidistant>,
+                 Acts::Axis<Acts::AxisType::Equidistant>,
+                 Acts::Axis<Acts::AxisType::Equidistant>>;
+  Grid_t grid(std::make_tuple(makeAxis(0), makeAxis(1), makeAxis(2)));
+
+  const double* values{map.values()};
+  for (size_t i = 1; i <= map.n(0); ++i) {
+    for (size_t j = 1; j <= map.n(1); ++j) {
+      for (size_t k = 1; k <= map.n(2); ++k) {
+        // local bins start at one because of the underflow bins
+        const double* b{values + map.index(i - 1, j - 1, k - 1)};
+        grid.atLocalBins({{i, j, k}}) =
+            Acts::Vector3(b[0], b[1], b[2]) * BFieldUnit;
+      }
+    }
+  }
+  grid.setExteriorBins(Acts::Vector3::Zero());
+
+  return Acts::InterpolatedBFieldMap<Grid_t>(
+      {transformPosition, transformMagneticField, std::move(grid)});
+}
+
 inline InterpolatedMagneticField3 loadDefaultBField(
     const std::string& fieldMapFile, GenericTransformPos transformPosition,
     GenericTransformBField transformMagneticField) {
@@ -276,6 +329,14 @@ inline InterpolatedMagneticField3 loadDefaultBField(
   // transformPosition, std::function<Acts::Vector3(const Acts::Vector3&,const
   // Acts::Vector3&)> transformMagneticField
 
+  // use a binary copy of the map if there is one, it carries its own units
+  std::string binary{ldmx::FieldMapFile::findBinary(fieldMapFile)};
+  if (not binary.empty()) {
+    return makeMagneticFieldMapXyzFromBinary(ldmx::FieldMapFile(binary),
+                                             transformPosition,
+                                             transformMagneticField);
+  }
+
   return makeMagneticFieldMapXyzFromText(
       std::move(localToGlobalBin_xyz), transformPosition,
       transformMagneticField, fieldMapFile,
@@ -212,13 +212,11 @@ void CKFProcessor::produce(framework::Event& event) {
 
   // check if SimParticleMap is available for truth matching
   std::shared_ptr<tracking::sim::TruthMatchingTool> truthMatchingTool = nullptr;
-  std::map<int, ldmx::SimParticle> particleMap;
 
   if (event.exists("SimParticles")) {
     ldmx_log(debug) << "Setting up track truth matching tool";
-    particleMap = event.getMap<int, ldmx::SimParticle>("SimParticles");
     truthMatchingTool = std::make_shared<tracking::sim::TruthMatchingTool>(
-        particleMap, measurements);
+        event.getMap<int, ldmx::SimParticle>("SimParticles"), measurements);
   }
 
   // The mapping between the geometry identifier
@@ -1,5 +1,6 @@
 #include "Tracking/Reco/TruthSeedProcessor.h"
 
+#include "Framework/TruthIndex.h"
 #include "Tracking/Sim/GeometryContainers.h"
 
 namespace tracking::reco {
@@ -528,10 +529,6 @@ void TruthSeedProcessor::produce(framework::Event& event) {
   const std::vector<ldmx::SimTrackerHit> scoring_hits{
       event.getCollection<ldmx::SimTrackerHit>(scoring_hits_coll_name_)};
 
-  // Retrieve the scoring plane hits at the ECAL
-  const std::vector<ldmx::SimTrackerHit> scoring_hits_ecal{
-      event.getCollection<ldmx::SimTrackerHit>("EcalScoringPlaneHits")};
-
   // Retrieve the sim hits in the tagger tracker
   const std::vector<ldmx::SimTrackerHit> tagger_sim_hits =
       event.getCollection<ldmx::SimTrackerHit>(tagger_sim_hits_coll_name_);
@@ -680,17 +677,11 @@ void TruthSeedProcessor::produce(framework::Event& event) {
     }
   }
 
-  // Recover the EcalScoring hits
-  std::vector<ldmx::SimTrackerHit> ecal_spHits =
-      event.getCollection<ldmx::SimTrackerHit>("EcalScoringPlaneHits");
-  // Select ECAL hits
-  std::vector<ldmx::SimTrackerHit> sel_ecal_spHits;
-
-  for (auto sp_hit : ecal_spHits) {
-    if (sp_hit.getMomentum()[2] > 0 && ((sp_hit.getID() & 0xfff) == 31)) {
-      sel_ecal_spHits.push_back(sp_hit);
-    }
-  }
+  // Recover the EcalScoring hits, indexed by track and plane
+  const std::vector<ldmx::SimTrackerHit>& ecal_spHits =
+      event.getCollection<ldmx::SimTrackerHit>(
+          framework::TruthIndex::ECAL_SP_HITS);
+  const auto& truth{event.getDerived<framework::TruthIndex>()};
 
   // Recoil target surface for truth and seed tracks is the target
 
@@ -703,9 +694,12 @@ void TruthSeedProcessor::produce(framework::Event& event) {
     ldmx::SimTrackerHit ecal_hit;
 
     bool foundEcalHit = false;
-    for (auto ecal_sp_hit : sel_ecal_spHits) {
-      if (ecal_sp_hit.getTrackID() == hit.getTrackID()) {
-        ecal_hit = ecal_sp_hit;
+    // first forward going hit of this particle on the ECAL face
+    for (int i_ecal_hit : truth.getScoringPlaneHits(
+             framework::TruthIndex::ECAL_SP_HITS, hit.getTrackID(),
+             framework::TruthIndex::ECAL_PLANE)) {
+      if (ecal_spHits[i_ecal_hit].getPz() > 0) {
+        ecal_hit = ecal_spHits[i_ecal_hit];
         foundEcalHit = true;
         break;
       }